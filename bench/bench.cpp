@@ -0,0 +1,331 @@
+// 解析与序列化的性能基准（Google Benchmark）
+// 每个语料都测试 parse、serialize、字段访问、深拷贝和 minify，报告吞吐量（bytes_per_second）和每个文档的堆分配次数（allocs/doc）
+// 语料默认按常见基准文件的结构生成；设置环境变量 TINYJSON_BENCH_DATA 为包含
+// twitter.json、canada.json、citm_catalog.json 的目录时改用真实文件
+#include "../include/TinyJson.h"
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <sstream>
+#include <string>
+
+static size_t g_allocations = 0;
+
+// 替换全局的分配函数以统计分配次数；所有形式都要替换，保证每个 new 都与对应的 delete 配对
+static void *counted_alloc(std::size_t size)
+{
+    ++g_allocations;
+    return std::malloc(size ? size : 1);
+}
+
+static void *checked_alloc(std::size_t size)
+{
+    if (void *p = counted_alloc(size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size) { return checked_alloc(size); }
+void *operator new[](std::size_t size) { return checked_alloc(size); }
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept { return counted_alloc(size); }
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept { return counted_alloc(size); }
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+void operator delete(void *p, const std::nothrow_t &) noexcept { std::free(p); }
+void operator delete[](void *p, const std::nothrow_t &) noexcept { std::free(p); }
+
+#if defined(__cpp_aligned_new)
+// 超过默认对齐的分配：大小向上取整为对齐的倍数，以满足 aligned_alloc 的要求
+static void *counted_alloc(std::size_t size, std::align_val_t align)
+{
+    ++g_allocations;
+    std::size_t n = static_cast<std::size_t>(align);
+    return std::aligned_alloc(n, (size + n - 1) / n * n);
+}
+
+static void *checked_alloc(std::size_t size, std::align_val_t align)
+{
+    if (void *p = counted_alloc(size, align))
+        return p;
+    throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, std::align_val_t align) { return checked_alloc(size, align); }
+void *operator new[](std::size_t size, std::align_val_t align) { return checked_alloc(size, align); }
+void *operator new(std::size_t size, std::align_val_t align, const std::nothrow_t &) noexcept { return counted_alloc(size, align); }
+void *operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t &) noexcept { return counted_alloc(size, align); }
+void operator delete(void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t, const std::nothrow_t &) noexcept { std::free(p); }
+void operator delete[](void *p, std::align_val_t, const std::nothrow_t &) noexcept { std::free(p); }
+#endif
+
+// 读取 TINYJSON_BENCH_DATA 目录下的文件，不存在时返回空字符串
+static std::string load_file(const char *name)
+{
+    const char *dir = std::getenv("TINYJSON_BENCH_DATA");
+    if (dir == nullptr)
+        return std::string();
+    std::ifstream in(std::string(dir) + "/" + name, std::ios::binary);
+    std::ostringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+// 类似 twitter.json：大量中等大小的对象，字符串为主，包含非 ASCII 文本和转义
+static std::string make_twitter()
+{
+    std::string s = "{\"statuses\":[";
+    for (int i = 0; i < 2000; i++)
+    {
+        if (i)
+            s += ",";
+        s += "{\"id\":" + std::to_string(505874924095815700LL + i) +
+             ",\"text\":\"@aym0566x \\u540d\\u524d:\\u524d\\u7530\\u3042\\u3086\\u307f 第一印象:なんか怖っ！ #" + std::to_string(i) +
+             "\",\"source\":\"<a href=\\\"http://twitter.com/download/iphone\\\" rel=\\\"nofollow\\\">Twitter for iPhone</a>\"" +
+             ",\"truncated\":false,\"in_reply_to_status_id\":null" +
+             ",\"user\":{\"id\":" + std::to_string(1186275104 + i) +
+             ",\"name\":\"AYUMI\",\"screen_name\":\"ayuu0123\",\"location\":\"\",\"description\":\"元野球部マネージャー❤︎…最高の夏をありがとう…❤︎\"" +
+             ",\"followers_count\":262,\"friends_count\":252,\"verified\":false,\"lang\":\"ja\"}" +
+             ",\"retweet_count\":" + std::to_string(i % 17) + ",\"favorite_count\":0" +
+             ",\"entities\":{\"hashtags\":[],\"urls\":[],\"user_mentions\":[{\"screen_name\":\"aym0566x\",\"id\":866260188,\"indices\":[0,9]}]}" +
+             ",\"favorited\":false,\"retweeted\":false,\"lang\":\"ja\"}";
+    }
+    s += "],\"search_metadata\":{\"completed_in\":0.087,\"max_id\":505874924095815700,\"count\":100}}";
+    return s;
+}
+
+// 类似 canada.json：深度不大的大数组，几乎全是浮点数坐标
+static std::string make_canada()
+{
+    std::string s = "{\"type\":\"FeatureCollection\",\"features\":[{\"type\":\"Feature\",\"properties\":{\"name\":\"Canada\"},"
+                    "\"geometry\":{\"type\":\"Polygon\",\"coordinates\":[";
+    unsigned seed = 12345;
+    for (int ring = 0; ring < 40; ring++)
+    {
+        s += ring ? ",[" : "[";
+        for (int i = 0; i < 5000; i++)
+        {
+            seed = seed * 1103515245 + 12345;
+            double x = -141.0 + (seed % 8800000) / 100000.0 + 0.123456789012;
+            seed = seed * 1103515245 + 12345;
+            double y = 41.0 + (seed % 4200000) / 100000.0 + 0.987654321098;
+            char buf[80];
+            std::snprintf(buf, sizeof(buf), "%s[%.15g,%.15g]", i ? "," : "", x, y);
+            s += buf;
+        }
+        s += "]";
+    }
+    s += "]}}]}";
+    return s;
+}
+
+// 类似 citm_catalog.json：以整数 ID 为键名的大对象，整数和短字符串为主
+static std::string make_citm()
+{
+    std::string s = "{\"areaNames\":{";
+    for (int i = 0; i < 500; i++)
+        s += (i ? ",\"" : "\"") + std::to_string(205705993 + i) + "\":\"Arrière-scène central " + std::to_string(i) + "\"";
+    s += "},\"events\":{";
+    for (int i = 0; i < 1000; i++)
+    {
+        std::string id = std::to_string(138586341 + i);
+        s += (i ? ",\"" : "\"") + id + "\":{\"description\":null,\"id\":" + id +
+             ",\"logo\":\"/images/UE0AAAAACEKo6QAAAAZDSVRN\",\"name\":\"30th Anniversary Tour\",\"subTopicIds\":[337184269,337184283]," +
+             "\"subjectCode\":null,\"subtitle\":null,\"topicIds\":[324846099,107888604]}";
+    }
+    s += "},\"performances\":[";
+    for (int i = 0; i < 2000; i++)
+    {
+        s += std::string(i ? "," : "") + "{\"eventId\":" + std::to_string(138586341 + i % 1000) + ",\"id\":" +
+             std::to_string(339887544 + i) + ",\"prices\":[{\"amount\":90250,\"audienceSubCategoryId\":337100890,\"seatCategoryId\":338937295}," +
+             "{\"amount\":66500,\"audienceSubCategoryId\":337100890,\"seatCategoryId\":338937296}],\"start\":1372701600000,\"venueCode\":\"PLEYEL_PLEYEL\"}";
+    }
+    s += "]}";
+    return s;
+}
+
+// 深度嵌套的数组
+static std::string make_nested()
+{
+    std::string s;
+    for (int round = 0; round < 100; round++)
+    {
+        s += round ? "," : "[";
+        s += std::string(500, '[') + "1" + std::string(500, ']');
+    }
+    return s + "]";
+}
+
+// 较长的 NDJSON 输入，每行一条记录
+static std::string make_ndjson()
+{
+    std::string s;
+    for (int i = 0; i < 20000; i++)
+    {
+        s += "{\"ts\":" + std::to_string(1700000000000LL + i) + ",\"level\":\"info\",\"user\":" + std::to_string(i % 977) +
+             ",\"latency_ms\":" + std::to_string(i % 250) + "." + std::to_string(i % 10) + ",\"path\":\"/api/v1/items/" +
+             std::to_string(i) + "\",\"ok\":true}\n";
+    }
+    return s;
+}
+
+// 长的非 ASCII 字符串，包含 \u 转义和代理对
+static std::string make_unicode()
+{
+    std::string s = "[";
+    for (int i = 0; i < 200; i++)
+    {
+        s += i ? ",\"" : "\"";
+        for (int j = 0; j < 100; j++)
+            s += "中文字符串テキスト Ελληνικά \\u00e9\\u4e2d\\ud83d\\ude00 ";
+        s += "\"";
+    }
+    return s + "]";
+}
+
+static const std::string &corpus(int id)
+{
+    static const std::string docs[] = {
+        [] { std::string s = load_file("twitter.json"); return s.empty() ? make_twitter() : s; }(),
+        [] { std::string s = load_file("canada.json"); return s.empty() ? make_canada() : s; }(),
+        [] { std::string s = load_file("citm_catalog.json"); return s.empty() ? make_citm() : s; }(),
+        make_nested(),
+        make_unicode(),
+    };
+    return docs[id];
+}
+
+static const char *const corpus_names[] = {"twitter", "canada", "citm_catalog", "nested_arrays", "unicode_strings"};
+
+// 把 state 的计时结果换算为吞吐量和每个文档的分配次数
+static void report(benchmark::State &state, size_t bytes, size_t allocations)
+{
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+    state.counters["allocs/doc"] = static_cast<double>(allocations) / static_cast<double>(state.iterations());
+}
+
+static void BM_Parse(benchmark::State &state)
+{
+    const std::string &doc = corpus(static_cast<int>(state.range(0)));
+    state.SetLabel(corpus_names[state.range(0)]);
+    size_t a0 = g_allocations;
+    for (auto _ : state)
+    {
+        TinyJson::json j = TinyJson::parser::parse(doc);
+        benchmark::DoNotOptimize(j);
+    }
+    report(state, doc.size(), g_allocations - a0);
+}
+
+static void BM_Serialize(benchmark::State &state)
+{
+    TinyJson::json j = TinyJson::parser::parse(corpus(static_cast<int>(state.range(0))));
+    state.SetLabel(corpus_names[state.range(0)]);
+    size_t bytes = 0;
+    size_t a0 = g_allocations;
+    for (auto _ : state)
+    {
+        std::string out;
+        j.dump(out);
+        bytes = out.size();
+        benchmark::DoNotOptimize(out);
+    }
+    report(state, bytes, g_allocations - a0);
+}
+
+// 遍历整棵树，每个成员都按键名查找一次，累加数值
+static double access_all(const TinyJson::json &j)
+{
+    double sum = 0;
+    if (j.type() == TinyJson::json_t::object)
+    {
+        for (const auto &member : j.get_object())
+        {
+            const TinyJson::json *v = j.find(TinyJson::string_view(member.first.data(), member.first.size()));
+            sum += access_all(*v);
+        }
+    }
+    else if (j.type() == TinyJson::json_t::array)
+    {
+        for (const auto &elem : j.get_array())
+            sum += access_all(elem);
+    }
+    else if (j.type() == TinyJson::json_t::number_integer)
+    {
+        sum += static_cast<double>(j.get_integer());
+    }
+    else if (j.type() == TinyJson::json_t::number_double)
+    {
+        sum += j.get_double();
+    }
+    return sum;
+}
+
+static void BM_FieldAccess(benchmark::State &state)
+{
+    const std::string &doc = corpus(static_cast<int>(state.range(0)));
+    TinyJson::json j = TinyJson::parser::parse(doc);
+    state.SetLabel(corpus_names[state.range(0)]);
+    size_t a0 = g_allocations;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(access_all(j));
+    report(state, doc.size(), g_allocations - a0);
+}
+
+static void BM_Copy(benchmark::State &state)
+{
+    const std::string &doc = corpus(static_cast<int>(state.range(0)));
+    TinyJson::json j = TinyJson::parser::parse(doc);
+    state.SetLabel(corpus_names[state.range(0)]);
+    size_t a0 = g_allocations;
+    for (auto _ : state)
+    {
+        TinyJson::json copy(j);
+        benchmark::DoNotOptimize(copy);
+    }
+    report(state, doc.size(), g_allocations - a0);
+}
+
+// 去除带缩进文本中的空白，输入由语料按 dump_options::pretty() 重新格式化得到
+static void BM_Minify(benchmark::State &state)
+{
+    const std::string doc = TinyJson::parser::parse(corpus(static_cast<int>(state.range(0)))).to_string(TinyJson::dump_options::pretty());
+    state.SetLabel(corpus_names[state.range(0)]);
+    size_t a0 = g_allocations;
+    for (auto _ : state)
+    {
+        std::string out = TinyJson::minify(doc);
+        benchmark::DoNotOptimize(out);
+    }
+    report(state, doc.size(), g_allocations - a0);
+}
+
+static void BM_NdjsonRead(benchmark::State &state)
+{
+    static const std::string doc = make_ndjson();
+    size_t a0 = g_allocations;
+    for (auto _ : state)
+    {
+        TinyJson::ndjson_reader reader(doc);
+        size_t records = 0;
+        while (reader.next())
+            records += reader.ok();
+        benchmark::DoNotOptimize(records);
+    }
+    report(state, doc.size(), g_allocations - a0);
+}
+
+BENCHMARK(BM_Parse)->DenseRange(0, 4);
+BENCHMARK(BM_Serialize)->DenseRange(0, 4);
+BENCHMARK(BM_FieldAccess)->DenseRange(0, 4);
+BENCHMARK(BM_Copy)->DenseRange(0, 4);
+BENCHMARK(BM_Minify)->DenseRange(0, 4);
+BENCHMARK(BM_NdjsonRead);
+
+BENCHMARK_MAIN();
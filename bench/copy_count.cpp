@@ -0,0 +1,132 @@
+// 统计在深度嵌套文档上解析与构建时发生的堆分配次数
+// 对象、数组和字符串的每一次深拷贝都会表现为额外的分配，
+// 因此分配次数可以直接反映解析过程中发生的拷贝
+#include "../include/TinyJson.h"
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+
+static size_t g_allocations = 0;
+static size_t g_bytes = 0;
+
+// 替换全局的分配函数以统计分配次数；所有形式都要替换，保证每个 new 都与对应的 delete 配对
+static void *counted_alloc(std::size_t size)
+{
+    ++g_allocations;
+    g_bytes += size;
+    return std::malloc(size ? size : 1);
+}
+
+static void *checked_alloc(std::size_t size)
+{
+    if (void *p = counted_alloc(size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size) { return checked_alloc(size); }
+void *operator new[](std::size_t size) { return checked_alloc(size); }
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept { return counted_alloc(size); }
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept { return counted_alloc(size); }
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+void operator delete(void *p, const std::nothrow_t &) noexcept { std::free(p); }
+void operator delete[](void *p, const std::nothrow_t &) noexcept { std::free(p); }
+
+#if defined(__cpp_aligned_new)
+// 超过默认对齐的分配：大小向上取整为对齐的倍数，以满足 aligned_alloc 的要求
+static void *counted_alloc(std::size_t size, std::align_val_t align)
+{
+    ++g_allocations;
+    g_bytes += size;
+    std::size_t n = static_cast<std::size_t>(align);
+    return std::aligned_alloc(n, (size + n - 1) / n * n);
+}
+
+static void *checked_alloc(std::size_t size, std::align_val_t align)
+{
+    if (void *p = counted_alloc(size, align))
+        return p;
+    throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, std::align_val_t align) { return checked_alloc(size, align); }
+void *operator new[](std::size_t size, std::align_val_t align) { return checked_alloc(size, align); }
+void *operator new(std::size_t size, std::align_val_t align, const std::nothrow_t &) noexcept { return counted_alloc(size, align); }
+void *operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t &) noexcept { return counted_alloc(size, align); }
+void operator delete(void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t, const std::nothrow_t &) noexcept { std::free(p); }
+void operator delete[](void *p, std::align_val_t, const std::nothrow_t &) noexcept { std::free(p); }
+#endif
+
+// 生成嵌套深度为 depth 的文档：{"level":0,"name":"n","children":[{...}]}
+static std::string make_nested(int depth)
+{
+    std::string s;
+    for (int i = 0; i < depth; i++)
+    {
+        s += "{\"level\":" + std::to_string(i) + ",\"name\":\"node\",\"children\":[";
+    }
+    for (int i = 0; i < depth; i++)
+    {
+        s += "]}";
+    }
+    return s;
+}
+
+// 手工构建同样结构的文档，测试 add_member/add_element 的拷贝次数
+static TinyJson::json build_nested(int depth)
+{
+    TinyJson::json node;
+    for (int i = depth - 1; i >= 0; i--)
+    {
+        TinyJson::json parent(TinyJson::json_object{});
+        parent.add_member("level", i);
+        parent.add_member("name", "node");
+        TinyJson::json children(TinyJson::json_array{});
+        if (i != depth - 1)
+        {
+            children.add_element(std::move(node));
+        }
+        parent.add_member("children", std::move(children));
+        node = std::move(parent);
+    }
+    return node;
+}
+
+int main(int argc, char **argv)
+{
+    int depth = argc > 1 ? std::atoi(argv[1]) : 100;
+    std::string doc = make_nested(depth);
+
+    size_t a0 = g_allocations, b0 = g_bytes;
+    TinyJson::json parsed = TinyJson::parser::parse(doc.c_str());
+    size_t parse_allocs = g_allocations - a0, parse_bytes = g_bytes - b0;
+
+    a0 = g_allocations;
+    TinyJson::json built = build_nested(depth);
+    size_t build_allocs = g_allocations - a0;
+
+    a0 = g_allocations;
+    TinyJson::json copied(parsed);
+    size_t copy_allocs = g_allocations - a0;
+
+    a0 = g_allocations, b0 = g_bytes;
+    std::string text = parsed.to_string();
+    size_t dump_allocs = g_allocations - a0, dump_bytes = g_bytes - b0;
+
+    std::cout << "depth                 : " << depth << "\n"
+              << "parse allocations     : " << parse_allocs << " (" << parse_bytes << " bytes)\n"
+              << "build allocations     : " << build_allocs << "\n"
+              << "one deep copy         : " << copy_allocs << " allocations\n"
+              << "parse / deep copy     : " << (double)parse_allocs / copy_allocs << "\n"
+              << "to_string allocations : " << dump_allocs << " (" << dump_bytes << " bytes for "
+              << text.size() << " bytes of output)\n";
+    return parsed == built ? 0 : 1;
+}
@@ -6,29 +6,308 @@
 #pragma once
 
 #include <istream>
+#include <iterator>
 #include <sstream>
 #include <string>
 #include <locale>
 #include <vector>
 #include <map>
+#include <list>
+#include <unordered_map>
+#include <memory>
+#include <cstdint>
+#include <utility>
+#include <tuple>
 #include <algorithm>
-#include <codecvt>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <clocale>
+#include <cfloat>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
+
+// 字节扫描的向量化实现：x86 上使用 SSE2（并在运行时检测 AVX2），ARM 上使用 NEON
+// 定义 TINYJSON_NO_SIMD 可以强制只使用逐字节的实现
+#if !defined(TINYJSON_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TINYJSON_SSE2 1
+#include <emmintrin.h>
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define TINYJSON_AVX2_DISPATCH 1
+#include <immintrin.h>
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define TINYJSON_NEON 1
+#include <arm_neon.h>
+#endif
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+// 文件解析在 POSIX 系统上使用 mmap，其他平台（或定义了 TINYJSON_NO_MMAP 时）改为一次性读入内存
+#if !defined(TINYJSON_NO_MMAP) && (defined(__unix__) || defined(__APPLE__))
+#define TINYJSON_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// 并行解析使用标准线程库；定义 TINYJSON_NO_THREADS 可以去掉这部分功能
+#if !defined(TINYJSON_NO_THREADS)
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#endif
+
+// 用 -fno-exceptions 编译或定义了 TINYJSON_NO_EXCEPTIONS 时不使用异常：原本抛出异常的错误改为调用 TINYJSON_THROW，
+// 默认输出错误信息后终止程序（可以在包含头文件之前自行定义 TINYJSON_THROW）；
+// 这种模式下应使用写入 parse_error 的解析接口以及 find、try_get_* 访问函数
+#if !defined(TINYJSON_NO_EXCEPTIONS) && !defined(__cpp_exceptions) && !defined(__EXCEPTIONS) && !defined(_CPPUNWIND)
+#define TINYJSON_NO_EXCEPTIONS 1
+#endif
+
+#if defined(TINYJSON_NO_EXCEPTIONS)
+#ifndef TINYJSON_THROW
+#define TINYJSON_THROW(ex) (std::fprintf(stderr, "TinyJson: %s\n", (ex).what()), std::abort())
+#endif
+#define TINYJSON_TRY if (true)
+#define TINYJSON_CATCH(ex) if (false)
+#define TINYJSON_RETHROW std::abort()
+#else
+#ifndef TINYJSON_THROW
+#if defined(TINYJSON_INSTRUMENT)
+#define TINYJSON_THROW(ex)                            \
+    do                                                \
+    {                                                 \
+        ::TinyJson::instrument::count_exception();    \
+        throw ex;                                     \
+    } while (0)
+#else
+#define TINYJSON_THROW(ex) throw ex
+#endif
+#endif
+#define TINYJSON_TRY try
+#define TINYJSON_CATCH(ex) catch (ex)
+#define TINYJSON_RETHROW throw
+#endif
+
+// 只在出错时执行的函数不内联，以免增大解析循环的代码
+#if defined(__GNUC__) || defined(__clang__)
+#define TINYJSON_COLD __attribute__((noinline, cold))
+#elif defined(_MSC_VER)
+#define TINYJSON_COLD __declspec(noinline)
+#else
+#define TINYJSON_COLD
+#endif
+
+// 解析时允许的最大嵌套深度（对象和数组的层数），超过时报告 parse_errc::depth_exceeded，
+// 避免恶意构造的深层嵌套耗尽递归解析的栈空间；可以在包含头文件之前自行定义
+#ifndef TINYJSON_MAX_DEPTH
+#define TINYJSON_MAX_DEPTH 1024
+#endif
+
+// 定义 TINYJSON_INSTRUMENT 时启用运行时统计和节点分配钩子（见 instrument 命名空间）；
+// 未定义时下面的统计点全部展开为空语句，不产生任何代码
+#if defined(TINYJSON_INSTRUMENT)
+#include <atomic>
+#include <chrono>
+#define TINYJSON_STAT_ADD(field, n) ::TinyJson::instrument::add(::TinyJson::instrument::counters().field, n)
+#define TINYJSON_STAT_MAX(field, v) ::TinyJson::instrument::update_max(::TinyJson::instrument::counters().field, v)
+#define TINYJSON_STAT_TIMER(field) ::TinyJson::instrument::scoped_timer tinyjson_stat_timer(::TinyJson::instrument::counters().field)
+#else
+#define TINYJSON_STAT_ADD(field, n) ((void)0)
+#define TINYJSON_STAT_MAX(field, v) ((void)0)
+#define TINYJSON_STAT_TIMER(field) ((void)0)
+#endif
 
 namespace TinyJson
 {
 
+#if defined(TINYJSON_INSTRUMENT)
+    // 运行时统计的快照，由 instrument::stats() 返回；计数从程序开始（或上一次 instrument::reset()）起累计，所有线程共享
+    struct json_stats
+    {
+        uint64_t bytes_parsed = 0;      ///< 解析器读入的字节数
+        uint64_t nodes_created = 0;     ///< 解析时构建的 JSON 值个数
+        uint64_t max_depth = 0;         ///< 解析过的文档的最大嵌套深度
+        uint64_t strings_allocated = 0; ///< 分配的字符串节点个数（借用的字符串不计）
+        uint64_t exceptions_thrown = 0; ///< 通过 TINYJSON_THROW 抛出的异常个数
+        uint64_t allocations = 0;       ///< 字符串、数组、对象节点的分配次数
+        uint64_t deallocations = 0;     ///< 节点的释放次数
+        uint64_t bytes_allocated = 0;   ///< 节点分配的总字节数（不含容器内部的缓冲区）
+        uint64_t parse_ns = 0;          ///< 解析耗费的时间（纳秒）
+        uint64_t serialize_ns = 0;      ///< 序列化为字符串或输出流耗费的时间（纳秒）
+    };
+
+    // 节点分配钩子：替换默认分配器的 basic_json（json、ordered_json 等）在构造和析构时对字符串、数组、对象节点的分配和释放
+    // 只覆盖节点本身（std::string、vector、map 等容器对象的那一块内存）：字符串的字符、数组和对象的元素缓冲区
+    // 以及 map 的树节点仍由容器的 std::allocator 经全局 operator new 分配，不经过钩子，也不计入 bytes_allocated
+    // 钩子存放在普通的全局变量中，读取时不加同步：必须在其他线程开始使用 JSON 值之前、在单线程中安装，
+    // 并且在创建第一个 JSON 值之前安装、之后不再更换，否则节点可能交给另一个钩子释放
+    struct allocation_hooks
+    {
+        void *(*allocate)(size_t size, void *context);           ///< 分配 size 字节，失败时抛出 std::bad_alloc
+        void (*deallocate)(void *p, size_t size, void *context); ///< 释放 allocate 返回的内存
+        void *context;                                           ///< 原样传给两个函数
+    };
+
+    namespace instrument
+    {
+        // 全局计数器
+        struct counter_set
+        {
+            std::atomic<uint64_t> bytes_parsed{0};
+            std::atomic<uint64_t> nodes_created{0};
+            std::atomic<uint64_t> max_depth{0};
+            std::atomic<uint64_t> strings_allocated{0};
+            std::atomic<uint64_t> exceptions_thrown{0};
+            std::atomic<uint64_t> allocations{0};
+            std::atomic<uint64_t> deallocations{0};
+            std::atomic<uint64_t> bytes_allocated{0};
+            std::atomic<uint64_t> parse_ns{0};
+            std::atomic<uint64_t> serialize_ns{0};
+        };
+
+        inline counter_set &counters()
+        {
+            static counter_set c;
+            return c;
+        }
+
+        inline void add(std::atomic<uint64_t> &counter, uint64_t n) { counter.fetch_add(n, std::memory_order_relaxed); }
+
+        inline void update_max(std::atomic<uint64_t> &counter, uint64_t v)
+        {
+            uint64_t cur = counter.load(std::memory_order_relaxed);
+            while (v > cur && !counter.compare_exchange_weak(cur, v, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        inline void count_exception() { add(counters().exceptions_thrown, 1); }
+
+        // 在作用域结束时把经过的时间累加到计数器上
+        class scoped_timer
+        {
+        public:
+            explicit scoped_timer(std::atomic<uint64_t> &counter) : _counter(counter), _start(std::chrono::steady_clock::now()) {}
+            ~scoped_timer()
+            {
+                auto elapsed = std::chrono::steady_clock::now() - _start;
+                add(_counter, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+            }
+            scoped_timer(const scoped_timer &) = delete;
+            scoped_timer &operator=(const scoped_timer &) = delete;
+
+        private:
+            std::atomic<uint64_t> &_counter;
+            std::chrono::steady_clock::time_point _start;
+        };
+
+        /// 读取所有计数器
+        inline json_stats stats()
+        {
+            counter_set &c = counters();
+            json_stats s;
+            s.bytes_parsed = c.bytes_parsed.load(std::memory_order_relaxed);
+            s.nodes_created = c.nodes_created.load(std::memory_order_relaxed);
+            s.max_depth = c.max_depth.load(std::memory_order_relaxed);
+            s.strings_allocated = c.strings_allocated.load(std::memory_order_relaxed);
+            s.exceptions_thrown = c.exceptions_thrown.load(std::memory_order_relaxed);
+            s.allocations = c.allocations.load(std::memory_order_relaxed);
+            s.deallocations = c.deallocations.load(std::memory_order_relaxed);
+            s.bytes_allocated = c.bytes_allocated.load(std::memory_order_relaxed);
+            s.parse_ns = c.parse_ns.load(std::memory_order_relaxed);
+            s.serialize_ns = c.serialize_ns.load(std::memory_order_relaxed);
+            return s;
+        }
+
+        /// 所有计数器清零
+        inline void reset()
+        {
+            counter_set &c = counters();
+            for (std::atomic<uint64_t> *p : {&c.bytes_parsed, &c.nodes_created, &c.max_depth, &c.strings_allocated, &c.exceptions_thrown,
+                                             &c.allocations, &c.deallocations, &c.bytes_allocated, &c.parse_ns, &c.serialize_ns})
+            {
+                p->store(0, std::memory_order_relaxed);
+            }
+        }
+
+        inline allocation_hooks &hooks()
+        {
+            static allocation_hooks h = {nullptr, nullptr, nullptr};
+            return h;
+        }
+
+        /// 安装节点分配钩子，传入成员都为空的 allocation_hooks 时恢复为全局的 operator new/delete
+        /// 不是线程安全的，只能在程序启动阶段、其他线程使用 JSON 值之前调用（见 allocation_hooks）
+        inline void set_allocation_hooks(const allocation_hooks &h) { hooks() = h; }
+
+        // 默认分配器的节点经过钩子分配，其他分配器只统计次数
+        template <class T>
+        inline T *allocate_node(std::allocator<T> &)
+        {
+            add(counters().allocations, 1);
+            add(counters().bytes_allocated, sizeof(T));
+            const allocation_hooks &h = hooks();
+            return static_cast<T *>(h.allocate != nullptr ? h.allocate(sizeof(T), h.context) : ::operator new(sizeof(T)));
+        }
+
+        template <class T>
+        inline void deallocate_node(std::allocator<T> &, T *p)
+        {
+            add(counters().deallocations, 1);
+            const allocation_hooks &h = hooks();
+            if (h.deallocate != nullptr)
+            {
+                h.deallocate(p, sizeof(T), h.context);
+            }
+            else
+            {
+                ::operator delete(p);
+            }
+        }
+
+        template <class Alloc>
+        inline typename std::allocator_traits<Alloc>::pointer allocate_node(Alloc &a)
+        {
+            add(counters().allocations, 1);
+            add(counters().bytes_allocated, sizeof(typename std::allocator_traits<Alloc>::value_type));
+            return std::allocator_traits<Alloc>::allocate(a, 1);
+        }
+
+        template <class Alloc>
+        inline void deallocate_node(Alloc &a, typename std::allocator_traits<Alloc>::pointer p)
+        {
+            add(counters().deallocations, 1);
+            std::allocator_traits<Alloc>::deallocate(a, p, 1);
+        }
+    }
+#endif
+
     using u32_istream = std::basic_istream<char32_t>;
     using u32_sstream = std::basic_stringstream<char32_t>;
 
 // 检查用于检查 JSON 对象的类型是否与预期匹配，如果不匹配则抛出异常
-#define CHECK_TYPE_MISMATCH(t1, t2)                                   \
-    {                                                                 \
-        if (t1 != t2)                                                 \
-        {                                                             \
-            std::ostringstream oss;                                   \
-            oss << "expect type " << t1 << ", but found type " << t2; \
-            throw std::runtime_error(oss.str());                      \
-        }                                                             \
+#define CHECK_TYPE_MISMATCH(t1, t2)                                                                    \
+    {                                                                                                  \
+        if (t1 != t2)                                                                                  \
+        {                                                                                              \
+            TINYJSON_THROW(std::runtime_error("expect type " + std::to_string(t1) + ", but found type " + \
+                                              std::to_string(t2)));                                    \
+        }                                                                                              \
     }
 
     // 去空白字符
@@ -45,1125 +324,10380 @@ namespace TinyJson
         return str.substr(strBegin, strRange);
     }
 
-    // UTF-32 编码的字符串转换为 UTF-8 编码的字符
-    inline std::string U32ToU8(std::u32string u32)
+    // 将一个 Unicode 码点按 UTF-8 编码追加到字符串末尾
+    template <class String>
+    inline void append_utf8(String &out, char32_t cp)
     {
-        try
+        if (cp < 0x80)
         {
-            // std::wstring_convert 用于在不同编码的字符串之间进行转换
-            std::wstring_convert<std::codecvt_utf8<char32_t>, char32_t> utf32conv;
-            return utf32conv.to_bytes(u32);
+            out.push_back(static_cast<char>(cp));
         }
-        catch (std::range_error &ex)
+        else if (cp < 0x800)
         {
-            // 否则
-            throw std::runtime_error("invalid utf32 string: " + std::string(ex.what()));
+            out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
         }
-    }
-
-    // UTF-8 编码的字符串转换为 UTF-32 编码的字符
-    inline std::u32string U8ToU32(std::string u8)
-    {
-        try
+        else if (cp < 0x10000)
         {
-            std::wstring_convert<std::codecvt_utf8<char32_t>, char32_t> utf32conv;
-            return utf32conv.from_bytes(u8);
+            out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
         }
-        catch (const std::exception &ex)
+        else
         {
-            // 否则
-            throw std::runtime_error("invalid utf32 string: " + std::string(ex.what()));
+            out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
         }
     }
 
-    // 枚举类型 json_t 表示 JSON 值的可能数据类型
-    enum json_t
-    {
-        string = 0,     // 表示一个 JSON 字符串
-        number_integer, // 表示一个 JSON 整数
-        number_double,  // 表示一个 JSON 浮点数
-        array,          // 表示一个 JSON 数组
-        boolean,        // 表示一个 JSON 布尔值（true 或 false）
-        object,         // 表示一个 JSON 对象
-        null,           // 表示 JSON 的 null 值
-        invalid         // 表示无效或未知的 JSON 类型
-    };
-
-    class json;
-
-    using json_object = std::map<std::string, json>;
-    using json_array = std::vector<json>;
-
-    // json 类表示一个 JSON 值
-    // 可以是字符串、数字、数组、布尔值、对象或 null
-    class json
+    // 校验从 p 开始的一个 UTF-8 多字节序列，返回其字节数，非法序列返回 0
+    // 拒绝过长编码、代理区码点以及超过 U+10FFFF 的码点
+    inline size_t utf8_sequence_length(const char *p, const char *end)
     {
-    private:
-        /// 指向 JSON 值实际数据的指针
-        void *_value;
-        /// JSON 值的类型
-        json_t _type;
-
-    public:
-        json();
-        json(std::string val); // 符串类型
-        json(std::string &val);
-        json(char val[]);
-        json(double val);         // 浮点数类型
-        json(int val);            // 整数类型
-        json(long long val);      // 长整型类型
-        json(bool val);           // 布尔类型
-        json(json_array &array);  // 数组类型
-        json(json_array &&array); // 数组类型（移动语义）
-        json(json_object &obj);   // 对象类型
-        json(json_object &&obj);  // 对象类型（移动语义）
-
-        ~json();
+        const unsigned char *s = reinterpret_cast<const unsigned char *>(p);
+        size_t avail = static_cast<size_t>(end - p);
 
-        /// 获取 JSON 值的类型
-        const json_t type() const;           // 返回 JSON 值的类型
-        const std::string type_name() const; // 返回 JSON 值类型的名称
+        if (avail == 0)
+            return 0;
+        if (s[0] < 0x80)
+            return 1;
 
-        json(const json &other);
-        json &operator=(const json &other);
+        if (s[0] >= 0xC2 && s[0] <= 0xDF)
+        {
+            return (avail >= 2 && (s[1] & 0xC0) == 0x80) ? 2 : 0;
+        }
 
-        bool operator==(const json &rhs) const;
-        bool operator!=(const json &rhs) const;
+        if (s[0] >= 0xE0 && s[0] <= 0xEF)
+        {
+            if (avail < 3 || (s[1] & 0xC0) != 0x80 || (s[2] & 0xC0) != 0x80)
+                return 0;
+            if (s[0] == 0xE0 && s[1] < 0xA0) // 过长编码
+                return 0;
+            if (s[0] == 0xED && s[1] >= 0xA0) // 代理区 U+D800..U+DFFF
+                return 0;
+            return 3;
+        }
 
-        const std::string get_string() const;
-        const long long get_integer() const;
-        const double get_double() const;
-        const bool get_bool() const;
-        const json_object get_object() const;
-        const json_array get_array() const;
-        const void *get_null() const;
+        if (s[0] >= 0xF0 && s[0] <= 0xF4)
+        {
+            if (avail < 4 || (s[1] & 0xC0) != 0x80 || (s[2] & 0xC0) != 0x80 || (s[3] & 0xC0) != 0x80)
+                return 0;
+            if (s[0] == 0xF0 && s[1] < 0x90) // 过长编码
+                return 0;
+            if (s[0] == 0xF4 && s[1] >= 0x90) // 超过 U+10FFFF
+                return 0;
+            return 4;
+        }
 
-        /// 获取 JSON 值的大小（数组或对象）
-        size_t size() const;
+        return 0;
+    }
 
-        /// 检查对象中是否存在指定的成员
-        bool has_member(std::string member_name);
+    // UTF-32 编码的字符串转换为 UTF-8 编码的字符
+    // 直接逐码点编码，拒绝代理区码点以及超过 U+10FFFF 的码点
+    inline std::string U32ToU8(const std::u32string &u32)
+    {
+        std::string u8;
+        u8.reserve(u32.size());
+        for (char32_t cp : u32)
+        {
+            if (cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF))
+            {
+                TINYJSON_THROW(std::runtime_error("invalid utf32 string: code point out of range"));
+            }
+            append_utf8(u8, cp);
+        }
+        return u8;
+    }
 
-        /// 添加成员或元素
-        void add_member(std::string member_name, json member_value);
-        void add_element(json elem); // 向数组添加一个元素
+    // UTF-8 编码的字符串转换为 UTF-32 编码的字符
+    // 每个序列先由 utf8_sequence_length 校验，再直接解码
+    inline std::u32string U8ToU32(const std::string &u8)
+    {
+        std::u32string u32;
+        u32.reserve(u8.size());
+        const char *p = u8.data();
+        const char *end = p + u8.size();
+        while (p < end)
+        {
+            const unsigned char *s = reinterpret_cast<const unsigned char *>(p);
+            size_t n = utf8_sequence_length(p, end);
+            char32_t cp;
+            switch (n)
+            {
+            case 1:
+                cp = s[0];
+                break;
+            case 2:
+                cp = (static_cast<char32_t>(s[0] & 0x1F) << 6) | (s[1] & 0x3F);
+                break;
+            case 3:
+                cp = (static_cast<char32_t>(s[0] & 0x0F) << 12) | (static_cast<char32_t>(s[1] & 0x3F) << 6) | (s[2] & 0x3F);
+                break;
+            case 4:
+                cp = (static_cast<char32_t>(s[0] & 0x07) << 18) | (static_cast<char32_t>(s[1] & 0x3F) << 12) |
+                     (static_cast<char32_t>(s[2] & 0x3F) << 6) | (s[3] & 0x3F);
+                break;
+            default:
+                TINYJSON_THROW(std::runtime_error("invalid utf32 string: invalid utf-8 sequence"));
+            }
+            u32.push_back(cp);
+            p += n;
+        }
+        return u32;
+    }
 
-        json &operator[](const char *key); // 访问对象的成员
-        json &operator[](int index);       // 访问数组的元素
+    // 十六进制字符转换为数值，非十六进制字符返回 -1
+    inline int hex_value(char32_t c)
+    {
+        if (c >= U'0' && c <= U'9')
+            return static_cast<int>(c - U'0');
+        if (c >= U'a' && c <= U'f')
+            return static_cast<int>(c - U'a' + 10);
+        if (c >= U'A' && c <= U'F')
+            return static_cast<int>(c - U'A' + 10);
+        return -1;
+    }
 
-        operator const std::string() const; // 将 JSON 值转换为字符串
-        operator const double() const;      // 将 JSON 值转换为双精度浮点数
-        operator const long long() const;   // 将 JSON 值转换为长整型
-        operator const bool() const;        // 将 JSON 值转换为布尔值
+    // 是否为空白字符，与 C 区域设置下的 std::isspace 一致（空格以及 \t \n \v \f \r）
+    inline bool is_space_byte(char c)
+    {
+        return c == ' ' || static_cast<unsigned char>(c - '\t') <= '\r' - '\t';
+    }
 
-        /// 序列化 JSON 值
-        const std::string to_string() const;
+    // 字符串扫描需要停下处理的字节：双引号、反斜杠、控制字符以及非 ASCII 字节（需要校验 UTF-8）
+    inline bool is_string_special_byte(char c)
+    {
+        unsigned char u = static_cast<unsigned char>(c);
+        return u == '"' || u == '\\' || u < 0x20 || u >= 0x80;
+    }
 
-    private:
-        /// 用于序列化对象和数组
-        const std::string object_to_string() const; // 序列化对象类型的 JSON 值
-        const std::string array_to_string() const;  // 序列化数组类型的 JSON 值
+    // 序列化字符串时每个字节的转义方式：0 表示原样输出，'u' 表示输出为 \u00XX，其余为反斜杠后的字符
+    // 非 ASCII 字节原样输出，输出仍是 UTF-8
+    static const char json_escape_table[256] = {
+        'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'b', 't', 'n', 'u', 'f', 'r', 'u', 'u', // 0x00
+        'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', // 0x10
+        0, 0, '"', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,                               // 0x20
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,                                 // 0x30
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,                                 // 0x40
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, '\\', 0, 0, 0,                              // 0x50
     };
 
-    //
-    // 具体实现
-    //
-
-    inline json::json() : _value(nullptr), _type(json_t::null) {}
-
-    // 字符串类型的 JSON 对象
-    inline json::json(std::string val)
-        : _value(new std::string(val)), _type(json_t::string) {}
-
-    // 字符串类型的 JSON 对象（引用）
-    inline json::json(std::string &val)
-        : _value(new std::string(val)), _type(json_t::string) {}
-
-    // 字符串类型的 JSON 对象（C 风格字符串）
-    inline json::json(char val[])
-        : _value(new std::string(val)), _type(json_t::string) {}
-
-    // 双精度浮点数类型的 JSON 对象
-    inline json::json(double val)
-        : _value(new double(val)), _type(json_t::number_double) {}
-
-    // 长整型类型的 JSON 对象
-    inline json::json(long long val)
-        : _value(new long long(val)), _type(json_t::number_integer) {}
-
-    // 整型类型的 JSON 对象
-    inline json::json(int val)
-        : _value(new long long(val)), _type(json_t::number_integer) {}
-
-    // 布尔类型的 JSON 对象
-    inline json::json(bool val)
-        : _value(new bool(val)), _type(json_t::boolean) {}
-
-    // 数组类型的 JSON 对象
-    inline json::json(json_array &array)
-        : _value(new json_array(array)), _type(json_t::array) {}
-
-    // 数组类型的 JSON 对象（移动语义）
-    inline json::json(json_array &&array)
-        : _value(new json_array(array)), _type(json_t::array) {}
-
-    // 对象类型的 JSON 对象
-    inline json::json(json_object &obj)
-        : _value(new json_object(obj)), _type(json_t::object) {}
-
-    // 对象类型的 JSON 对象（移动语义）
-    inline json::json(json_object &&obj)
-        : _value(new json_object(obj)), _type(json_t::object) {}
-
-    // 获取 JSON 对象的类型
-    inline const json_t json::type() const { return _type; }
-
-    // 获取数据类型
-    inline const std::string json::type_name() const
+    // 最低的非零位的位置，x 不能为 0
+    inline unsigned count_trailing_zeros(uint64_t x)
     {
-        switch (_type)
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_ctzll(x));
+#elif defined(_MSC_VER) && defined(_M_X64)
+        unsigned long index;
+        _BitScanForward64(&index, x);
+        return static_cast<unsigned>(index);
+#else
+        unsigned n = 0;
+        while ((x & 1) == 0)
         {
-        case (json_t::string):
-            return "string";
-
-        case (json_t::array):
-            return "array";
-
-        case (json_t::object):
-            return "object";
-
-        case (json_t::number_double):
-        case (json_t::number_integer):
-            return "number";
-
-        case (json_t::boolean):
-            return "boolean";
+            x >>= 1;
+            ++n;
+        }
+        return n;
+#endif
+    }
 
-        case (json_t::null):
-            return "null";
+    // 64 位乘法的完整 128 位结果
+    inline void multiply_64x64(uint64_t a, uint64_t b, uint64_t &hi, uint64_t &lo)
+    {
+#if defined(__SIZEOF_INT128__)
+        unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+        hi = static_cast<uint64_t>(r >> 64);
+        lo = static_cast<uint64_t>(r);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        lo = _umul128(a, b, &hi);
+#else
+        uint64_t a_lo = a & 0xFFFFFFFFu, a_hi = a >> 32;
+        uint64_t b_lo = b & 0xFFFFFFFFu, b_hi = b >> 32;
+        uint64_t p0 = a_lo * b_lo, p1 = a_lo * b_hi, p2 = a_hi * b_lo, p3 = a_hi * b_hi;
+        uint64_t mid = (p0 >> 32) + (p1 & 0xFFFFFFFFu) + (p2 & 0xFFFFFFFFu);
+        lo = (mid << 32) | (p0 & 0xFFFFFFFFu);
+        hi = p3 + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
+#endif
+    }
 
-        case (json_t::invalid):
-        default:
-            return "invalid";
+    // 最高的非零位之前的零的个数，x 不能为 0
+    inline int count_leading_zeros(uint64_t x)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_clzll(x);
+#else
+        int n = 0;
+        while ((x & 0x8000000000000000ULL) == 0)
+        {
+            x <<= 1;
+            ++n;
         }
+        return n;
+#endif
     }
 
-    // 拷贝构造函数
-    inline json::json(const json &other)
+    // 逐字节跳过空白字符，返回第一个非空白字符的位置（没有则返回 end）
+    inline const char *skip_whitespace_scalar(const char *p, const char *end)
     {
-        _type = other._type;
-        switch (_type)
+        while (p < end && is_space_byte(*p))
         {
-        case json_t::string:
-            _value = new std::string(*static_cast<std::string *>(other._value));
-            break;
-        case json_t::object:
-            _value = new json_object(*static_cast<json_object *>(other._value));
-            break;
-        case json_t::number_double:
-            _value = new double(*static_cast<double *>(other._value));
-            break;
-        case json_t::number_integer:
-            _value = new long long(*static_cast<long long *>(other._value));
-            break;
-        case json_t::array:
-            _value = new json_array(*static_cast<json_array *>(other._value));
-            break;
-        case json_t::boolean:
-            _value = new bool(*static_cast<bool *>(other._value));
-            break;
-        case json_t::null:
-            _value = nullptr;
-            break;
-        default:
-            throw std::runtime_error("unexpected json type: " + other.type_name());
+            ++p;
         }
+        return p;
     }
 
-    // 拷贝赋值运算符
-    inline json &json::operator=(const json &other)
+    // 逐字节查找字符串中下一个需要处理的字节（没有则返回 end）
+    inline const char *find_string_special_scalar(const char *p, const char *end)
     {
-        _type = other._type;
-        switch (_type)
+        while (p < end && !is_string_special_byte(*p))
         {
-        case json_t::string:
-            _value = new std::string(*static_cast<std::string *>(other._value));
-            break;
-        case json_t::object:
-            _value = new json_object(*static_cast<json_object *>(other._value));
-            break;
-        case json_t::number_double:
-            _value = new double(*static_cast<double *>(other._value));
-            break;
-        case json_t::number_integer:
-            _value = new long long(*static_cast<long long *>(other._value));
-            break;
-        case json_t::array:
-            _value = new json_array(*static_cast<json_array *>(other._value));
-            break;
-        case json_t::boolean:
-            _value = new bool(*static_cast<bool *>(other._value));
-            break;
-        case json_t::null:
-            _value = nullptr;
-            break;
-        default:
-            // 无法识别的数据类型
-            throw std::runtime_error("unexpected json type" + other.type_name());
+            ++p;
         }
-        return *this;
+        return p;
     }
 
-    // 比较当前 JSON 对象与另一个 JSON 对象是否相等
-    // 两个 JSON 对象相等当且仅当它们类型相同且值相等
-    inline bool json::operator==(const json &rhs) const
+    // 逐字节查找下一个需要转义的字节（没有则返回 end）
+    inline const char *find_escape_byte_scalar(const char *p, const char *end)
     {
-        // 如果类型不同，则不相等
-        if (_type != rhs._type)
+        while (p < end && json_escape_table[static_cast<unsigned char>(*p)] == 0)
         {
-            return false;
+            ++p;
         }
+        return p;
+    }
 
-        // 根据 JSON 对象的类型，比较具体的值
-        switch (_type)
+#if defined(TINYJSON_SSE2)
+    // 每次检查 16 个字节，剩余不足 16 字节的部分逐字节处理
+    inline const char *skip_whitespace_sse2(const char *p, const char *end)
+    {
+        const __m128i space = _mm_set1_epi8(' ');
+        const __m128i tab = _mm_set1_epi8('\t');
+        const __m128i range = _mm_set1_epi8('\r' - '\t');
+        for (; end - p >= 16; p += 16)
         {
-        case json_t::array:
-            // 如果都是数组类型，则比较数组中的每个元素
-            if (rhs._type == json_t::array)
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+            // x - '\t' 在无符号意义下不超过 4 即为 \t \n \v \f \r
+            __m128i t = _mm_sub_epi8(x, tab);
+            __m128i ws = _mm_or_si128(_mm_cmpeq_epi8(x, space), _mm_cmpeq_epi8(_mm_min_epu8(t, range), t));
+            unsigned mask = ~static_cast<unsigned>(_mm_movemask_epi8(ws)) & 0xFFFFu;
+            if (mask != 0)
             {
-                json_array *a = static_cast<json_array *>(_value);
-                json_array *b = static_cast<json_array *>(rhs._value);
-                return *a == *b;
+                return p + count_trailing_zeros(mask);
             }
-            break;
+        }
+        return skip_whitespace_scalar(p, end);
+    }
 
-        case json_t::object:
-            // 如果都是对象类型，则比较对象中的每个键值对
-            if (rhs._type == json_t::object)
+    inline const char *find_string_special_sse2(const char *p, const char *end)
+    {
+        const __m128i quote = _mm_set1_epi8('"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i control = _mm_set1_epi8(0x20);
+        for (; end - p >= 16; p += 16)
+        {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+            // 有符号比较 x < 0x20 同时覆盖了控制字符和 0x80 以上的字节
+            __m128i special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(x, quote), _mm_cmpeq_epi8(x, backslash)),
+                                           _mm_cmplt_epi8(x, control));
+            unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(special));
+            if (mask != 0)
             {
-                json_object *a = static_cast<json_object *>(_value);
-                json_object *b = static_cast<json_object *>(rhs._value);
-                return *a == *b;
+                return p + count_trailing_zeros(mask);
             }
-            break;
+        }
+        return find_string_special_scalar(p, end);
+    }
 
-        case json_t::null:
-            // 如果都是 null 类型，则它们相等
-            if (rhs._type == json_t::null)
+    inline const char *find_escape_byte_sse2(const char *p, const char *end)
+    {
+        const __m128i quote = _mm_set1_epi8('"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i control = _mm_set1_epi8(0x1F);
+        for (; end - p >= 16; p += 16)
+        {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+            // 无符号比较 x <= 0x1F：只有控制字符需要转义，0x80 以上的字节原样输出
+            __m128i special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(x, quote), _mm_cmpeq_epi8(x, backslash)),
+                                           _mm_cmpeq_epi8(_mm_min_epu8(x, control), x));
+            unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(special));
+            if (mask != 0)
             {
-                return true;
+                return p + count_trailing_zeros(mask);
             }
-            break;
+        }
+        return find_escape_byte_scalar(p, end);
+    }
+#endif
 
-        case json_t::string:
-            // 如果都是字符串类型，则比较字符串内容
-            if (rhs._type == json_t::string)
+#if defined(TINYJSON_AVX2_DISPATCH)
+    // 每次检查 32 个字节，只在运行时检测到 CPU 支持 AVX2 时调用
+    __attribute__((target("avx2"))) inline const char *skip_whitespace_avx2(const char *p, const char *end)
+    {
+        const __m256i space = _mm256_set1_epi8(' ');
+        const __m256i tab = _mm256_set1_epi8('\t');
+        const __m256i range = _mm256_set1_epi8('\r' - '\t');
+        for (; end - p >= 32; p += 32)
+        {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+            __m256i t = _mm256_sub_epi8(x, tab);
+            __m256i ws = _mm256_or_si256(_mm256_cmpeq_epi8(x, space), _mm256_cmpeq_epi8(_mm256_min_epu8(t, range), t));
+            uint32_t mask = ~static_cast<uint32_t>(_mm256_movemask_epi8(ws));
+            if (mask != 0)
             {
-                const std::string *a = static_cast<std::string *>(_value);
-                const std::string *b = static_cast<std::string *>(rhs._value);
-                return *a == *b;
+                return p + count_trailing_zeros(mask);
             }
-            break;
-
-        case json_t::boolean:
-            // 如果都是布尔类型，则比较布尔值
-            if (rhs._type == json_t::boolean)
-            {
-                const bool *a = static_cast<bool *>(_value);
-                const bool *b = static_cast<bool *>(rhs._value);
-                return *a == *b;
-            }
-            break;
+        }
+        return skip_whitespace_sse2(p, end);
+    }
 
-        case json_t::number_integer:
-            // 如果都是整数类型，则比较整数值
-            if (rhs._type == json_t::number_integer)
+    __attribute__((target("avx2"))) inline const char *find_string_special_avx2(const char *p, const char *end)
+    {
+        const __m256i quote = _mm256_set1_epi8('"');
+        const __m256i backslash = _mm256_set1_epi8('\\');
+        const __m256i control = _mm256_set1_epi8(0x20);
+        for (; end - p >= 32; p += 32)
+        {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+            __m256i special = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(x, quote), _mm256_cmpeq_epi8(x, backslash)),
+                                              _mm256_cmpgt_epi8(control, x));
+            uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(special));
+            if (mask != 0)
             {
-                const long long *a = static_cast<long long *>(_value);
-                const long long *b = static_cast<long long *>(rhs._value);
-                return *a == *b;
+                return p + count_trailing_zeros(mask);
             }
-            break;
+        }
+        return find_string_special_sse2(p, end);
+    }
 
-        case json_t::number_double:
-            // 如果都是浮点数类型，则比较浮点数值
-            if (rhs._type == json_t::number_double)
+    __attribute__((target("avx2"))) inline const char *find_escape_byte_avx2(const char *p, const char *end)
+    {
+        const __m256i quote = _mm256_set1_epi8('"');
+        const __m256i backslash = _mm256_set1_epi8('\\');
+        const __m256i control = _mm256_set1_epi8(0x1F);
+        for (; end - p >= 32; p += 32)
+        {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+            __m256i special = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(x, quote), _mm256_cmpeq_epi8(x, backslash)),
+                                              _mm256_cmpeq_epi8(_mm256_min_epu8(x, control), x));
+            uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(special));
+            if (mask != 0)
             {
-                const double *a = static_cast<double *>(_value);
-                const double *b = static_cast<double *>(rhs._value);
-                return *a == *b;
+                return p + count_trailing_zeros(mask);
             }
-            break;
-
-        default:
-            // 其他类型（如 invalid）不相等
-            return false;
         }
-
-        // 如果所有比较都失败，则返回 false
-        return false;
+        return find_escape_byte_sse2(p, end);
     }
 
-    inline bool json::operator!=(const json &rhs) const
+    // 运行时检测一次 CPU 是否支持 AVX2
+    inline bool cpu_has_avx2()
     {
-        return !(*this == rhs);
+        static const bool has_avx2 = __builtin_cpu_supports("avx2") != 0;
+        return has_avx2;
     }
+#endif
 
-    // 获取当前 JSON 对象的字符串值
-    inline const std::string json::get_string() const
+#if defined(TINYJSON_NEON)
+    // NEON 没有 movemask，把每个字节的比较结果压缩为 4 位，得到 64 位的掩码
+    inline uint64_t neon_mask(uint8x16_t m)
     {
-        CHECK_TYPE_MISMATCH(this->_type, json_t::string);
-        return *static_cast<std::string *>(_value);
+        uint8x8_t packed = vshrn_n_u16(vreinterpretq_u16_u8(m), 4);
+        return vget_lane_u64(vreinterpret_u64_u8(packed), 0);
     }
 
-    // 获取当前 JSON 对象的整数值
-    inline const long long json::get_integer() const
+    inline const char *skip_whitespace_neon(const char *p, const char *end)
     {
-        CHECK_TYPE_MISMATCH(this->_type, json_t::number_integer);
-        return *static_cast<long long *>(_value);
+        const uint8x16_t space = vdupq_n_u8(' ');
+        const uint8x16_t tab = vdupq_n_u8('\t');
+        const uint8x16_t range = vdupq_n_u8('\r' - '\t');
+        for (; end - p >= 16; p += 16)
+        {
+            uint8x16_t x = vld1q_u8(reinterpret_cast<const uint8_t *>(p));
+            uint8x16_t ws = vorrq_u8(vceqq_u8(x, space), vcleq_u8(vsubq_u8(x, tab), range));
+            uint64_t mask = ~neon_mask(ws);
+            if (mask != 0)
+            {
+                return p + count_trailing_zeros(mask) / 4;
+            }
+        }
+        return skip_whitespace_scalar(p, end);
     }
 
-    // 获取当前 JSON 对象的双精度浮点数值
-    inline const double json::get_double() const
+    inline const char *find_string_special_neon(const char *p, const char *end)
     {
-        CHECK_TYPE_MISMATCH(this->_type, json_t::number_double);
-        return *static_cast<double *>(_value);
+        const uint8x16_t quote = vdupq_n_u8('"');
+        const uint8x16_t backslash = vdupq_n_u8('\\');
+        const int8x16_t control = vdupq_n_s8(0x20);
+        for (; end - p >= 16; p += 16)
+        {
+            uint8x16_t x = vld1q_u8(reinterpret_cast<const uint8_t *>(p));
+            uint8x16_t special = vorrq_u8(vorrq_u8(vceqq_u8(x, quote), vceqq_u8(x, backslash)),
+                                          vcltq_s8(vreinterpretq_s8_u8(x), control));
+            uint64_t mask = neon_mask(special);
+            if (mask != 0)
+            {
+                return p + count_trailing_zeros(mask) / 4;
+            }
+        }
+        return find_string_special_scalar(p, end);
     }
 
-    // 获取当前 JSON 对象的布尔值
-    inline const bool json::get_bool() const
+    inline const char *find_escape_byte_neon(const char *p, const char *end)
     {
-        CHECK_TYPE_MISMATCH(this->_type, json_t::boolean);
-        return *static_cast<bool *>(_value);
+        const uint8x16_t quote = vdupq_n_u8('"');
+        const uint8x16_t backslash = vdupq_n_u8('\\');
+        const uint8x16_t control = vdupq_n_u8(0x20);
+        for (; end - p >= 16; p += 16)
+        {
+            uint8x16_t x = vld1q_u8(reinterpret_cast<const uint8_t *>(p));
+            uint8x16_t special = vorrq_u8(vorrq_u8(vceqq_u8(x, quote), vceqq_u8(x, backslash)), vcltq_u8(x, control));
+            uint64_t mask = neon_mask(special);
+            if (mask != 0)
+            {
+                return p + count_trailing_zeros(mask) / 4;
+            }
+        }
+        return find_escape_byte_scalar(p, end);
     }
+#endif
 
-    // 获取当前 JSON 对象的对象值
-    inline const json_object json::get_object() const
+    // 跳过空白字符，返回第一个非空白字符的位置（没有则返回 end）
+    inline const char *skip_whitespace(const char *p, const char *end)
     {
-        CHECK_TYPE_MISMATCH(this->_type, json_t::object);
-        return *static_cast<json_object *>(_value);
+        // 大多数位置之前没有或只有一个空白字符，此时不值得启用向量化扫描
+        if (p == end || !is_space_byte(*p))
+            return p;
+        if (++p == end || !is_space_byte(*p))
+            return p;
+
+#if defined(TINYJSON_AVX2_DISPATCH)
+        if (cpu_has_avx2())
+            return skip_whitespace_avx2(p, end);
+#endif
+#if defined(TINYJSON_SSE2)
+        return skip_whitespace_sse2(p, end);
+#elif defined(TINYJSON_NEON)
+        return skip_whitespace_neon(p, end);
+#else
+        return skip_whitespace_scalar(p, end);
+#endif
     }
 
-    // 获取当前 JSON 对象的数组值
-    inline const json_array json::get_array() const
+    // 查找字符串中下一个需要处理的字节（双引号、反斜杠、控制字符或非 ASCII 字节），没有则返回 end
+    inline const char *find_string_special(const char *p, const char *end)
     {
-        CHECK_TYPE_MISMATCH(this->_type, json_t::array);
-        return *static_cast<json_array *>(_value);
+#if defined(TINYJSON_AVX2_DISPATCH)
+        if (cpu_has_avx2())
+            return find_string_special_avx2(p, end);
+#endif
+#if defined(TINYJSON_SSE2)
+        return find_string_special_sse2(p, end);
+#elif defined(TINYJSON_NEON)
+        return find_string_special_neon(p, end);
+#else
+        return find_string_special_scalar(p, end);
+#endif
     }
 
-    // 获取当前 JSON 对象的 null 值
-    inline const void *json::get_null() const
+    // 查找字符串中下一个需要转义的字节（双引号、反斜杠或控制字符），没有则返回 end
+    inline const char *find_escape_byte(const char *p, const char *end)
     {
-        CHECK_TYPE_MISMATCH(this->_type, json_t::null);
-        return nullptr;
+#if defined(TINYJSON_AVX2_DISPATCH)
+        if (cpu_has_avx2())
+            return find_escape_byte_avx2(p, end);
+#endif
+#if defined(TINYJSON_SSE2)
+        return find_escape_byte_sse2(p, end);
+#elif defined(TINYJSON_NEON)
+        return find_escape_byte_neon(p, end);
+#else
+        return find_escape_byte_scalar(p, end);
+#endif
     }
 
-    // 检查当前 JSON 对象是否包含指定名称的成员
-    inline bool json::has_member(std::string member_name)
+    // 不拥有数据的只读字符串视图（指针 + 长度）
+    // C++11 没有 std::string_view，这里提供一个最小实现，C++17 下可隐式转换为 std::string_view
+    class string_view
     {
-        CHECK_TYPE_MISMATCH(this->_type, json_t::object);
-        auto members = static_cast<json_object *>(_value);
-        return (members->find(member_name) != members->end());
-    }
+    public:
+        string_view() : _data(nullptr), _size(0) {}
+        string_view(const char *s) : _data(s), _size(std::char_traits<char>::length(s)) {}
+        string_view(const char *s, size_t n) : _data(s), _size(n) {}
+        template <class A>
+        string_view(const std::basic_string<char, std::char_traits<char>, A> &s) : _data(s.data()), _size(s.size()) {}
+
+        const char *data() const { return _data; }
+        size_t size() const { return _size; }
+        size_t length() const { return _size; }
+        bool empty() const { return _size == 0; }
+
+        const char *begin() const { return _data; }
+        const char *end() const { return _data + _size; }
+        char operator[](size_t i) const { return _data[i]; }
+
+        /// 复制为 std::string
+        std::string to_string() const { return std::string(_data, _size); }
+        explicit operator std::string() const { return to_string(); }
+
+#if __cplusplus >= 201703L
+        operator std::string_view() const { return std::string_view(_data, _size); }
+#endif
+
+        /// 按字节比较，与 std::string::compare 的约定一致
+        int compare(string_view other) const
+        {
+            size_t n = _size < other._size ? _size : other._size;
+            int r = n ? std::char_traits<char>::compare(_data, other._data, n) : 0;
+            if (r != 0)
+                return r;
+            return _size < other._size ? -1 : (_size > other._size ? 1 : 0);
+        }
 
-    // 向当前 JSON 对象添加一个成员
-    inline void json::add_member(std::string member_name, json member_value)
+    private:
+        const char *_data; ///< 指向字符数据，不以 NUL 结尾
+        size_t _size;      ///< 字节数
+    };
+
+    inline bool operator==(string_view a, string_view b)
     {
-        CHECK_TYPE_MISMATCH(this->_type, json_t::object);
-        auto members = static_cast<json_object *>(_value);
-        (*members)[member_name] = member_value;
+        // 指向同一段字符（例如同一个键名池中的键名）时不必逐字节比较
+        return a.size() == b.size() &&
+               (a.data() == b.data() || a.size() == 0 || std::char_traits<char>::compare(a.data(), b.data(), a.size()) == 0);
     }
+    inline bool operator!=(string_view a, string_view b) { return !(a == b); }
+    inline bool operator<(string_view a, string_view b) { return a.compare(b) < 0; }
 
-    // 向当前 JSON 数组添加一个元素
-    inline void json::add_element(json elem)
+    inline std::ostream &operator<<(std::ostream &os, string_view sv)
     {
-        CHECK_TYPE_MISMATCH(this->_type, json_t::array);
-        auto elems = static_cast<json_array *>(_value);
-        elems->push_back(elem);
+        return os.write(sv.data(), static_cast<std::streamsize>(sv.size()));
     }
 
-    // 获取当前 JSON 对象的大小
-    // 如果当前类型是数组或对象，返回数组的长度或对象的成员数
-    inline size_t json::size() const
+    // 将整数格式化为十进制写入 buf（从缓冲区末尾向前写），返回首字符位置
+    // buf 至少需要 20 字节；每次查表输出两位数字，除法次数减半
+    inline char *format_integer(long long val, char *buf_end)
     {
-        if (_type == json_t::array)
+        static const char digit_pairs[] =
+            "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+            "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+            "8081828384858687888990919293949596979899";
+
+        // 取绝对值时使用无符号类型，避免 LLONG_MIN 取反溢出
+        unsigned long long u = val < 0 ? 0ULL - static_cast<unsigned long long>(val)
+                                       : static_cast<unsigned long long>(val);
+        char *p = buf_end;
+        while (u >= 100)
         {
-            // 如果是数组类型，返回数组的大小
-            auto array = static_cast<json_array *>(_value);
-            return array->size();
+            unsigned i = static_cast<unsigned>(u % 100) * 2;
+            u /= 100;
+            *--p = digit_pairs[i + 1];
+            *--p = digit_pairs[i];
         }
-        else if (_type == json_t::object)
+        if (u >= 10)
         {
-            // 如果是对象类型，返回对象的成员数量
-            auto members = static_cast<json_object *>(_value);
-            return members->size();
+            unsigned i = static_cast<unsigned>(u) * 2;
+            *--p = digit_pairs[i + 1];
+            *--p = digit_pairs[i];
         }
-
-        // 如果不是数组或对象类型，抛出异常
-        throw std::runtime_error("Unexpected json type " + type_name() + ", expected array or object");
+        else
+        {
+            *--p = static_cast<char>('0' + u);
+        }
+        if (val < 0)
+            *--p = '-';
+        return p;
     }
 
-    // 重载对象类型的 JSON 对象的下标运算符
-    // 如果当前类型不是对象类型，则抛出异常
-    inline json &json::operator[](const char *key)
+    // 双精度浮点数的最短往返格式化（Grisu2，Florian Loitsch,
+    // "Printing Floating-Point Numbers Quickly and Accurately with Integers", PLDI 2010）
+    // 输出的数字串再解析回来与原值完全相同，并且在绝大多数情况下是最短的
+    namespace grisu
     {
-        CHECK_TYPE_MISMATCH(this->_type, json_t::object);
-        json_object *members = static_cast<json_object *>(_value);
+        // 无限精度浮点数的近似：f * 2^e
+        struct diyfp
+        {
+            uint64_t f;
+            int e;
 
-        // 通过键名访问对象中的成员
-        if (members->find(key) == members->end())
+            diyfp(uint64_t f_, int e_) : f(f_), e(e_) {}
+
+            // x - y，要求 x.e == y.e 且 x.f >= y.f
+            static diyfp sub(const diyfp &x, const diyfp &y) { return diyfp(x.f - y.f, x.e); }
+
+            // x * y 的高 64 位（四舍五入）
+            static diyfp mul(const diyfp &x, const diyfp &y)
+            {
+                uint64_t hi, lo;
+                multiply_64x64(x.f, y.f, hi, lo);
+                hi += lo >> 63;
+                return diyfp(hi, x.e + y.e + 64);
+            }
+
+            // 规格化，使最高位为 1
+            static diyfp normalize(diyfp x)
+            {
+                int lz = count_leading_zeros(x.f);
+                return diyfp(x.f << lz, x.e - lz);
+            }
+
+            // 调整到指定的指数，要求不会溢出
+            static diyfp normalize_to(const diyfp &x, int target_exponent)
+            {
+                return diyfp(x.f << (x.e - target_exponent), target_exponent);
+            }
+        };
+
+        // v 以及与相邻浮点数的中点 m- 和 m+，m- 和 m+ 的指数相同
+        struct boundaries
+        {
+            diyfp w;
+            diyfp minus;
+            diyfp plus;
+        };
+
+        // 计算正的有限值 value 的边界
+        inline boundaries compute_boundaries(double value)
         {
-            throw std::runtime_error("key " + std::string(key) + " not found.");
+            const int bias = 1075; // 1023 + 52
+            const int min_exp = 1 - bias;
+            const uint64_t hidden_bit = 1ULL << 52;
+
+            uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            uint64_t E = bits >> 52;
+            uint64_t F = bits & (hidden_bit - 1);
+
+            diyfp v = E == 0 ? diyfp(F, min_exp) : diyfp(F + hidden_bit, static_cast<int>(E) - bias);
+
+            // 尾数为 0 时，与较小的相邻浮点数的距离只有一半
+            bool lower_boundary_is_closer = F == 0 && E > 1;
+            diyfp m_plus(2 * v.f + 1, v.e - 1);
+            diyfp m_minus = lower_boundary_is_closer ? diyfp(4 * v.f - 1, v.e - 2) : diyfp(2 * v.f - 1, v.e - 1);
+
+            diyfp w_plus = diyfp::normalize(m_plus);
+            diyfp w_minus = diyfp::normalize_to(m_minus, w_plus.e);
+            boundaries result = {diyfp::normalize(v), w_minus, w_plus};
+            return result;
         }
 
-        return (*members)[key];
-    }
+        // 缓存的 10^k（规格化的 64 位近似），k 从 -300 到 324，步长为 8
+        struct cached_power
+        {
+            uint64_t f;
+            int e;
+            int k;
+        };
 
-    // 重载数组类型的 JSON 对象的下标运算符
-    inline json &json::operator[](int index)
-    {
-        CHECK_TYPE_MISMATCH(this->_type, json_t::array);
-        json_array *array = static_cast<json_array *>(_value);
+        // 选取 c = 10^-k，使 c * 2^e 的二进制指数落在 [alpha, gamma] = [-60, -32] 之间
+        inline cached_power get_cached_power(int e)
+        {
+            static const cached_power powers[] = {
+            {0xAB70FE17C79AC6CAULL, -1060, -300},
+            {0xFF77B1FCBEBCDC4FULL, -1034, -292},
+            {0xBE5691EF416BD60CULL, -1007, -284},
+            {0x8DD01FAD907FFC3CULL, -980, -276},
+            {0xD3515C2831559A83ULL, -954, -268},
+            {0x9D71AC8FADA6C9B5ULL, -927, -260},
+            {0xEA9C227723EE8BCBULL, -901, -252},
+            {0xAECC49914078536DULL, -874, -244},
+            {0x823C12795DB6CE57ULL, -847, -236},
+            {0xC21094364DFB5637ULL, -821, -228},
+            {0x9096EA6F3848984FULL, -794, -220},
+            {0xD77485CB25823AC7ULL, -768, -212},
+            {0xA086CFCD97BF97F4ULL, -741, -204},
+            {0xEF340A98172AACE5ULL, -715, -196},
+            {0xB23867FB2A35B28EULL, -688, -188},
+            {0x84C8D4DFD2C63F3BULL, -661, -180},
+            {0xC5DD44271AD3CDBAULL, -635, -172},
+            {0x936B9FCEBB25C996ULL, -608, -164},
+            {0xDBAC6C247D62A584ULL, -582, -156},
+            {0xA3AB66580D5FDAF6ULL, -555, -148},
+            {0xF3E2F893DEC3F126ULL, -529, -140},
+            {0xB5B5ADA8AAFF80B8ULL, -502, -132},
+            {0x87625F056C7C4A8BULL, -475, -124},
+            {0xC9BCFF6034C13053ULL, -449, -116},
+            {0x964E858C91BA2655ULL, -422, -108},
+            {0xDFF9772470297EBDULL, -396, -100},
+            {0xA6DFBD9FB8E5B88FULL, -369, -92},
+            {0xF8A95FCF88747D94ULL, -343, -84},
+            {0xB94470938FA89BCFULL, -316, -76},
+            {0x8A08F0F8BF0F156BULL, -289, -68},
+            {0xCDB02555653131B6ULL, -263, -60},
+            {0x993FE2C6D07B7FACULL, -236, -52},
+            {0xE45C10C42A2B3B06ULL, -210, -44},
+            {0xAA242499697392D3ULL, -183, -36},
+            {0xFD87B5F28300CA0EULL, -157, -28},
+            {0xBCE5086492111AEBULL, -130, -20},
+            {0x8CBCCC096F5088CCULL, -103, -12},
+            {0xD1B71758E219652CULL, -77, -4},
+            {0x9C40000000000000ULL, -50, 4},
+            {0xE8D4A51000000000ULL, -24, 12},
+            {0xAD78EBC5AC620000ULL, 3, 20},
+            {0x813F3978F8940984ULL, 30, 28},
+            {0xC097CE7BC90715B3ULL, 56, 36},
+            {0x8F7E32CE7BEA5C70ULL, 83, 44},
+            {0xD5D238A4ABE98068ULL, 109, 52},
+            {0x9F4F2726179A2245ULL, 136, 60},
+            {0xED63A231D4C4FB27ULL, 162, 68},
+            {0xB0DE65388CC8ADA8ULL, 189, 76},
+            {0x83C7088E1AAB65DBULL, 216, 84},
+            {0xC45D1DF942711D9AULL, 242, 92},
+            {0x924D692CA61BE758ULL, 269, 100},
+            {0xDA01EE641A708DEAULL, 295, 108},
+            {0xA26DA3999AEF774AULL, 322, 116},
+            {0xF209787BB47D6B85ULL, 348, 124},
+            {0xB454E4A179DD1877ULL, 375, 132},
+            {0x865B86925B9BC5C2ULL, 402, 140},
+            {0xC83553C5C8965D3DULL, 428, 148},
+            {0x952AB45CFA97A0B3ULL, 455, 156},
+            {0xDE469FBD99A05FE3ULL, 481, 164},
+            {0xA59BC234DB398C25ULL, 508, 172},
+            {0xF6C69A72A3989F5CULL, 534, 180},
+            {0xB7DCBF5354E9BECEULL, 561, 188},
+            {0x88FCF317F22241E2ULL, 588, 196},
+            {0xCC20CE9BD35C78A5ULL, 614, 204},
+            {0x98165AF37B2153DFULL, 641, 212},
+            {0xE2A0B5DC971F303AULL, 667, 220},
+            {0xA8D9D1535CE3B396ULL, 694, 228},
+            {0xFB9B7CD9A4A7443CULL, 720, 236},
+            {0xBB764C4CA7A44410ULL, 747, 244},
+            {0x8BAB8EEFB6409C1AULL, 774, 252},
+            {0xD01FEF10A657842CULL, 800, 260},
+            {0x9B10A4E5E9913129ULL, 827, 268},
+            {0xE7109BFBA19C0C9DULL, 853, 276},
+            {0xAC2820D9623BF429ULL, 880, 284},
+            {0x80444B5E7AA7CF85ULL, 907, 292},
+            {0xBF21E44003ACDD2DULL, 933, 300},
+            {0x8E679C2F5E44FF8FULL, 960, 308},
+            {0xD433179D9C8CB841ULL, 986, 316},
+            {0x9E19DB92B4E31BA9ULL, 1013, 324},
+            };
+
+            const int alpha = -60;
+            const int min_dec_exp = -300;
+            const int dec_step = 8;
+
+            int f = alpha - e - 1;
+            int k = (f * 78913) / (1 << 18) + (f > 0); // ceil(f * log10(2))
+            int index = (-min_dec_exp + k + (dec_step - 1)) / dec_step;
+            return powers[index];
+        }
 
-        // 通过索引访问数组中的元素
-        if (index < 0 || (size_t)index >= array->size())
+        // 返回 n 的十进制位数 k，并令 pow10 = 10^(k-1)
+        inline int find_largest_pow10(uint32_t n, uint32_t &pow10)
         {
-            throw std::runtime_error("index " + std::to_string(index) + " out of range.");
+            static const uint32_t powers[] = {1, 10, 100, 1000, 10000, 100000, 1000000,
+                                              10000000, 100000000, 1000000000};
+            int k = 1;
+            while (k < 10 && n >= powers[k])
+            {
+                ++k;
+            }
+            pow10 = powers[k - 1];
+            return k;
         }
 
-        return (*array)[index];
-    }
+        // 调整最后一位数字，使结果在安全区间内尽量接近 w
+        inline void round_weed(char *buf, int len, uint64_t dist, uint64_t delta, uint64_t rest, uint64_t ten_k)
+        {
+            while (rest < dist && delta - rest >= ten_k &&
+                   (rest + ten_k < dist || dist - rest > rest + ten_k - dist))
+            {
+                buf[len - 1]--;
+                rest += ten_k;
+            }
+        }
 
-    // 析构函数
-    inline json::~json()
+        // 生成 (M-, M+) 之间最短的数字串，v = buf * 10^decimal_exponent
+        inline void digit_gen(char *buf, int &len, int &decimal_exponent, diyfp M_minus, diyfp w, diyfp M_plus)
+        {
+            diyfp delta = diyfp::sub(M_plus, M_minus);
+            diyfp dist = diyfp::sub(M_plus, w);
+
+            // M+ 拆分为整数部分 p1 和小数部分 p2
+            const diyfp one(1ULL << -M_plus.e, M_plus.e);
+            uint32_t p1 = static_cast<uint32_t>(M_plus.f >> -one.e);
+            uint64_t p2 = M_plus.f & (one.f - 1);
+
+            // 整数部分的各位数字
+            uint32_t pow10;
+            int n = find_largest_pow10(p1, pow10);
+            while (n > 0)
+            {
+                uint32_t d = p1 / pow10;
+                p1 %= pow10;
+                buf[len++] = static_cast<char>('0' + d);
+                --n;
+
+                uint64_t rest = (static_cast<uint64_t>(p1) << -one.e) + p2;
+                if (rest <= delta.f)
+                {
+                    decimal_exponent += n;
+                    round_weed(buf, len, dist.f, delta.f, rest, static_cast<uint64_t>(pow10) << -one.e);
+                    return;
+                }
+                pow10 /= 10;
+            }
+
+            // 小数部分的各位数字
+            int m = 0;
+            while (true)
+            {
+                p2 *= 10;
+                uint64_t d = p2 >> -one.e;
+                p2 &= one.f - 1;
+                buf[len++] = static_cast<char>('0' + d);
+                ++m;
+
+                delta.f *= 10;
+                dist.f *= 10;
+                if (p2 <= delta.f)
+                {
+                    break;
+                }
+            }
+
+            decimal_exponent -= m;
+            round_weed(buf, len, dist.f, delta.f, p2, one.f);
+        }
+
+        // 生成正的有限值 value 的数字串，value = buf * 10^decimal_exponent，最多 17 位
+        inline void grisu2(char *buf, int &len, int &decimal_exponent, double value)
+        {
+            boundaries w = compute_boundaries(value);
+            cached_power cached = get_cached_power(w.plus.e);
+            diyfp c_minus_k(cached.f, cached.e);
+
+            diyfp v = diyfp::mul(w.w, c_minus_k);
+            diyfp w_minus = diyfp::mul(w.minus, c_minus_k);
+            diyfp w_plus = diyfp::mul(w.plus, c_minus_k);
+
+            // 乘法的误差不超过 1 ulp，收缩区间以保证结果在真实的区间之内
+            diyfp M_minus(w_minus.f + 1, w_minus.e);
+            diyfp M_plus(w_plus.f - 1, w_plus.e);
+
+            len = 0;
+            decimal_exponent = -cached.k;
+            digit_gen(buf, len, decimal_exponent, M_minus, v, M_plus);
+        }
+    } // namespace grisu
+
+    // 浮点数格式化所需的缓冲区大小
+    const size_t double_buffer_size = 32;
+
+    // 将浮点数格式化为最短的往返表示写入 buf，返回写入的字节数
+    // 十进制指数在 [-4, 14] 之间时使用定点格式（整数值补上 ".0"，以便解析回浮点数），
+    // 否则使用科学计数法，例如 1e+23；JSON 无法表示的无穷大和 NaN 输出为 null
+    inline size_t format_double(double val, char *buf)
     {
-        switch (_type)
+        if (val != val || val - val != 0)
         {
-        case (json_t::array):
-            delete static_cast<json_array *>(_value);
-            break;
-        case (json_t::object):
-            delete static_cast<json_object *>(_value);
-            break;
-        case (json_t::string):
-            delete static_cast<std::string *>(_value);
-            break;
-        case (json_t::boolean):
-            delete static_cast<bool *>(_value);
-            break;
-        case (json_t::number_double):
-            delete static_cast<double *>(_value);
-            break;
-        case (json_t::number_integer):
-            delete static_cast<long long *>(_value);
-            break;
-        default:
-            break;
+            std::memcpy(buf, "null", 4);
+            return 4;
+        }
+
+        char *p = buf;
+        if (std::signbit(val))
+        {
+            *p++ = '-';
+            val = -val;
+        }
+        if (val == 0)
+        {
+            std::memcpy(p, "0.0", 3);
+            return static_cast<size_t>(p + 3 - buf);
+        }
+
+        int k, exp10;
+        grisu::grisu2(p, k, exp10, val);
+
+        // 数值为 0.d1d2...dk * 10^n
+        const int min_exp = -4;
+        const int max_exp = 15;
+        int n = k + exp10;
+        if (k <= n && n <= max_exp)
+        {
+            // 1234e7 -> 12340000000.0
+            std::memset(p + k, '0', static_cast<size_t>(n - k));
+            p[n] = '.';
+            p[n + 1] = '0';
+            return static_cast<size_t>(p + n + 2 - buf);
+        }
+        if (0 < n && n <= max_exp)
+        {
+            // 1234e-2 -> 12.34
+            std::memmove(p + n + 1, p + n, static_cast<size_t>(k - n));
+            p[n] = '.';
+            return static_cast<size_t>(p + k + 1 - buf);
         }
+        if (min_exp < n && n <= 0)
+        {
+            // 1234e-6 -> 0.001234
+            std::memmove(p + 2 - n, p, static_cast<size_t>(k));
+            p[0] = '0';
+            p[1] = '.';
+            std::memset(p + 2, '0', static_cast<size_t>(-n));
+            return static_cast<size_t>(p + 2 - n + k - buf);
+        }
+
+        // 科学计数法：d.igitse+123
+        if (k > 1)
+        {
+            std::memmove(p + 2, p + 1, static_cast<size_t>(k - 1));
+            p[1] = '.';
+            p += k + 1;
+        }
+        else
+        {
+            p += 1;
+        }
+        *p++ = 'e';
+        int e = n - 1;
+        *p++ = e < 0 ? '-' : '+';
+        char exp_buf[8];
+        char *exp_end = exp_buf + sizeof(exp_buf);
+        char *exp_begin = format_integer(e < 0 ? -e : e, exp_end);
+        std::memcpy(p, exp_begin, static_cast<size_t>(exp_end - exp_begin));
+        p += exp_end - exp_begin;
+        return static_cast<size_t>(p - buf);
     }
 
-    // 类型转换运算符，将 json 对象转换为 const std::string 类型
-    inline json::operator const std::string() const
+    // 序列化输出目标（sink）
+    // 每个 sink 只需提供 put(char) 和 write(const char*, size_t) 两个操作，
+    // basic_json::dump 会把所有输出直接追加到 sink 中，不产生中间字符串
+
+    // 追加到调用方提供的字符串（可复用同一个缓冲区）
+    template <class String = std::string>
+    class string_sink
     {
-        switch (_type)
+    public:
+        explicit string_sink(String &out) : _out(out) {}
+
+        void put(char c) { _out.push_back(c); }
+        void write(const char *s, size_t n) { _out.append(s, n); }
+
+    private:
+        String &_out; ///< 输出缓冲区
+    };
+
+    // 写入 std::ostream，内部带有固定大小的缓冲区以减少流操作次数
+    // 析构时自动刷新，也可以调用 flush() 提前写出
+    class ostream_sink
+    {
+    public:
+        explicit ostream_sink(std::ostream &os) : _os(os), _len(0) {}
+        ~ostream_sink() { flush(); }
+
+        ostream_sink(const ostream_sink &) = delete;
+        ostream_sink &operator=(const ostream_sink &) = delete;
+
+        void put(char c)
         {
-        case json_t::string:
-            return *static_cast<std::string *>(_value);
-        default:
-            throw std::runtime_error("cannot cast " + type_name() + " to json string");
+            if (_len == sizeof(_buf))
+                flush();
+            _buf[_len++] = c;
         }
-    }
 
-    // 类型转换运算符，将 json 对象转换为 const double 类型
-    inline json::operator const double() const
+        void write(const char *s, size_t n)
+        {
+            if (n > sizeof(_buf) - _len)
+            {
+                flush();
+                if (n >= sizeof(_buf))
+                {
+                    _os.write(s, static_cast<std::streamsize>(n));
+                    return;
+                }
+            }
+            std::char_traits<char>::copy(_buf + _len, s, n);
+            _len += n;
+        }
+
+        void flush()
+        {
+            if (_len != 0)
+            {
+                _os.write(_buf, static_cast<std::streamsize>(_len));
+                _len = 0;
+            }
+        }
+
+    private:
+        std::ostream &_os; ///< 目标输出流
+        char _buf[1024];   ///< 待写出的数据
+        size_t _len;       ///< 缓冲区中已有的字节数
+    };
+
+    // 只统计字节数而不输出，用于在序列化前精确计算所需空间
+    class counting_sink
     {
-        switch (_type)
+    public:
+        counting_sink() : _count(0) {}
+
+        void put(char) { ++_count; }
+        void write(const char *, size_t n) { _count += n; }
+
+        size_t count() const { return _count; }
+
+    private:
+        size_t _count; ///< 已统计的字节数
+    };
+
+    // 输出带双引号的字符串，键名和字符串值共用
+    // 不需要转义的字节成段写出，只有双引号、反斜杠和控制字符按 json_escape_table 转义
+    template <class Sink>
+    inline void write_string(Sink &sink, string_view s)
+    {
+        static const char hex_digits[] = "0123456789abcdef";
+        const char *p = s.data();
+        const char *end = p + s.size();
+
+        sink.put('"');
+        while (true)
         {
-        case json_t::number_double:
-            return *static_cast<double *>(_value);
-        default:
-            throw std::runtime_error("cannot cast " + type_name() + " to json number");
+            const char *special = find_escape_byte(p, end); // 向量化地跳过不需要转义的字节
+            if (special != p)
+            {
+                sink.write(p, static_cast<size_t>(special - p));
+            }
+            if (special == end)
+            {
+                break;
+            }
+
+            unsigned char c = static_cast<unsigned char>(*special);
+            char escape = json_escape_table[c];
+            if (escape == 'u')
+            {
+                const char buf[6] = {'\\', 'u', '0', '0', hex_digits[c >> 4], hex_digits[c & 0xF]};
+                sink.write(buf, 6);
+            }
+            else
+            {
+                const char buf[2] = {'\\', escape};
+                sink.write(buf, 2);
+            }
+            p = special + 1;
         }
+        sink.put('"');
     }
 
-    // 类型转换运算符，将 json 对象转换为 const long long 类型
-    inline json::operator const long long() const
+    // 枚举类型 json_t 表示 JSON 值的可能数据类型
+    enum json_t
     {
-        switch (_type)
+        string = 0,     // 表示一个 JSON 字符串
+        number_integer, // 表示一个 JSON 整数
+        number_double,  // 表示一个 JSON 浮点数
+        array,          // 表示一个 JSON 数组
+        boolean,        // 表示一个 JSON 布尔值（true 或 false）
+        object,         // 表示一个 JSON 对象
+        null,           // 表示 JSON 的 null 值
+        invalid         // 表示无效或未知的 JSON 类型
+    };
+
+    // 序列化格式，用于 dump(sink, options) 和 json_writer
+    //     dump_options::compact()   // {"a":[1,2]}，不含任何空白
+    //     dump_options::pretty(2)   // 每个成员和元素单独一行，每层缩进 2 个空格
+    // 不带 options 的 dump() 保持原来的格式（键值之间为 " : "）
+    struct dump_options
+    {
+        int indent;       ///< 每层缩进的字符数，小于 0 时不换行也不缩进
+        char indent_char; ///< 缩进使用的字符，通常为空格或制表符
+
+        dump_options() : indent(-1), indent_char(' ') {}
+        explicit dump_options(int indent, char indent_char = ' ') : indent(indent), indent_char(indent_char) {}
+
+        static dump_options compact() { return dump_options(); }
+        static dump_options pretty(int indent = 4, char indent_char = ' ') { return dump_options(indent, indent_char); }
+    };
+
+    // 按 dump_options 格式输出 JSON 的流式写入器
+    // 既可以整体写出一棵 JSON 树（write），也可以作为 SAX 处理器逐个接收事件，
+    // 例如 parser::sax_parse(text, writer) 不构建 JSON 树就完成重新格式化
+    // 一个写入器只输出一个根节点；sink 由调用方持有，必须比写入器活得久
+    template <class Sink>
+    class json_writer
+    {
+    public:
+        explicit json_writer(Sink &sink, const dump_options &options = dump_options())
+            : _sink(sink), _options(options), _depth(0), _first(true), _after_key(false) {}
+
+        /// 写出整棵 JSON 树，标量由 dump(sink) 输出
+        template <class BasicJson>
+        void write(const BasicJson &j)
+        {
+            switch (j.type())
+            {
+            case json_t::object:
+                start_object();
+                for (const auto &member : j.get_object())
+                {
+                    key(string_view(member.first.data(), member.first.size()));
+                    write(member.second);
+                }
+                end_object();
+                break;
+
+            case json_t::array:
+                start_array();
+                for (const auto &elem : j.get_array())
+                {
+                    write(elem);
+                }
+                end_array();
+                break;
+
+            default:
+                begin_value();
+                j.dump(_sink);
+                break;
+            }
+        }
+
+        bool null()
+        {
+            begin_value();
+            _sink.write("null", 4);
+            return true;
+        }
+
+        bool boolean(bool val)
+        {
+            begin_value();
+            if (val)
+                _sink.write("true", 4);
+            else
+                _sink.write("false", 5);
+            return true;
+        }
+
+        bool number_integer(long long val)
+        {
+            begin_value();
+            char buf[24];
+            char *end = buf + sizeof(buf);
+            char *begin = format_integer(val, end);
+            _sink.write(begin, static_cast<size_t>(end - begin));
+            return true;
+        }
+
+        bool number_double(double val)
+        {
+            begin_value();
+            char buf[double_buffer_size];
+            _sink.write(buf, format_double(val, buf));
+            return true;
+        }
+
+        bool string(string_view val)
+        {
+            begin_value();
+            write_string(_sink, val);
+            return true;
+        }
+
+        bool start_object() { return open('{'); }
+        bool end_object() { return close('}'); }
+        bool start_array() { return open('['); }
+        bool end_array() { return close(']'); }
+
+        bool key(string_view name)
+        {
+            begin_value();
+            write_string(_sink, name);
+            if (_options.indent < 0)
+                _sink.put(':');
+            else
+                _sink.write(": ", 2);
+            _after_key = true;
+            return true;
+        }
+
+    private:
+        // 在值（或键名）之前输出与前一个兄弟节点的分隔符，以及换行和缩进
+        void begin_value()
+        {
+            if (_after_key)
+            {
+                _after_key = false; // 成员的值紧跟在键名之后
+                return;
+            }
+            if (_depth == 0)
+            {
+                return; // 根节点
+            }
+            if (!_first)
+            {
+                _sink.put(',');
+            }
+            _first = false;
+            newline(_depth);
+        }
+
+        bool open(char c)
+        {
+            begin_value();
+            _sink.put(c);
+            ++_depth;
+            _first = true;
+            return true;
+        }
+
+        // 空的容器不换行，直接输出 {} 或 []
+        bool close(char c)
+        {
+            --_depth;
+            if (!_first)
+            {
+                newline(_depth);
+            }
+            _sink.put(c);
+            _first = false;
+            return true;
+        }
+
+        void newline(size_t depth)
+        {
+            if (_options.indent < 0)
+            {
+                return;
+            }
+            _sink.put('\n');
+            for (size_t n = depth * static_cast<size_t>(_options.indent); n > 0; n--)
+            {
+                _sink.put(_options.indent_char);
+            }
+        }
+
+        Sink &_sink;           ///< 输出目标
+        dump_options _options; ///< 输出格式
+        size_t _depth;         ///< 当前所在的容器层数
+        bool _first;           ///< 当前容器中还没有输出过成员或元素
+        bool _after_key;       ///< 刚输出了键名，下一个值不需要分隔符
+    };
+
+    // 去除 JSON 文本中字符串之外的全部空白，追加到 out 的末尾，不构建 JSON 树
+    // 只做词法扫描：字符串用 find_escape_byte 成段跳过并原样复制，空白用 skip_whitespace 成段跳过
+    // 不校验输入；输入是合法的 JSON 时输出与 dump_options::compact() 的格式一致（数值和转义保持原文）
+    inline void minify(const char *s, size_t length, std::string &out)
+    {
+        const char *p = s;
+        const char *end = s + length;
+        out.reserve(out.size() + length);
+        while (p < end)
+        {
+            // 结构字符与字面量原样复制，直到空白或字符串开头
+            const char *run = p;
+            while (p < end && *p != '"' && !is_space_byte(*p))
+            {
+                ++p;
+            }
+            out.append(run, p);
+            if (p == end)
+            {
+                break;
+            }
+
+            if (*p != '"')
+            {
+                p = skip_whitespace(p, end);
+                continue;
+            }
+
+            // 字符串：找到未转义的结尾双引号，整段复制
+            run = p++;
+            while (true)
+            {
+                p = find_escape_byte(p, end);
+                if (p == end)
+                {
+                    break; // 缺少结尾的双引号，复制到输入末尾
+                }
+                if (*p == '"')
+                {
+                    ++p;
+                    break;
+                }
+                // 反斜杠跳过下一个字节，控制字符原样复制
+                p += (*p == '\\' && p + 1 < end) ? 2 : 1;
+            }
+            out.append(run, p);
+        }
+    }
+
+    inline void minify(string_view text, std::string &out)
+    {
+        minify(text.data(), text.size(), out);
+    }
+
+    inline std::string minify(string_view text)
+    {
+        std::string out;
+        minify(text.data(), text.size(), out);
+        return out;
+    }
+
+    // 数值的解析结果，type 为 json_t::number_integer 或 json_t::number_double
+    struct parsed_number
+    {
+        json_t type;        ///< 数值类型
+        long long integer;  ///< 整数值
+        double number;      ///< 浮点数值
+    };
+
+    // 字节级解析器报告的错误种类
+    enum class parse_errc
+    {
+        none = 0,                // 没有错误
+        unexpected_end,          // 输入在值结束之前结束
+        unexpected_character,    // 值的开头出现了意外的字符
+        invalid_root,            // 根节点不是对象或数组
+        trailing_characters,     // 根节点之后还有非空白字符
+        invalid_object,          // 对象的键名、冒号或逗号不符合格式
+        invalid_array,           // 数组的逗号或右括号不符合格式
+        invalid_literal,         // true、false 或 null 拼写错误
+        invalid_number,          // 数值格式错误
+        number_out_of_range,     // 数值超出双精度浮点数的范围
+        invalid_escape,          // 反斜杠之后不是合法的转义字符
+        invalid_unicode_escape,  // \u 之后不是四位十六进制数，或代理对不完整
+        invalid_utf8,            // 字符串中的 UTF-8 序列无效
+        depth_exceeded           // 嵌套深度超过 TINYJSON_MAX_DEPTH
+    };
+
+    // 错误种类的说明
+    inline const char *parse_errc_message(parse_errc code)
+    {
+        switch (code)
+        {
+        case parse_errc::none:
+            return "no error";
+        case parse_errc::unexpected_end:
+            return "unexpected end of input";
+        case parse_errc::unexpected_character:
+            return "unexpected character";
+        case parse_errc::invalid_root:
+            return "invalid json format";
+        case parse_errc::trailing_characters:
+            return "unexpected character after the root value";
+        case parse_errc::invalid_object:
+            return "invalid object format";
+        case parse_errc::invalid_array:
+            return "expected char ']' not found";
+        case parse_errc::invalid_literal:
+            return "invalid literal";
+        case parse_errc::invalid_number:
+            return "Unexpected number format.";
+        case parse_errc::number_out_of_range:
+            return "number out of range";
+        case parse_errc::invalid_escape:
+            return "backslash is followed by invalid character";
+        case parse_errc::invalid_unicode_escape:
+            return "invalid unicode escape";
+        case parse_errc::invalid_utf8:
+            return "invalid utf8 string";
+        case parse_errc::depth_exceeded:
+            return "maximum nesting depth exceeded";
+        }
+        return "unknown error";
+    }
+
+    // 解析错误的种类和位置；code 为 parse_errc::none 时表示没有错误
+    struct parse_error
+    {
+        parse_errc code = parse_errc::none; ///< 错误种类
+        size_t offset = 0;                  ///< 出错位置距输入开头的字节数
+        size_t line = 0;                    ///< 出错位置所在的行，从 1 开始
+        size_t column = 0;                  ///< 出错位置在行内的字节位置，从 1 开始
+
+        explicit operator bool() const { return code != parse_errc::none; }
+
+        /// 错误种类的说明
+        const char *message() const { return parse_errc_message(code); }
+
+        /// 说明和位置，例如 "invalid object format at line 1, column 8"
+        std::string to_string() const
+        {
+            return std::string(message()) + " at line " + std::to_string(line) + ", column " + std::to_string(column);
+        }
+
+        /// 根据输入的开头和出错位置计算行号和列号，只在出错时调用
+        static parse_error at(parse_errc code, const char *begin, const char *pos)
+        {
+            parse_error err;
+            err.code = code;
+            err.offset = static_cast<size_t>(pos - begin);
+            err.line = 1;
+            const char *line_begin = begin;
+            for (const char *p = begin; p < pos && (p = static_cast<const char *>(std::memchr(p, '\n', static_cast<size_t>(pos - p)))) != nullptr; ++p)
+            {
+                err.line++;
+                line_begin = p + 1;
+            }
+            err.column = static_cast<size_t>(pos - line_begin) + 1;
+            return err;
+        }
+    };
+
+    // 字节级解析器抛出的异常，携带错误的种类和位置
+    class parse_exception : public std::runtime_error
+    {
+    public:
+        explicit parse_exception(const parse_error &err) : std::runtime_error(err.to_string()), _error(err) {}
+
+        const parse_error &error() const { return _error; }
+
+    private:
+        parse_error _error; ///< 错误的种类和位置
+    };
+
+    // 128 位精度的 5 的幂，用于 Eisel-Lemire 算法，覆盖 5^-342 到 5^308
+    // 每个幂占两个 64 位数（高位在前），最高位始终为 1；表由 fast_float 的生成脚本得到
+    // 放在类模板的静态成员中，使其在只有头文件的库中也只有一份定义
+    template <class T = void>
+    struct power_of_five_table
+    {
+        static const int smallest_power = -342;
+        static const int largest_power = 308;
+        static const uint64_t values[2 * (largest_power - smallest_power + 1)];
+    };
+
+    template <class T>
+    const uint64_t power_of_five_table<T>::values[2 * (largest_power - smallest_power + 1)] = {
+        0xeef453d6923bd65aULL, 0x113faa2906a13b3fULL,
+        0x9558b4661b6565f8ULL, 0x4ac7ca59a424c507ULL,
+        0xbaaee17fa23ebf76ULL, 0x5d79bcf00d2df649ULL,
+        0xe95a99df8ace6f53ULL, 0xf4d82c2c107973dcULL,
+        0x91d8a02bb6c10594ULL, 0x79071b9b8a4be869ULL,
+        0xb64ec836a47146f9ULL, 0x9748e2826cdee284ULL,
+        0xe3e27a444d8d98b7ULL, 0xfd1b1b2308169b25ULL,
+        0x8e6d8c6ab0787f72ULL, 0xfe30f0f5e50e20f7ULL,
+        0xb208ef855c969f4fULL, 0xbdbd2d335e51a935ULL,
+        0xde8b2b66b3bc4723ULL, 0xad2c788035e61382ULL,
+        0x8b16fb203055ac76ULL, 0x4c3bcb5021afcc31ULL,
+        0xaddcb9e83c6b1793ULL, 0xdf4abe242a1bbf3dULL,
+        0xd953e8624b85dd78ULL, 0xd71d6dad34a2af0dULL,
+        0x87d4713d6f33aa6bULL, 0x8672648c40e5ad68ULL,
+        0xa9c98d8ccb009506ULL, 0x680efdaf511f18c2ULL,
+        0xd43bf0effdc0ba48ULL, 0x0212bd1b2566def2ULL,
+        0x84a57695fe98746dULL, 0x014bb630f7604b57ULL,
+        0xa5ced43b7e3e9188ULL, 0x419ea3bd35385e2dULL,
+        0xcf42894a5dce35eaULL, 0x52064cac828675b9ULL,
+        0x818995ce7aa0e1b2ULL, 0x7343efebd1940993ULL,
+        0xa1ebfb4219491a1fULL, 0x1014ebe6c5f90bf8ULL,
+        0xca66fa129f9b60a6ULL, 0xd41a26e077774ef6ULL,
+        0xfd00b897478238d0ULL, 0x8920b098955522b4ULL,
+        0x9e20735e8cb16382ULL, 0x55b46e5f5d5535b0ULL,
+        0xc5a890362fddbc62ULL, 0xeb2189f734aa831dULL,
+        0xf712b443bbd52b7bULL, 0xa5e9ec7501d523e4ULL,
+        0x9a6bb0aa55653b2dULL, 0x47b233c92125366eULL,
+        0xc1069cd4eabe89f8ULL, 0x999ec0bb696e840aULL,
+        0xf148440a256e2c76ULL, 0xc00670ea43ca250dULL,
+        0x96cd2a865764dbcaULL, 0x380406926a5e5728ULL,
+        0xbc807527ed3e12bcULL, 0xc605083704f5ecf2ULL,
+        0xeba09271e88d976bULL, 0xf7864a44c633682eULL,
+        0x93445b8731587ea3ULL, 0x7ab3ee6afbe0211dULL,
+        0xb8157268fdae9e4cULL, 0x5960ea05bad82964ULL,
+        0xe61acf033d1a45dfULL, 0x6fb92487298e33bdULL,
+        0x8fd0c16206306babULL, 0xa5d3b6d479f8e056ULL,
+        0xb3c4f1ba87bc8696ULL, 0x8f48a4899877186cULL,
+        0xe0b62e2929aba83cULL, 0x331acdabfe94de87ULL,
+        0x8c71dcd9ba0b4925ULL, 0x9ff0c08b7f1d0b14ULL,
+        0xaf8e5410288e1b6fULL, 0x07ecf0ae5ee44dd9ULL,
+        0xdb71e91432b1a24aULL, 0xc9e82cd9f69d6150ULL,
+        0x892731ac9faf056eULL, 0xbe311c083a225cd2ULL,
+        0xab70fe17c79ac6caULL, 0x6dbd630a48aaf406ULL,
+        0xd64d3d9db981787dULL, 0x092cbbccdad5b108ULL,
+        0x85f0468293f0eb4eULL, 0x25bbf56008c58ea5ULL,
+        0xa76c582338ed2621ULL, 0xaf2af2b80af6f24eULL,
+        0xd1476e2c07286faaULL, 0x1af5af660db4aee1ULL,
+        0x82cca4db847945caULL, 0x50d98d9fc890ed4dULL,
+        0xa37fce126597973cULL, 0xe50ff107bab528a0ULL,
+        0xcc5fc196fefd7d0cULL, 0x1e53ed49a96272c8ULL,
+        0xff77b1fcbebcdc4fULL, 0x25e8e89c13bb0f7aULL,
+        0x9faacf3df73609b1ULL, 0x77b191618c54e9acULL,
+        0xc795830d75038c1dULL, 0xd59df5b9ef6a2417ULL,
+        0xf97ae3d0d2446f25ULL, 0x4b0573286b44ad1dULL,
+        0x9becce62836ac577ULL, 0x4ee367f9430aec32ULL,
+        0xc2e801fb244576d5ULL, 0x229c41f793cda73fULL,
+        0xf3a20279ed56d48aULL, 0x6b43527578c1110fULL,
+        0x9845418c345644d6ULL, 0x830a13896b78aaa9ULL,
+        0xbe5691ef416bd60cULL, 0x23cc986bc656d553ULL,
+        0xedec366b11c6cb8fULL, 0x2cbfbe86b7ec8aa8ULL,
+        0x94b3a202eb1c3f39ULL, 0x7bf7d71432f3d6a9ULL,
+        0xb9e08a83a5e34f07ULL, 0xdaf5ccd93fb0cc53ULL,
+        0xe858ad248f5c22c9ULL, 0xd1b3400f8f9cff68ULL,
+        0x91376c36d99995beULL, 0x23100809b9c21fa1ULL,
+        0xb58547448ffffb2dULL, 0xabd40a0c2832a78aULL,
+        0xe2e69915b3fff9f9ULL, 0x16c90c8f323f516cULL,
+        0x8dd01fad907ffc3bULL, 0xae3da7d97f6792e3ULL,
+        0xb1442798f49ffb4aULL, 0x99cd11cfdf41779cULL,
+        0xdd95317f31c7fa1dULL, 0x40405643d711d583ULL,
+        0x8a7d3eef7f1cfc52ULL, 0x482835ea666b2572ULL,
+        0xad1c8eab5ee43b66ULL, 0xda3243650005eecfULL,
+        0xd863b256369d4a40ULL, 0x90bed43e40076a82ULL,
+        0x873e4f75e2224e68ULL, 0x5a7744a6e804a291ULL,
+        0xa90de3535aaae202ULL, 0x711515d0a205cb36ULL,
+        0xd3515c2831559a83ULL, 0x0d5a5b44ca873e03ULL,
+        0x8412d9991ed58091ULL, 0xe858790afe9486c2ULL,
+        0xa5178fff668ae0b6ULL, 0x626e974dbe39a872ULL,
+        0xce5d73ff402d98e3ULL, 0xfb0a3d212dc8128fULL,
+        0x80fa687f881c7f8eULL, 0x7ce66634bc9d0b99ULL,
+        0xa139029f6a239f72ULL, 0x1c1fffc1ebc44e80ULL,
+        0xc987434744ac874eULL, 0xa327ffb266b56220ULL,
+        0xfbe9141915d7a922ULL, 0x4bf1ff9f0062baa8ULL,
+        0x9d71ac8fada6c9b5ULL, 0x6f773fc3603db4a9ULL,
+        0xc4ce17b399107c22ULL, 0xcb550fb4384d21d3ULL,
+        0xf6019da07f549b2bULL, 0x7e2a53a146606a48ULL,
+        0x99c102844f94e0fbULL, 0x2eda7444cbfc426dULL,
+        0xc0314325637a1939ULL, 0xfa911155fefb5308ULL,
+        0xf03d93eebc589f88ULL, 0x793555ab7eba27caULL,
+        0x96267c7535b763b5ULL, 0x4bc1558b2f3458deULL,
+        0xbbb01b9283253ca2ULL, 0x9eb1aaedfb016f16ULL,
+        0xea9c227723ee8bcbULL, 0x465e15a979c1cadcULL,
+        0x92a1958a7675175fULL, 0x0bfacd89ec191ec9ULL,
+        0xb749faed14125d36ULL, 0xcef980ec671f667bULL,
+        0xe51c79a85916f484ULL, 0x82b7e12780e7401aULL,
+        0x8f31cc0937ae58d2ULL, 0xd1b2ecb8b0908810ULL,
+        0xb2fe3f0b8599ef07ULL, 0x861fa7e6dcb4aa15ULL,
+        0xdfbdcece67006ac9ULL, 0x67a791e093e1d49aULL,
+        0x8bd6a141006042bdULL, 0xe0c8bb2c5c6d24e0ULL,
+        0xaecc49914078536dULL, 0x58fae9f773886e18ULL,
+        0xda7f5bf590966848ULL, 0xaf39a475506a899eULL,
+        0x888f99797a5e012dULL, 0x6d8406c952429603ULL,
+        0xaab37fd7d8f58178ULL, 0xc8e5087ba6d33b83ULL,
+        0xd5605fcdcf32e1d6ULL, 0xfb1e4a9a90880a64ULL,
+        0x855c3be0a17fcd26ULL, 0x5cf2eea09a55067fULL,
+        0xa6b34ad8c9dfc06fULL, 0xf42faa48c0ea481eULL,
+        0xd0601d8efc57b08bULL, 0xf13b94daf124da26ULL,
+        0x823c12795db6ce57ULL, 0x76c53d08d6b70858ULL,
+        0xa2cb1717b52481edULL, 0x54768c4b0c64ca6eULL,
+        0xcb7ddcdda26da268ULL, 0xa9942f5dcf7dfd09ULL,
+        0xfe5d54150b090b02ULL, 0xd3f93b35435d7c4cULL,
+        0x9efa548d26e5a6e1ULL, 0xc47bc5014a1a6dafULL,
+        0xc6b8e9b0709f109aULL, 0x359ab6419ca1091bULL,
+        0xf867241c8cc6d4c0ULL, 0xc30163d203c94b62ULL,
+        0x9b407691d7fc44f8ULL, 0x79e0de63425dcf1dULL,
+        0xc21094364dfb5636ULL, 0x985915fc12f542e4ULL,
+        0xf294b943e17a2bc4ULL, 0x3e6f5b7b17b2939dULL,
+        0x979cf3ca6cec5b5aULL, 0xa705992ceecf9c42ULL,
+        0xbd8430bd08277231ULL, 0x50c6ff782a838353ULL,
+        0xece53cec4a314ebdULL, 0xa4f8bf5635246428ULL,
+        0x940f4613ae5ed136ULL, 0x871b7795e136be99ULL,
+        0xb913179899f68584ULL, 0x28e2557b59846e3fULL,
+        0xe757dd7ec07426e5ULL, 0x331aeada2fe589cfULL,
+        0x9096ea6f3848984fULL, 0x3ff0d2c85def7621ULL,
+        0xb4bca50b065abe63ULL, 0x0fed077a756b53a9ULL,
+        0xe1ebce4dc7f16dfbULL, 0xd3e8495912c62894ULL,
+        0x8d3360f09cf6e4bdULL, 0x64712dd7abbbd95cULL,
+        0xb080392cc4349decULL, 0xbd8d794d96aacfb3ULL,
+        0xdca04777f541c567ULL, 0xecf0d7a0fc5583a0ULL,
+        0x89e42caaf9491b60ULL, 0xf41686c49db57244ULL,
+        0xac5d37d5b79b6239ULL, 0x311c2875c522ced5ULL,
+        0xd77485cb25823ac7ULL, 0x7d633293366b828bULL,
+        0x86a8d39ef77164bcULL, 0xae5dff9c02033197ULL,
+        0xa8530886b54dbdebULL, 0xd9f57f830283fdfcULL,
+        0xd267caa862a12d66ULL, 0xd072df63c324fd7bULL,
+        0x8380dea93da4bc60ULL, 0x4247cb9e59f71e6dULL,
+        0xa46116538d0deb78ULL, 0x52d9be85f074e608ULL,
+        0xcd795be870516656ULL, 0x67902e276c921f8bULL,
+        0x806bd9714632dff6ULL, 0x00ba1cd8a3db53b6ULL,
+        0xa086cfcd97bf97f3ULL, 0x80e8a40eccd228a4ULL,
+        0xc8a883c0fdaf7df0ULL, 0x6122cd128006b2cdULL,
+        0xfad2a4b13d1b5d6cULL, 0x796b805720085f81ULL,
+        0x9cc3a6eec6311a63ULL, 0xcbe3303674053bb0ULL,
+        0xc3f490aa77bd60fcULL, 0xbedbfc4411068a9cULL,
+        0xf4f1b4d515acb93bULL, 0xee92fb5515482d44ULL,
+        0x991711052d8bf3c5ULL, 0x751bdd152d4d1c4aULL,
+        0xbf5cd54678eef0b6ULL, 0xd262d45a78a0635dULL,
+        0xef340a98172aace4ULL, 0x86fb897116c87c34ULL,
+        0x9580869f0e7aac0eULL, 0xd45d35e6ae3d4da0ULL,
+        0xbae0a846d2195712ULL, 0x8974836059cca109ULL,
+        0xe998d258869facd7ULL, 0x2bd1a438703fc94bULL,
+        0x91ff83775423cc06ULL, 0x7b6306a34627ddcfULL,
+        0xb67f6455292cbf08ULL, 0x1a3bc84c17b1d542ULL,
+        0xe41f3d6a7377eecaULL, 0x20caba5f1d9e4a93ULL,
+        0x8e938662882af53eULL, 0x547eb47b7282ee9cULL,
+        0xb23867fb2a35b28dULL, 0xe99e619a4f23aa43ULL,
+        0xdec681f9f4c31f31ULL, 0x6405fa00e2ec94d4ULL,
+        0x8b3c113c38f9f37eULL, 0xde83bc408dd3dd04ULL,
+        0xae0b158b4738705eULL, 0x9624ab50b148d445ULL,
+        0xd98ddaee19068c76ULL, 0x3badd624dd9b0957ULL,
+        0x87f8a8d4cfa417c9ULL, 0xe54ca5d70a80e5d6ULL,
+        0xa9f6d30a038d1dbcULL, 0x5e9fcf4ccd211f4cULL,
+        0xd47487cc8470652bULL, 0x7647c3200069671fULL,
+        0x84c8d4dfd2c63f3bULL, 0x29ecd9f40041e073ULL,
+        0xa5fb0a17c777cf09ULL, 0xf468107100525890ULL,
+        0xcf79cc9db955c2ccULL, 0x7182148d4066eeb4ULL,
+        0x81ac1fe293d599bfULL, 0xc6f14cd848405530ULL,
+        0xa21727db38cb002fULL, 0xb8ada00e5a506a7cULL,
+        0xca9cf1d206fdc03bULL, 0xa6d90811f0e4851cULL,
+        0xfd442e4688bd304aULL, 0x908f4a166d1da663ULL,
+        0x9e4a9cec15763e2eULL, 0x9a598e4e043287feULL,
+        0xc5dd44271ad3cdbaULL, 0x40eff1e1853f29fdULL,
+        0xf7549530e188c128ULL, 0xd12bee59e68ef47cULL,
+        0x9a94dd3e8cf578b9ULL, 0x82bb74f8301958ceULL,
+        0xc13a148e3032d6e7ULL, 0xe36a52363c1faf01ULL,
+        0xf18899b1bc3f8ca1ULL, 0xdc44e6c3cb279ac1ULL,
+        0x96f5600f15a7b7e5ULL, 0x29ab103a5ef8c0b9ULL,
+        0xbcb2b812db11a5deULL, 0x7415d448f6b6f0e7ULL,
+        0xebdf661791d60f56ULL, 0x111b495b3464ad21ULL,
+        0x936b9fcebb25c995ULL, 0xcab10dd900beec34ULL,
+        0xb84687c269ef3bfbULL, 0x3d5d514f40eea742ULL,
+        0xe65829b3046b0afaULL, 0x0cb4a5a3112a5112ULL,
+        0x8ff71a0fe2c2e6dcULL, 0x47f0e785eaba72abULL,
+        0xb3f4e093db73a093ULL, 0x59ed216765690f56ULL,
+        0xe0f218b8d25088b8ULL, 0x306869c13ec3532cULL,
+        0x8c974f7383725573ULL, 0x1e414218c73a13fbULL,
+        0xafbd2350644eeacfULL, 0xe5d1929ef90898faULL,
+        0xdbac6c247d62a583ULL, 0xdf45f746b74abf39ULL,
+        0x894bc396ce5da772ULL, 0x6b8bba8c328eb783ULL,
+        0xab9eb47c81f5114fULL, 0x066ea92f3f326564ULL,
+        0xd686619ba27255a2ULL, 0xc80a537b0efefebdULL,
+        0x8613fd0145877585ULL, 0xbd06742ce95f5f36ULL,
+        0xa798fc4196e952e7ULL, 0x2c48113823b73704ULL,
+        0xd17f3b51fca3a7a0ULL, 0xf75a15862ca504c5ULL,
+        0x82ef85133de648c4ULL, 0x9a984d73dbe722fbULL,
+        0xa3ab66580d5fdaf5ULL, 0xc13e60d0d2e0ebbaULL,
+        0xcc963fee10b7d1b3ULL, 0x318df905079926a8ULL,
+        0xffbbcfe994e5c61fULL, 0xfdf17746497f7052ULL,
+        0x9fd561f1fd0f9bd3ULL, 0xfeb6ea8bedefa633ULL,
+        0xc7caba6e7c5382c8ULL, 0xfe64a52ee96b8fc0ULL,
+        0xf9bd690a1b68637bULL, 0x3dfdce7aa3c673b0ULL,
+        0x9c1661a651213e2dULL, 0x06bea10ca65c084eULL,
+        0xc31bfa0fe5698db8ULL, 0x486e494fcff30a62ULL,
+        0xf3e2f893dec3f126ULL, 0x5a89dba3c3efccfaULL,
+        0x986ddb5c6b3a76b7ULL, 0xf89629465a75e01cULL,
+        0xbe89523386091465ULL, 0xf6bbb397f1135823ULL,
+        0xee2ba6c0678b597fULL, 0x746aa07ded582e2cULL,
+        0x94db483840b717efULL, 0xa8c2a44eb4571cdcULL,
+        0xba121a4650e4ddebULL, 0x92f34d62616ce413ULL,
+        0xe896a0d7e51e1566ULL, 0x77b020baf9c81d17ULL,
+        0x915e2486ef32cd60ULL, 0x0ace1474dc1d122eULL,
+        0xb5b5ada8aaff80b8ULL, 0x0d819992132456baULL,
+        0xe3231912d5bf60e6ULL, 0x10e1fff697ed6c69ULL,
+        0x8df5efabc5979c8fULL, 0xca8d3ffa1ef463c1ULL,
+        0xb1736b96b6fd83b3ULL, 0xbd308ff8a6b17cb2ULL,
+        0xddd0467c64bce4a0ULL, 0xac7cb3f6d05ddbdeULL,
+        0x8aa22c0dbef60ee4ULL, 0x6bcdf07a423aa96bULL,
+        0xad4ab7112eb3929dULL, 0x86c16c98d2c953c6ULL,
+        0xd89d64d57a607744ULL, 0xe871c7bf077ba8b7ULL,
+        0x87625f056c7c4a8bULL, 0x11471cd764ad4972ULL,
+        0xa93af6c6c79b5d2dULL, 0xd598e40d3dd89bcfULL,
+        0xd389b47879823479ULL, 0x4aff1d108d4ec2c3ULL,
+        0x843610cb4bf160cbULL, 0xcedf722a585139baULL,
+        0xa54394fe1eedb8feULL, 0xc2974eb4ee658828ULL,
+        0xce947a3da6a9273eULL, 0x733d226229feea32ULL,
+        0x811ccc668829b887ULL, 0x0806357d5a3f525fULL,
+        0xa163ff802a3426a8ULL, 0xca07c2dcb0cf26f7ULL,
+        0xc9bcff6034c13052ULL, 0xfc89b393dd02f0b5ULL,
+        0xfc2c3f3841f17c67ULL, 0xbbac2078d443ace2ULL,
+        0x9d9ba7832936edc0ULL, 0xd54b944b84aa4c0dULL,
+        0xc5029163f384a931ULL, 0x0a9e795e65d4df11ULL,
+        0xf64335bcf065d37dULL, 0x4d4617b5ff4a16d5ULL,
+        0x99ea0196163fa42eULL, 0x504bced1bf8e4e45ULL,
+        0xc06481fb9bcf8d39ULL, 0xe45ec2862f71e1d6ULL,
+        0xf07da27a82c37088ULL, 0x5d767327bb4e5a4cULL,
+        0x964e858c91ba2655ULL, 0x3a6a07f8d510f86fULL,
+        0xbbe226efb628afeaULL, 0x890489f70a55368bULL,
+        0xeadab0aba3b2dbe5ULL, 0x2b45ac74ccea842eULL,
+        0x92c8ae6b464fc96fULL, 0x3b0b8bc90012929dULL,
+        0xb77ada0617e3bbcbULL, 0x09ce6ebb40173744ULL,
+        0xe55990879ddcaabdULL, 0xcc420a6a101d0515ULL,
+        0x8f57fa54c2a9eab6ULL, 0x9fa946824a12232dULL,
+        0xb32df8e9f3546564ULL, 0x47939822dc96abf9ULL,
+        0xdff9772470297ebdULL, 0x59787e2b93bc56f7ULL,
+        0x8bfbea76c619ef36ULL, 0x57eb4edb3c55b65aULL,
+        0xaefae51477a06b03ULL, 0xede622920b6b23f1ULL,
+        0xdab99e59958885c4ULL, 0xe95fab368e45ecedULL,
+        0x88b402f7fd75539bULL, 0x11dbcb0218ebb414ULL,
+        0xaae103b5fcd2a881ULL, 0xd652bdc29f26a119ULL,
+        0xd59944a37c0752a2ULL, 0x4be76d3346f0495fULL,
+        0x857fcae62d8493a5ULL, 0x6f70a4400c562ddbULL,
+        0xa6dfbd9fb8e5b88eULL, 0xcb4ccd500f6bb952ULL,
+        0xd097ad07a71f26b2ULL, 0x7e2000a41346a7a7ULL,
+        0x825ecc24c873782fULL, 0x8ed400668c0c28c8ULL,
+        0xa2f67f2dfa90563bULL, 0x728900802f0f32faULL,
+        0xcbb41ef979346bcaULL, 0x4f2b40a03ad2ffb9ULL,
+        0xfea126b7d78186bcULL, 0xe2f610c84987bfa8ULL,
+        0x9f24b832e6b0f436ULL, 0x0dd9ca7d2df4d7c9ULL,
+        0xc6ede63fa05d3143ULL, 0x91503d1c79720dbbULL,
+        0xf8a95fcf88747d94ULL, 0x75a44c6397ce912aULL,
+        0x9b69dbe1b548ce7cULL, 0xc986afbe3ee11abaULL,
+        0xc24452da229b021bULL, 0xfbe85badce996168ULL,
+        0xf2d56790ab41c2a2ULL, 0xfae27299423fb9c3ULL,
+        0x97c560ba6b0919a5ULL, 0xdccd879fc967d41aULL,
+        0xbdb6b8e905cb600fULL, 0x5400e987bbc1c920ULL,
+        0xed246723473e3813ULL, 0x290123e9aab23b68ULL,
+        0x9436c0760c86e30bULL, 0xf9a0b6720aaf6521ULL,
+        0xb94470938fa89bceULL, 0xf808e40e8d5b3e69ULL,
+        0xe7958cb87392c2c2ULL, 0xb60b1d1230b20e04ULL,
+        0x90bd77f3483bb9b9ULL, 0xb1c6f22b5e6f48c2ULL,
+        0xb4ecd5f01a4aa828ULL, 0x1e38aeb6360b1af3ULL,
+        0xe2280b6c20dd5232ULL, 0x25c6da63c38de1b0ULL,
+        0x8d590723948a535fULL, 0x579c487e5a38ad0eULL,
+        0xb0af48ec79ace837ULL, 0x2d835a9df0c6d851ULL,
+        0xdcdb1b2798182244ULL, 0xf8e431456cf88e65ULL,
+        0x8a08f0f8bf0f156bULL, 0x1b8e9ecb641b58ffULL,
+        0xac8b2d36eed2dac5ULL, 0xe272467e3d222f3fULL,
+        0xd7adf884aa879177ULL, 0x5b0ed81dcc6abb0fULL,
+        0x86ccbb52ea94baeaULL, 0x98e947129fc2b4e9ULL,
+        0xa87fea27a539e9a5ULL, 0x3f2398d747b36224ULL,
+        0xd29fe4b18e88640eULL, 0x8eec7f0d19a03aadULL,
+        0x83a3eeeef9153e89ULL, 0x1953cf68300424acULL,
+        0xa48ceaaab75a8e2bULL, 0x5fa8c3423c052dd7ULL,
+        0xcdb02555653131b6ULL, 0x3792f412cb06794dULL,
+        0x808e17555f3ebf11ULL, 0xe2bbd88bbee40bd0ULL,
+        0xa0b19d2ab70e6ed6ULL, 0x5b6aceaeae9d0ec4ULL,
+        0xc8de047564d20a8bULL, 0xf245825a5a445275ULL,
+        0xfb158592be068d2eULL, 0xeed6e2f0f0d56712ULL,
+        0x9ced737bb6c4183dULL, 0x55464dd69685606bULL,
+        0xc428d05aa4751e4cULL, 0xaa97e14c3c26b886ULL,
+        0xf53304714d9265dfULL, 0xd53dd99f4b3066a8ULL,
+        0x993fe2c6d07b7fabULL, 0xe546a8038efe4029ULL,
+        0xbf8fdb78849a5f96ULL, 0xde98520472bdd033ULL,
+        0xef73d256a5c0f77cULL, 0x963e66858f6d4440ULL,
+        0x95a8637627989aadULL, 0xdde7001379a44aa8ULL,
+        0xbb127c53b17ec159ULL, 0x5560c018580d5d52ULL,
+        0xe9d71b689dde71afULL, 0xaab8f01e6e10b4a6ULL,
+        0x9226712162ab070dULL, 0xcab3961304ca70e8ULL,
+        0xb6b00d69bb55c8d1ULL, 0x3d607b97c5fd0d22ULL,
+        0xe45c10c42a2b3b05ULL, 0x8cb89a7db77c506aULL,
+        0x8eb98a7a9a5b04e3ULL, 0x77f3608e92adb242ULL,
+        0xb267ed1940f1c61cULL, 0x55f038b237591ed3ULL,
+        0xdf01e85f912e37a3ULL, 0x6b6c46dec52f6688ULL,
+        0x8b61313bbabce2c6ULL, 0x2323ac4b3b3da015ULL,
+        0xae397d8aa96c1b77ULL, 0xabec975e0a0d081aULL,
+        0xd9c7dced53c72255ULL, 0x96e7bd358c904a21ULL,
+        0x881cea14545c7575ULL, 0x7e50d64177da2e54ULL,
+        0xaa242499697392d2ULL, 0xdde50bd1d5d0b9e9ULL,
+        0xd4ad2dbfc3d07787ULL, 0x955e4ec64b44e864ULL,
+        0x84ec3c97da624ab4ULL, 0xbd5af13bef0b113eULL,
+        0xa6274bbdd0fadd61ULL, 0xecb1ad8aeacdd58eULL,
+        0xcfb11ead453994baULL, 0x67de18eda5814af2ULL,
+        0x81ceb32c4b43fcf4ULL, 0x80eacf948770ced7ULL,
+        0xa2425ff75e14fc31ULL, 0xa1258379a94d028dULL,
+        0xcad2f7f5359a3b3eULL, 0x096ee45813a04330ULL,
+        0xfd87b5f28300ca0dULL, 0x8bca9d6e188853fcULL,
+        0x9e74d1b791e07e48ULL, 0x775ea264cf55347eULL,
+        0xc612062576589ddaULL, 0x95364afe032a819eULL,
+        0xf79687aed3eec551ULL, 0x3a83ddbd83f52205ULL,
+        0x9abe14cd44753b52ULL, 0xc4926a9672793543ULL,
+        0xc16d9a0095928a27ULL, 0x75b7053c0f178294ULL,
+        0xf1c90080baf72cb1ULL, 0x5324c68b12dd6339ULL,
+        0x971da05074da7beeULL, 0xd3f6fc16ebca5e04ULL,
+        0xbce5086492111aeaULL, 0x88f4bb1ca6bcf585ULL,
+        0xec1e4a7db69561a5ULL, 0x2b31e9e3d06c32e6ULL,
+        0x9392ee8e921d5d07ULL, 0x3aff322e62439fd0ULL,
+        0xb877aa3236a4b449ULL, 0x09befeb9fad487c3ULL,
+        0xe69594bec44de15bULL, 0x4c2ebe687989a9b4ULL,
+        0x901d7cf73ab0acd9ULL, 0x0f9d37014bf60a11ULL,
+        0xb424dc35095cd80fULL, 0x538484c19ef38c95ULL,
+        0xe12e13424bb40e13ULL, 0x2865a5f206b06fbaULL,
+        0x8cbccc096f5088cbULL, 0xf93f87b7442e45d4ULL,
+        0xafebff0bcb24aafeULL, 0xf78f69a51539d749ULL,
+        0xdbe6fecebdedd5beULL, 0xb573440e5a884d1cULL,
+        0x89705f4136b4a597ULL, 0x31680a88f8953031ULL,
+        0xabcc77118461cefcULL, 0xfdc20d2b36ba7c3eULL,
+        0xd6bf94d5e57a42bcULL, 0x3d32907604691b4dULL,
+        0x8637bd05af6c69b5ULL, 0xa63f9a49c2c1b110ULL,
+        0xa7c5ac471b478423ULL, 0x0fcf80dc33721d54ULL,
+        0xd1b71758e219652bULL, 0xd3c36113404ea4a9ULL,
+        0x83126e978d4fdf3bULL, 0x645a1cac083126eaULL,
+        0xa3d70a3d70a3d70aULL, 0x3d70a3d70a3d70a4ULL,
+        0xccccccccccccccccULL, 0xcccccccccccccccdULL,
+        0x8000000000000000ULL, 0x0000000000000000ULL,
+        0xa000000000000000ULL, 0x0000000000000000ULL,
+        0xc800000000000000ULL, 0x0000000000000000ULL,
+        0xfa00000000000000ULL, 0x0000000000000000ULL,
+        0x9c40000000000000ULL, 0x0000000000000000ULL,
+        0xc350000000000000ULL, 0x0000000000000000ULL,
+        0xf424000000000000ULL, 0x0000000000000000ULL,
+        0x9896800000000000ULL, 0x0000000000000000ULL,
+        0xbebc200000000000ULL, 0x0000000000000000ULL,
+        0xee6b280000000000ULL, 0x0000000000000000ULL,
+        0x9502f90000000000ULL, 0x0000000000000000ULL,
+        0xba43b74000000000ULL, 0x0000000000000000ULL,
+        0xe8d4a51000000000ULL, 0x0000000000000000ULL,
+        0x9184e72a00000000ULL, 0x0000000000000000ULL,
+        0xb5e620f480000000ULL, 0x0000000000000000ULL,
+        0xe35fa931a0000000ULL, 0x0000000000000000ULL,
+        0x8e1bc9bf04000000ULL, 0x0000000000000000ULL,
+        0xb1a2bc2ec5000000ULL, 0x0000000000000000ULL,
+        0xde0b6b3a76400000ULL, 0x0000000000000000ULL,
+        0x8ac7230489e80000ULL, 0x0000000000000000ULL,
+        0xad78ebc5ac620000ULL, 0x0000000000000000ULL,
+        0xd8d726b7177a8000ULL, 0x0000000000000000ULL,
+        0x878678326eac9000ULL, 0x0000000000000000ULL,
+        0xa968163f0a57b400ULL, 0x0000000000000000ULL,
+        0xd3c21bcecceda100ULL, 0x0000000000000000ULL,
+        0x84595161401484a0ULL, 0x0000000000000000ULL,
+        0xa56fa5b99019a5c8ULL, 0x0000000000000000ULL,
+        0xcecb8f27f4200f3aULL, 0x0000000000000000ULL,
+        0x813f3978f8940984ULL, 0x4000000000000000ULL,
+        0xa18f07d736b90be5ULL, 0x5000000000000000ULL,
+        0xc9f2c9cd04674edeULL, 0xa400000000000000ULL,
+        0xfc6f7c4045812296ULL, 0x4d00000000000000ULL,
+        0x9dc5ada82b70b59dULL, 0xf020000000000000ULL,
+        0xc5371912364ce305ULL, 0x6c28000000000000ULL,
+        0xf684df56c3e01bc6ULL, 0xc732000000000000ULL,
+        0x9a130b963a6c115cULL, 0x3c7f400000000000ULL,
+        0xc097ce7bc90715b3ULL, 0x4b9f100000000000ULL,
+        0xf0bdc21abb48db20ULL, 0x1e86d40000000000ULL,
+        0x96769950b50d88f4ULL, 0x1314448000000000ULL,
+        0xbc143fa4e250eb31ULL, 0x17d955a000000000ULL,
+        0xeb194f8e1ae525fdULL, 0x5dcfab0800000000ULL,
+        0x92efd1b8d0cf37beULL, 0x5aa1cae500000000ULL,
+        0xb7abc627050305adULL, 0xf14a3d9e40000000ULL,
+        0xe596b7b0c643c719ULL, 0x6d9ccd05d0000000ULL,
+        0x8f7e32ce7bea5c6fULL, 0xe4820023a2000000ULL,
+        0xb35dbf821ae4f38bULL, 0xdda2802c8a800000ULL,
+        0xe0352f62a19e306eULL, 0xd50b2037ad200000ULL,
+        0x8c213d9da502de45ULL, 0x4526f422cc340000ULL,
+        0xaf298d050e4395d6ULL, 0x9670b12b7f410000ULL,
+        0xdaf3f04651d47b4cULL, 0x3c0cdd765f114000ULL,
+        0x88d8762bf324cd0fULL, 0xa5880a69fb6ac800ULL,
+        0xab0e93b6efee0053ULL, 0x8eea0d047a457a00ULL,
+        0xd5d238a4abe98068ULL, 0x72a4904598d6d880ULL,
+        0x85a36366eb71f041ULL, 0x47a6da2b7f864750ULL,
+        0xa70c3c40a64e6c51ULL, 0x999090b65f67d924ULL,
+        0xd0cf4b50cfe20765ULL, 0xfff4b4e3f741cf6dULL,
+        0x82818f1281ed449fULL, 0xbff8f10e7a8921a4ULL,
+        0xa321f2d7226895c7ULL, 0xaff72d52192b6a0dULL,
+        0xcbea6f8ceb02bb39ULL, 0x9bf4f8a69f764490ULL,
+        0xfee50b7025c36a08ULL, 0x02f236d04753d5b4ULL,
+        0x9f4f2726179a2245ULL, 0x01d762422c946590ULL,
+        0xc722f0ef9d80aad6ULL, 0x424d3ad2b7b97ef5ULL,
+        0xf8ebad2b84e0d58bULL, 0xd2e0898765a7deb2ULL,
+        0x9b934c3b330c8577ULL, 0x63cc55f49f88eb2fULL,
+        0xc2781f49ffcfa6d5ULL, 0x3cbf6b71c76b25fbULL,
+        0xf316271c7fc3908aULL, 0x8bef464e3945ef7aULL,
+        0x97edd871cfda3a56ULL, 0x97758bf0e3cbb5acULL,
+        0xbde94e8e43d0c8ecULL, 0x3d52eeed1cbea317ULL,
+        0xed63a231d4c4fb27ULL, 0x4ca7aaa863ee4bddULL,
+        0x945e455f24fb1cf8ULL, 0x8fe8caa93e74ef6aULL,
+        0xb975d6b6ee39e436ULL, 0xb3e2fd538e122b44ULL,
+        0xe7d34c64a9c85d44ULL, 0x60dbbca87196b616ULL,
+        0x90e40fbeea1d3a4aULL, 0xbc8955e946fe31cdULL,
+        0xb51d13aea4a488ddULL, 0x6babab6398bdbe41ULL,
+        0xe264589a4dcdab14ULL, 0xc696963c7eed2dd1ULL,
+        0x8d7eb76070a08aecULL, 0xfc1e1de5cf543ca2ULL,
+        0xb0de65388cc8ada8ULL, 0x3b25a55f43294bcbULL,
+        0xdd15fe86affad912ULL, 0x49ef0eb713f39ebeULL,
+        0x8a2dbf142dfcc7abULL, 0x6e3569326c784337ULL,
+        0xacb92ed9397bf996ULL, 0x49c2c37f07965404ULL,
+        0xd7e77a8f87daf7fbULL, 0xdc33745ec97be906ULL,
+        0x86f0ac99b4e8dafdULL, 0x69a028bb3ded71a3ULL,
+        0xa8acd7c0222311bcULL, 0xc40832ea0d68ce0cULL,
+        0xd2d80db02aabd62bULL, 0xf50a3fa490c30190ULL,
+        0x83c7088e1aab65dbULL, 0x792667c6da79e0faULL,
+        0xa4b8cab1a1563f52ULL, 0x577001b891185938ULL,
+        0xcde6fd5e09abcf26ULL, 0xed4c0226b55e6f86ULL,
+        0x80b05e5ac60b6178ULL, 0x544f8158315b05b4ULL,
+        0xa0dc75f1778e39d6ULL, 0x696361ae3db1c721ULL,
+        0xc913936dd571c84cULL, 0x03bc3a19cd1e38e9ULL,
+        0xfb5878494ace3a5fULL, 0x04ab48a04065c723ULL,
+        0x9d174b2dcec0e47bULL, 0x62eb0d64283f9c76ULL,
+        0xc45d1df942711d9aULL, 0x3ba5d0bd324f8394ULL,
+        0xf5746577930d6500ULL, 0xca8f44ec7ee36479ULL,
+        0x9968bf6abbe85f20ULL, 0x7e998b13cf4e1ecbULL,
+        0xbfc2ef456ae276e8ULL, 0x9e3fedd8c321a67eULL,
+        0xefb3ab16c59b14a2ULL, 0xc5cfe94ef3ea101eULL,
+        0x95d04aee3b80ece5ULL, 0xbba1f1d158724a12ULL,
+        0xbb445da9ca61281fULL, 0x2a8a6e45ae8edc97ULL,
+        0xea1575143cf97226ULL, 0xf52d09d71a3293bdULL,
+        0x924d692ca61be758ULL, 0x593c2626705f9c56ULL,
+        0xb6e0c377cfa2e12eULL, 0x6f8b2fb00c77836cULL,
+        0xe498f455c38b997aULL, 0x0b6dfb9c0f956447ULL,
+        0x8edf98b59a373fecULL, 0x4724bd4189bd5eacULL,
+        0xb2977ee300c50fe7ULL, 0x58edec91ec2cb657ULL,
+        0xdf3d5e9bc0f653e1ULL, 0x2f2967b66737e3edULL,
+        0x8b865b215899f46cULL, 0xbd79e0d20082ee74ULL,
+        0xae67f1e9aec07187ULL, 0xecd8590680a3aa11ULL,
+        0xda01ee641a708de9ULL, 0xe80e6f4820cc9495ULL,
+        0x884134fe908658b2ULL, 0x3109058d147fdcddULL,
+        0xaa51823e34a7eedeULL, 0xbd4b46f0599fd415ULL,
+        0xd4e5e2cdc1d1ea96ULL, 0x6c9e18ac7007c91aULL,
+        0x850fadc09923329eULL, 0x03e2cf6bc604ddb0ULL,
+        0xa6539930bf6bff45ULL, 0x84db8346b786151cULL,
+        0xcfe87f7cef46ff16ULL, 0xe612641865679a63ULL,
+        0x81f14fae158c5f6eULL, 0x4fcb7e8f3f60c07eULL,
+        0xa26da3999aef7749ULL, 0xe3be5e330f38f09dULL,
+        0xcb090c8001ab551cULL, 0x5cadf5bfd3072cc5ULL,
+        0xfdcb4fa002162a63ULL, 0x73d9732fc7c8f7f6ULL,
+        0x9e9f11c4014dda7eULL, 0x2867e7fddcdd9afaULL,
+        0xc646d63501a1511dULL, 0xb281e1fd541501b8ULL,
+        0xf7d88bc24209a565ULL, 0x1f225a7ca91a4226ULL,
+        0x9ae757596946075fULL, 0x3375788de9b06958ULL,
+        0xc1a12d2fc3978937ULL, 0x0052d6b1641c83aeULL,
+        0xf209787bb47d6b84ULL, 0xc0678c5dbd23a49aULL,
+        0x9745eb4d50ce6332ULL, 0xf840b7ba963646e0ULL,
+        0xbd176620a501fbffULL, 0xb650e5a93bc3d898ULL,
+        0xec5d3fa8ce427affULL, 0xa3e51f138ab4cebeULL,
+        0x93ba47c980e98cdfULL, 0xc66f336c36b10137ULL,
+        0xb8a8d9bbe123f017ULL, 0xb80b0047445d4184ULL,
+        0xe6d3102ad96cec1dULL, 0xa60dc059157491e5ULL,
+        0x9043ea1ac7e41392ULL, 0x87c89837ad68db2fULL,
+        0xb454e4a179dd1877ULL, 0x29babe4598c311fbULL,
+        0xe16a1dc9d8545e94ULL, 0xf4296dd6fef3d67aULL,
+        0x8ce2529e2734bb1dULL, 0x1899e4a65f58660cULL,
+        0xb01ae745b101e9e4ULL, 0x5ec05dcff72e7f8fULL,
+        0xdc21a1171d42645dULL, 0x76707543f4fa1f73ULL,
+        0x899504ae72497ebaULL, 0x6a06494a791c53a8ULL,
+        0xabfa45da0edbde69ULL, 0x0487db9d17636892ULL,
+        0xd6f8d7509292d603ULL, 0x45a9d2845d3c42b6ULL,
+        0x865b86925b9bc5c2ULL, 0x0b8a2392ba45a9b2ULL,
+        0xa7f26836f282b732ULL, 0x8e6cac7768d7141eULL,
+        0xd1ef0244af2364ffULL, 0x3207d795430cd926ULL,
+        0x8335616aed761f1fULL, 0x7f44e6bd49e807b8ULL,
+        0xa402b9c5a8d3a6e7ULL, 0x5f16206c9c6209a6ULL,
+        0xcd036837130890a1ULL, 0x36dba887c37a8c0fULL,
+        0x802221226be55a64ULL, 0xc2494954da2c9789ULL,
+        0xa02aa96b06deb0fdULL, 0xf2db9baa10b7bd6cULL,
+        0xc83553c5c8965d3dULL, 0x6f92829494e5acc7ULL,
+        0xfa42a8b73abbf48cULL, 0xcb772339ba1f17f9ULL,
+        0x9c69a97284b578d7ULL, 0xff2a760414536efbULL,
+        0xc38413cf25e2d70dULL, 0xfef5138519684abaULL,
+        0xf46518c2ef5b8cd1ULL, 0x7eb258665fc25d69ULL,
+        0x98bf2f79d5993802ULL, 0xef2f773ffbd97a61ULL,
+        0xbeeefb584aff8603ULL, 0xaafb550ffacfd8faULL,
+        0xeeaaba2e5dbf6784ULL, 0x95ba2a53f983cf38ULL,
+        0x952ab45cfa97a0b2ULL, 0xdd945a747bf26183ULL,
+        0xba756174393d88dfULL, 0x94f971119aeef9e4ULL,
+        0xe912b9d1478ceb17ULL, 0x7a37cd5601aab85dULL,
+        0x91abb422ccb812eeULL, 0xac62e055c10ab33aULL,
+        0xb616a12b7fe617aaULL, 0x577b986b314d6009ULL,
+        0xe39c49765fdf9d94ULL, 0xed5a7e85fda0b80bULL,
+        0x8e41ade9fbebc27dULL, 0x14588f13be847307ULL,
+        0xb1d219647ae6b31cULL, 0x596eb2d8ae258fc8ULL,
+        0xde469fbd99a05fe3ULL, 0x6fca5f8ed9aef3bbULL,
+        0x8aec23d680043beeULL, 0x25de7bb9480d5854ULL,
+        0xada72ccc20054ae9ULL, 0xaf561aa79a10ae6aULL,
+        0xd910f7ff28069da4ULL, 0x1b2ba1518094da04ULL,
+        0x87aa9aff79042286ULL, 0x90fb44d2f05d0842ULL,
+        0xa99541bf57452b28ULL, 0x353a1607ac744a53ULL,
+        0xd3fa922f2d1675f2ULL, 0x42889b8997915ce8ULL,
+        0x847c9b5d7c2e09b7ULL, 0x69956135febada11ULL,
+        0xa59bc234db398c25ULL, 0x43fab9837e699095ULL,
+        0xcf02b2c21207ef2eULL, 0x94f967e45e03f4bbULL,
+        0x8161afb94b44f57dULL, 0x1d1be0eebac278f5ULL,
+        0xa1ba1ba79e1632dcULL, 0x6462d92a69731732ULL,
+        0xca28a291859bbf93ULL, 0x7d7b8f7503cfdcfeULL,
+        0xfcb2cb35e702af78ULL, 0x5cda735244c3d43eULL,
+        0x9defbf01b061adabULL, 0x3a0888136afa64a7ULL,
+        0xc56baec21c7a1916ULL, 0x088aaa1845b8fdd0ULL,
+        0xf6c69a72a3989f5bULL, 0x8aad549e57273d45ULL,
+        0x9a3c2087a63f6399ULL, 0x36ac54e2f678864bULL,
+        0xc0cb28a98fcf3c7fULL, 0x84576a1bb416a7ddULL,
+        0xf0fdf2d3f3c30b9fULL, 0x656d44a2a11c51d5ULL,
+        0x969eb7c47859e743ULL, 0x9f644ae5a4b1b325ULL,
+        0xbc4665b596706114ULL, 0x873d5d9f0dde1feeULL,
+        0xeb57ff22fc0c7959ULL, 0xa90cb506d155a7eaULL,
+        0x9316ff75dd87cbd8ULL, 0x09a7f12442d588f2ULL,
+        0xb7dcbf5354e9beceULL, 0x0c11ed6d538aeb2fULL,
+        0xe5d3ef282a242e81ULL, 0x8f1668c8a86da5faULL,
+        0x8fa475791a569d10ULL, 0xf96e017d694487bcULL,
+        0xb38d92d760ec4455ULL, 0x37c981dcc395a9acULL,
+        0xe070f78d3927556aULL, 0x85bbe253f47b1417ULL,
+        0x8c469ab843b89562ULL, 0x93956d7478ccec8eULL,
+        0xaf58416654a6babbULL, 0x387ac8d1970027b2ULL,
+        0xdb2e51bfe9d0696aULL, 0x06997b05fcc0319eULL,
+        0x88fcf317f22241e2ULL, 0x441fece3bdf81f03ULL,
+        0xab3c2fddeeaad25aULL, 0xd527e81cad7626c3ULL,
+        0xd60b3bd56a5586f1ULL, 0x8a71e223d8d3b074ULL,
+        0x85c7056562757456ULL, 0xf6872d5667844e49ULL,
+        0xa738c6bebb12d16cULL, 0xb428f8ac016561dbULL,
+        0xd106f86e69d785c7ULL, 0xe13336d701beba52ULL,
+        0x82a45b450226b39cULL, 0xecc0024661173473ULL,
+        0xa34d721642b06084ULL, 0x27f002d7f95d0190ULL,
+        0xcc20ce9bd35c78a5ULL, 0x31ec038df7b441f4ULL,
+        0xff290242c83396ceULL, 0x7e67047175a15271ULL,
+        0x9f79a169bd203e41ULL, 0x0f0062c6e984d386ULL,
+        0xc75809c42c684dd1ULL, 0x52c07b78a3e60868ULL,
+        0xf92e0c3537826145ULL, 0xa7709a56ccdf8a82ULL,
+        0x9bbcc7a142b17ccbULL, 0x88a66076400bb691ULL,
+        0xc2abf989935ddbfeULL, 0x6acff893d00ea435ULL,
+        0xf356f7ebf83552feULL, 0x0583f6b8c4124d43ULL,
+        0x98165af37b2153deULL, 0xc3727a337a8b704aULL,
+        0xbe1bf1b059e9a8d6ULL, 0x744f18c0592e4c5cULL,
+        0xeda2ee1c7064130cULL, 0x1162def06f79df73ULL,
+        0x9485d4d1c63e8be7ULL, 0x8addcb5645ac2ba8ULL,
+        0xb9a74a0637ce2ee1ULL, 0x6d953e2bd7173692ULL,
+        0xe8111c87c5c1ba99ULL, 0xc8fa8db6ccdd0437ULL,
+        0x910ab1d4db9914a0ULL, 0x1d9c9892400a22a2ULL,
+        0xb54d5e4a127f59c8ULL, 0x2503beb6d00cab4bULL,
+        0xe2a0b5dc971f303aULL, 0x2e44ae64840fd61dULL,
+        0x8da471a9de737e24ULL, 0x5ceaecfed289e5d2ULL,
+        0xb10d8e1456105dadULL, 0x7425a83e872c5f47ULL,
+        0xdd50f1996b947518ULL, 0xd12f124e28f77719ULL,
+        0x8a5296ffe33cc92fULL, 0x82bd6b70d99aaa6fULL,
+        0xace73cbfdc0bfb7bULL, 0x636cc64d1001550bULL,
+        0xd8210befd30efa5aULL, 0x3c47f7e05401aa4eULL,
+        0x8714a775e3e95c78ULL, 0x65acfaec34810a71ULL,
+        0xa8d9d1535ce3b396ULL, 0x7f1839a741a14d0dULL,
+        0xd31045a8341ca07cULL, 0x1ede48111209a050ULL,
+        0x83ea2b892091e44dULL, 0x934aed0aab460432ULL,
+        0xa4e4b66b68b65d60ULL, 0xf81da84d5617853fULL,
+        0xce1de40642e3f4b9ULL, 0x36251260ab9d668eULL,
+        0x80d2ae83e9ce78f3ULL, 0xc1d72b7c6b426019ULL,
+        0xa1075a24e4421730ULL, 0xb24cf65b8612f81fULL,
+        0xc94930ae1d529cfcULL, 0xdee033f26797b627ULL,
+        0xfb9b7cd9a4a7443cULL, 0x169840ef017da3b1ULL,
+        0x9d412e0806e88aa5ULL, 0x8e1f289560ee864eULL,
+        0xc491798a08a2ad4eULL, 0xf1a6f2bab92a27e2ULL,
+        0xf5b5d7ec8acb58a2ULL, 0xae10af696774b1dbULL,
+        0x9991a6f3d6bf1765ULL, 0xacca6da1e0a8ef29ULL,
+        0xbff610b0cc6edd3fULL, 0x17fd090a58d32af3ULL,
+        0xeff394dcff8a948eULL, 0xddfc4b4cef07f5b0ULL,
+        0x95f83d0a1fb69cd9ULL, 0x4abdaf101564f98eULL,
+        0xbb764c4ca7a4440fULL, 0x9d6d1ad41abe37f1ULL,
+        0xea53df5fd18d5513ULL, 0x84c86189216dc5edULL,
+        0x92746b9be2f8552cULL, 0x32fd3cf5b4e49bb4ULL,
+        0xb7118682dbb66a77ULL, 0x3fbc8c33221dc2a1ULL,
+        0xe4d5e82392a40515ULL, 0x0fabaf3feaa5334aULL,
+        0x8f05b1163ba6832dULL, 0x29cb4d87f2a7400eULL,
+        0xb2c71d5bca9023f8ULL, 0x743e20e9ef511012ULL,
+        0xdf78e4b2bd342cf6ULL, 0x914da9246b255416ULL,
+        0x8bab8eefb6409c1aULL, 0x1ad089b6c2f7548eULL,
+        0xae9672aba3d0c320ULL, 0xa184ac2473b529b1ULL,
+        0xda3c0f568cc4f3e8ULL, 0xc9e5d72d90a2741eULL,
+        0x8865899617fb1871ULL, 0x7e2fa67c7a658892ULL,
+        0xaa7eebfb9df9de8dULL, 0xddbb901b98feeab7ULL,
+        0xd51ea6fa85785631ULL, 0x552a74227f3ea565ULL,
+        0x8533285c936b35deULL, 0xd53a88958f87275fULL,
+        0xa67ff273b8460356ULL, 0x8a892abaf368f137ULL,
+        0xd01fef10a657842cULL, 0x2d2b7569b0432d85ULL,
+        0x8213f56a67f6b29bULL, 0x9c3b29620e29fc73ULL,
+        0xa298f2c501f45f42ULL, 0x8349f3ba91b47b8fULL,
+        0xcb3f2f7642717713ULL, 0x241c70a936219a73ULL,
+        0xfe0efb53d30dd4d7ULL, 0xed238cd383aa0110ULL,
+        0x9ec95d1463e8a506ULL, 0xf4363804324a40aaULL,
+        0xc67bb4597ce2ce48ULL, 0xb143c6053edcd0d5ULL,
+        0xf81aa16fdc1b81daULL, 0xdd94b7868e94050aULL,
+        0x9b10a4e5e9913128ULL, 0xca7cf2b4191c8326ULL,
+        0xc1d4ce1f63f57d72ULL, 0xfd1c2f611f63a3f0ULL,
+        0xf24a01a73cf2dccfULL, 0xbc633b39673c8cecULL,
+        0x976e41088617ca01ULL, 0xd5be0503e085d813ULL,
+        0xbd49d14aa79dbc82ULL, 0x4b2d8644d8a74e18ULL,
+        0xec9c459d51852ba2ULL, 0xddf8e7d60ed1219eULL,
+        0x93e1ab8252f33b45ULL, 0xcabb90e5c942b503ULL,
+        0xb8da1662e7b00a17ULL, 0x3d6a751f3b936243ULL,
+        0xe7109bfba19c0c9dULL, 0x0cc512670a783ad4ULL,
+        0x906a617d450187e2ULL, 0x27fb2b80668b24c5ULL,
+        0xb484f9dc9641e9daULL, 0xb1f9f660802dedf6ULL,
+        0xe1a63853bbd26451ULL, 0x5e7873f8a0396973ULL,
+        0x8d07e33455637eb2ULL, 0xdb0b487b6423e1e8ULL,
+        0xb049dc016abc5e5fULL, 0x91ce1a9a3d2cda62ULL,
+        0xdc5c5301c56b75f7ULL, 0x7641a140cc7810fbULL,
+        0x89b9b3e11b6329baULL, 0xa9e904c87fcb0a9dULL,
+        0xac2820d9623bf429ULL, 0x546345fa9fbdcd44ULL,
+        0xd732290fbacaf133ULL, 0xa97c177947ad4095ULL,
+        0x867f59a9d4bed6c0ULL, 0x49ed8eabcccc485dULL,
+        0xa81f301449ee8c70ULL, 0x5c68f256bfff5a74ULL,
+        0xd226fc195c6a2f8cULL, 0x73832eec6fff3111ULL,
+        0x83585d8fd9c25db7ULL, 0xc831fd53c5ff7eabULL,
+        0xa42e74f3d032f525ULL, 0xba3e7ca8b77f5e55ULL,
+        0xcd3a1230c43fb26fULL, 0x28ce1bd2e55f35ebULL,
+        0x80444b5e7aa7cf85ULL, 0x7980d163cf5b81b3ULL,
+        0xa0555e361951c366ULL, 0xd7e105bcc332621fULL,
+        0xc86ab5c39fa63440ULL, 0x8dd9472bf3fefaa7ULL,
+        0xfa856334878fc150ULL, 0xb14f98f6f0feb951ULL,
+        0x9c935e00d4b9d8d2ULL, 0x6ed1bf9a569f33d3ULL,
+        0xc3b8358109e84f07ULL, 0x0a862f80ec4700c8ULL,
+        0xf4a642e14c6262c8ULL, 0xcd27bb612758c0faULL,
+        0x98e7e9cccfbd7dbdULL, 0x8038d51cb897789cULL,
+        0xbf21e44003acdd2cULL, 0xe0470a63e6bd56c3ULL,
+        0xeeea5d5004981478ULL, 0x1858ccfce06cac74ULL,
+        0x95527a5202df0ccbULL, 0x0f37801e0c43ebc8ULL,
+        0xbaa718e68396cffdULL, 0xd30560258f54e6baULL,
+        0xe950df20247c83fdULL, 0x47c6b82ef32a2069ULL,
+        0x91d28b7416cdd27eULL, 0x4cdc331d57fa5441ULL,
+        0xb6472e511c81471dULL, 0xe0133fe4adf8e952ULL,
+        0xe3d8f9e563a198e5ULL, 0x58180fddd97723a6ULL,
+        0x8e679c2f5e44ff8fULL, 0x570f09eaa7ea7648ULL,
+    };
+
+    // Eisel-Lemire 算法：计算最接近 w * 10^q 的双精度浮点数（w 不为 0）
+    // 结果无法确定时返回 false，由调用者使用慢速路径
+    inline bool eisel_lemire(uint64_t w, int64_t q, bool negative, double &out)
+    {
+        const uint64_t sign = negative ? 0x8000000000000000ULL : 0;
+        uint64_t bits;
+        if (q < power_of_five_table<>::smallest_power)
+        {
+            bits = sign; // 下溢为 0
+        }
+        else if (q > power_of_five_table<>::largest_power)
+        {
+            bits = sign | 0x7FF0000000000000ULL; // 上溢为无穷大
+        }
+        else
+        {
+            int lz = count_leading_zeros(w);
+            w <<= lz;
+
+            // 截断的 w * 5^q，只保留高 128 位；低位可能影响结果时再乘上幂的低 64 位
+            const uint64_t *pow5 = power_of_five_table<>::values + 2 * (q - power_of_five_table<>::smallest_power);
+            uint64_t hi, lo;
+            multiply_64x64(w, pow5[0], hi, lo);
+            if ((hi & 0x1FF) == 0x1FF)
+            {
+                uint64_t hi2, lo2;
+                multiply_64x64(w, pow5[1], hi2, lo2);
+                lo += hi2;
+                if (hi2 > lo)
+                {
+                    ++hi;
+                }
+            }
+            if (lo == 0xFFFFFFFFFFFFFFFFULL && (q < -27 || q > 55))
+            {
+                return false; // 截断误差可能进位到高位，无法判断舍入方向
+            }
+
+            // 取 54 位有效数字（多一位用于舍入），并得到二进制指数
+            uint64_t upperbit = hi >> 63;
+            uint64_t mantissa = hi >> (upperbit + 9);
+            int64_t power2 = (((152170 + 65536) * q) >> 16) + 63 + static_cast<int64_t>(upperbit) - lz + 1023;
+
+            if (power2 <= 0)
+            {
+                // 非规格化数
+                if (-power2 + 1 >= 64)
+                {
+                    out = negative ? -0.0 : 0.0;
+                    return true;
+                }
+                mantissa >>= -power2 + 1;
+                mantissa += mantissa & 1;
+                mantissa >>= 1;
+                power2 = mantissa < (1ULL << 52) ? 0 : 1;
+                bits = sign | (static_cast<uint64_t>(power2) << 52) | (mantissa & ((1ULL << 52) - 1));
+                std::memcpy(&out, &bits, sizeof(out));
+                return true;
+            }
+
+            // 恰好位于两个浮点数中间时向偶数舍入（只可能在 5^q 能放入 64 位时出现）
+            if (lo <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1 &&
+                (mantissa << (upperbit + 9)) == hi)
+            {
+                mantissa &= ~1ULL;
+            }
+
+            mantissa += mantissa & 1; // 舍入
+            mantissa >>= 1;
+            if (mantissa >= (2ULL << 52))
+            {
+                mantissa = 1ULL << 52;
+                ++power2;
+            }
+
+            if (power2 >= 0x7FF)
+            {
+                bits = sign | 0x7FF0000000000000ULL; // 上溢为无穷大
+            }
+            else
+            {
+                bits = sign | (static_cast<uint64_t>(power2) << 52) | (mantissa & ((1ULL << 52) - 1));
+            }
+        }
+
+        std::memcpy(&out, &bits, sizeof(out));
+        return true;
+    }
+
+    // 慢速路径：交给 strtod，并把小数点替换为当前区域设置的小数点，使结果与区域设置无关
+    inline double strtod_locale_independent(const char *begin, const char *end)
+    {
+        char point = *std::localeconv()->decimal_point;
+        char buf[64];
+        std::string heap;
+        char *s = buf;
+        size_t n = static_cast<size_t>(end - begin);
+        if (n >= sizeof(buf))
+        {
+            heap.resize(n + 1); // 只有非常长的数值才需要分配
+            s = &heap[0];
+        }
+
+        for (size_t i = 0; i < n; i++)
+        {
+            s[i] = begin[i] == '.' ? point : begin[i];
+        }
+        s[n] = '\0';
+        return std::strtod(s, nullptr);
+    }
+
+    // 从 [p, end) 扫描一个数值，返回数值之后的位置，格式错误时返回 nullptr
+    // 语法为 -?数字*(.数字*)?([eE][+-]?数字+)?，整数部分和小数部分至少有一位数字；
+    // 与原有的解析行为一致，允许前导零和以小数点开头
+    // 没有小数点和指数的数值解析为整数，超出 long long 范围时改为浮点数
+    // 浮点数按 IEEE 754 正确舍入，不依赖区域设置，也不分配内存
+    inline const char *scan_number(const char *p, const char *end, parsed_number &out)
+    {
+        const char *start = p;
+        bool negative = false;
+        if (p < end && *p == '-')
+        {
+            negative = true;
+            ++p;
+        }
+
+        // 最多保留 19 位有效数字，其余的只影响指数，以及是否发生了截断
+        uint64_t mantissa = 0;
+        int digits = 0;
+        int64_t exp10 = 0;
+        bool truncated = false;
+        bool any_digit = false;
+        bool is_integer = true;
+
+        for (; p < end && *p >= '0' && *p <= '9'; ++p)
+        {
+            any_digit = true;
+            unsigned d = static_cast<unsigned>(*p - '0');
+            if (digits < 19)
+            {
+                mantissa = mantissa * 10 + d;
+                digits += (mantissa != 0); // 前导零不计入有效数字
+            }
+            else
+            {
+                ++exp10;
+                truncated |= (d != 0);
+            }
+        }
+
+        if (p < end && *p == '.')
+        {
+            is_integer = false;
+            for (++p; p < end && *p >= '0' && *p <= '9'; ++p)
+            {
+                any_digit = true;
+                unsigned d = static_cast<unsigned>(*p - '0');
+                if (digits < 19)
+                {
+                    mantissa = mantissa * 10 + d;
+                    digits += (mantissa != 0);
+                    --exp10;
+                }
+                else
+                {
+                    truncated |= (d != 0);
+                }
+            }
+        }
+
+        if (!any_digit)
+        {
+            return nullptr;
+        }
+
+        if (p < end && (*p == 'e' || *p == 'E'))
+        {
+            is_integer = false;
+            ++p;
+            bool exp_negative = false;
+            if (p < end && (*p == '+' || *p == '-'))
+            {
+                exp_negative = *p == '-';
+                ++p;
+            }
+            if (p == end || *p < '0' || *p > '9')
+            {
+                return nullptr;
+            }
+
+            int64_t exp_value = 0;
+            for (; p < end && *p >= '0' && *p <= '9'; ++p)
+            {
+                if (exp_value < 100000) // 足以溢出或下溢，继续增大没有意义
+                {
+                    exp_value = exp_value * 10 + (*p - '0');
+                }
+            }
+            exp10 += exp_negative ? -exp_value : exp_value;
+        }
+
+        // 整数
+        if (is_integer && !truncated && exp10 == 0)
+        {
+            if (!negative && mantissa <= 0x7FFFFFFFFFFFFFFFULL)
+            {
+                out.type = json_t::number_integer;
+                out.integer = static_cast<long long>(mantissa);
+                return p;
+            }
+            if (negative && mantissa <= 0x8000000000000000ULL)
+            {
+                out.type = json_t::number_integer;
+                out.integer = static_cast<long long>(0ULL - mantissa);
+                return p;
+            }
+        }
+
+        out.type = json_t::number_double;
+        if (mantissa == 0)
+        {
+            out.number = negative ? -0.0 : 0.0;
+            return p;
+        }
+
+        // Clinger 快速路径：有效数字和 10 的幂都能精确表示时，一次乘除法即为正确舍入的结果
+#if !defined(FLT_EVAL_METHOD) || FLT_EVAL_METHOD == 0
+        static const double exact_powers[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                              1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+        if (!truncated && mantissa <= (1ULL << 53) && exp10 >= -22 && exp10 <= 22)
+        {
+            double d = static_cast<double>(mantissa);
+            d = exp10 < 0 ? d / exact_powers[-exp10] : d * exact_powers[exp10];
+            out.number = negative ? -d : d;
+            return p;
+        }
+#endif
+
+        // Eisel-Lemire；有效数字被截断时，真实值介于 mantissa 与 mantissa + 1 之间，两者结果相同才可信
+        double d, d_upper;
+        if (eisel_lemire(mantissa, exp10, negative, d) &&
+            (!truncated || (eisel_lemire(mantissa + 1, exp10, negative, d_upper) && d == d_upper)))
+        {
+            out.number = d;
+            return p;
+        }
+
+        out.number = strtod_locale_independent(start, p);
+        return p;
+    }
+
+    // 可能出现在数值中的字符，用于确定数值的范围
+    inline bool is_number_byte(char c)
+    {
+        return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+    }
+
+    // 按分配器 A 重新绑定到元素类型 T 的分配器
+    template <class A, class T>
+    using rebind_alloc = typename std::allocator_traits<A>::template rebind_alloc<T>;
+
+    // 没有现成的分配器可用时（标量、借用的字符串）使用默认构造的分配器；
+    // 绑定到具体内存池、不能默认构造的分配器在这种情况下抛出异常，而不是让整个 basic_json 无法实例化
+    template <class A>
+    inline A default_allocator(std::true_type) { return A(); }
+
+    template <class A>
+    TINYJSON_COLD inline A default_allocator(std::false_type)
+    {
+        TINYJSON_THROW(std::logic_error("allocator is not default constructible"));
+    }
+
+    template <class A>
+    inline A default_allocator() { return default_allocator<A>(std::is_default_constructible<A>()); }
+
+    // FNV-1a 哈希，用于键名的哈希索引和键名池
+    inline uint32_t hash_bytes(string_view key)
+    {
+        uint32_t h = 2166136261u;
+        for (size_t i = 0; i < key.size(); i++)
+        {
+            h ^= static_cast<unsigned char>(key[i]);
+            h *= 16777619u;
+        }
+        return h;
+    }
+
+    // 64 位的非加密哈希，每次处理 8 个字节，用于较长的输入（如解析缓存的键）
+    inline uint64_t hash_bytes64(string_view data)
+    {
+        const uint64_t m = 0x9E3779B97F4A7C15ULL;
+        uint64_t h = 0xCBF29CE484222325ULL ^ (data.size() * m);
+        const char *p = data.data();
+        size_t n = data.size();
+        for (; n >= 8; p += 8, n -= 8)
+        {
+            uint64_t w;
+            std::memcpy(&w, p, 8);
+            h = (h ^ (w * m)) * m;
+            h ^= h >> 29;
+        }
+        uint64_t tail = 0;
+        if (n != 0)
+        {
+            std::memcpy(&tail, p, n);
+        }
+        h = (h ^ (tail * m)) * m;
+        h ^= h >> 32;
+        h *= m;
+        return h ^ (h >> 29);
+    }
+
+    // 保持插入顺序的对象存储，可替代 std::map 作为 basic_json 的对象类型
+    // 成员按插入顺序连续存放在 vector 中；成员不超过 linear_limit 个时线性查找，
+    // 超过后额外维护一个开放寻址（线性探测）的哈希索引，查找、插入都只探测一次
+    // 与 std::map 不同，value_type 的键名不是 const，但不能通过迭代器修改键名
+    template <class Key, class T, class Compare = std::less<Key>,
+              class Alloc = std::allocator<std::pair<const Key, T>>>
+    class ordered_map
+    {
+    public:
+        using key_type = Key;
+        using mapped_type = T;
+        using value_type = std::pair<Key, T>;
+        using allocator_type = rebind_alloc<Alloc, value_type>;
+        using size_type = size_t;
+
+    private:
+        /// 哈希索引的一个位置，pos 为成员下标加一，0 表示空位
+        struct slot
+        {
+            uint32_t pos;  ///< 成员下标加一
+            uint32_t hash; ///< 键名的哈希值，探测时先比较哈希值
+        };
+
+        using storage_t = std::vector<value_type, allocator_type>;
+        using index_t = std::vector<slot, rebind_alloc<Alloc, slot>>;
+
+    public:
+        using iterator = typename storage_t::iterator;
+        using const_iterator = typename storage_t::const_iterator;
+
+        /// 不超过该数量的成员只做线性查找，不建立哈希索引
+        static const size_type linear_limit = 8;
+
+        ordered_map() {}
+        explicit ordered_map(const allocator_type &alloc)
+            : _items(alloc), _index(typename index_t::allocator_type(alloc)) {}
+
+        allocator_type get_allocator() const { return _items.get_allocator(); }
+
+        iterator begin() { return _items.begin(); }
+        iterator end() { return _items.end(); }
+        const_iterator begin() const { return _items.begin(); }
+        const_iterator end() const { return _items.end(); }
+
+        size_type size() const { return _items.size(); }
+        bool empty() const { return _items.empty(); }
+
+        void clear()
+        {
+            _items.clear();
+            _index.clear();
+        }
+
+        void reserve(size_type n) { _items.reserve(n); }
+
+        /// 按键名查找，不需要构造临时的键
+        iterator find(string_view key)
+        {
+            uint32_t h;
+            size_t s;
+            return _items.begin() + probe(key, h, s);
+        }
+
+        const_iterator find(string_view key) const
+        {
+            uint32_t h;
+            size_t s;
+            return _items.begin() + probe(key, h, s);
+        }
+
+        size_type count(string_view key) const { return find(key) == end() ? 0 : 1; }
+
+        /// 访问成员，不存在时在末尾插入默认值
+        T &operator[](const key_type &key) { return emplace(key).first->second; }
+        T &operator[](key_type &&key) { return emplace(std::move(key)).first->second; }
+
+        /// 键名不存在时在末尾插入，存在时不做修改；返回成员位置以及是否发生了插入
+        template <class K, class... Args>
+        std::pair<iterator, bool> emplace(K &&key, Args &&...args)
+        {
+            uint32_t h;
+            size_t s;
+            size_type pos = probe(string_view(key), h, s);
+            if (pos != _items.size())
+            {
+                return std::make_pair(_items.begin() + pos, false);
+            }
+
+            _items.emplace_back(std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+                                std::forward_as_tuple(std::forward<Args>(args)...));
+            record(s, h);
+            return std::make_pair(_items.end() - 1, true);
+        }
+
+        /// 与 std::map 接口一致，成员总是追加在末尾，hint 被忽略
+        template <class K, class... Args>
+        iterator emplace_hint(const_iterator, K &&key, Args &&...args)
+        {
+            return emplace(std::forward<K>(key), std::forward<Args>(args)...).first;
+        }
+
+        /// 成员相同即相等，与插入顺序无关
+        friend bool operator==(const ordered_map &a, const ordered_map &b)
+        {
+            if (a.size() != b.size())
+            {
+                return false;
+            }
+            for (auto it = a.begin(); it != a.end(); ++it)
+            {
+                auto other = b.find(it->first);
+                if (other == b.end() || !(other->second == it->second))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        friend bool operator!=(const ordered_map &a, const ordered_map &b) { return !(a == b); }
+
+    private:
+        static uint32_t hash(string_view key) { return hash_bytes(key); }
+
+        // 查找键名，返回成员下标，不存在时返回 size()
+        // 建立了索引时，h 和 s 返回键名的哈希值以及可以插入的空位
+        size_type probe(string_view key, uint32_t &h, size_t &s) const
+        {
+            h = 0;
+            s = 0;
+            if (_index.empty())
+            {
+                for (size_type i = 0; i < _items.size(); i++)
+                {
+                    if (string_view(_items[i].first) == key)
+                    {
+                        return i;
+                    }
+                }
+                return _items.size();
+            }
+
+            h = hash(key);
+            size_t mask = _index.size() - 1;
+            for (s = h & mask;; s = (s + 1) & mask)
+            {
+                const slot &e = _index[s];
+                if (e.pos == 0)
+                {
+                    return _items.size();
+                }
+                if (e.hash == h && string_view(_items[e.pos - 1].first) == key)
+                {
+                    return e.pos - 1;
+                }
+            }
+        }
+
+        // 在空位 s 记录刚追加到末尾的成员，必要时建立或扩大索引
+        void record(size_t s, uint32_t h)
+        {
+            if (!_index.empty())
+            {
+                _index[s] = slot{static_cast<uint32_t>(_items.size()), h};
+                if (_items.size() * 2 > _index.size())
+                {
+                    rehash(_index.size() * 2);
+                }
+            }
+            else if (_items.size() > linear_limit)
+            {
+                size_t capacity = 16;
+                while (capacity < _items.size() * 2)
+                {
+                    capacity *= 2;
+                }
+                rehash(capacity);
+            }
+        }
+
+        // 按新的容量（2 的幂）重建索引，负载因子保持在 1/2 以下
+        void rehash(size_t capacity)
+        {
+            index_t index(capacity, slot(), _index.get_allocator());
+            size_t mask = capacity - 1;
+            if (_index.empty())
+            {
+                // 第一次建立索引，计算全部键名的哈希值
+                for (size_type i = 0; i < _items.size(); i++)
+                {
+                    uint32_t h = hash(_items[i].first);
+                    index[place(index, mask, h)] = slot{static_cast<uint32_t>(i + 1), h};
+                }
+            }
+            else
+            {
+                // 扩大索引时复用保存的哈希值
+                for (size_t i = 0; i < _index.size(); i++)
+                {
+                    if (_index[i].pos != 0)
+                    {
+                        index[place(index, mask, _index[i].hash)] = _index[i];
+                    }
+                }
+            }
+            _index.swap(index);
+        }
+
+        // 从哈希值对应的位置开始找到第一个空位
+        static size_t place(const index_t &index, size_t mask, uint32_t h)
+        {
+            size_t s = h & mask;
+            while (index[s].pos != 0)
+            {
+                s = (s + 1) & mask;
+            }
+            return s;
+        }
+
+        storage_t _items; ///< 按插入顺序存放的成员
+        index_t _index;   ///< 哈希索引，成员较少时为空
+    };
+
+    // 键名池：相同内容的键名只保存一份，返回的视图在池销毁前一直有效
+    // 字符按块从分配器取得，只增不减；池本身不是线程安全的
+    template <class Alloc = std::allocator<char>>
+    class basic_key_pool
+    {
+    public:
+        using allocator_type = rebind_alloc<Alloc, char>;
+
+        /// 每次向分配器申请的最小字符块
+        static const size_t block_size = 4096;
+
+        explicit basic_key_pool(const allocator_type &alloc = allocator_type())
+            : _alloc(alloc), _table(typename table_t::allocator_type(alloc)),
+              _blocks(typename blocks_t::allocator_type(alloc)), _cur(nullptr), _left(0), _count(0), _bytes(0) {}
+
+        basic_key_pool(const basic_key_pool &) = delete;
+        basic_key_pool &operator=(const basic_key_pool &) = delete;
+
+        ~basic_key_pool()
+        {
+            for (size_t i = 0; i < _blocks.size(); i++)
+            {
+                traits::deallocate(_alloc, _blocks[i].first, _blocks[i].second);
+            }
+        }
+
+        allocator_type get_allocator() const { return _alloc; }
+
+        /// 返回与 key 内容相同的池内键名，第一次出现时复制进池
+        string_view intern(string_view key)
+        {
+            if (_table.empty())
+            {
+                _table.resize(64);
+            }
+
+            uint32_t h = hash_bytes(key);
+            size_t mask = _table.size() - 1;
+            size_t s = h & mask;
+            for (;; s = (s + 1) & mask)
+            {
+                const entry &e = _table[s];
+                if (e.data == nullptr)
+                {
+                    break;
+                }
+                if (e.hash == h && string_view(e.data, e.size) == key)
+                {
+                    return string_view(e.data, e.size);
+                }
+            }
+
+            const char *data = store(key);
+            _table[s] = entry{data, static_cast<uint32_t>(key.size()), h};
+            if (++_count * 2 > _table.size())
+            {
+                rehash(_table.size() * 2);
+            }
+            return string_view(data, key.size());
+        }
+
+        /// 不同键名的数量
+        size_t size() const { return _count; }
+
+        /// 键名占用的字符数
+        size_t bytes_used() const { return _bytes; }
+
+    private:
+        using traits = std::allocator_traits<allocator_type>;
+
+        /// 散列表的一个位置，data 为空表示空位
+        struct entry
+        {
+            const char *data; ///< 池内的字符
+            uint32_t size;    ///< 字节数
+            uint32_t hash;    ///< 键名的哈希值
+        };
+
+        using table_t = std::vector<entry, rebind_alloc<Alloc, entry>>;
+        using blocks_t = std::vector<std::pair<char *, size_t>, rebind_alloc<Alloc, std::pair<char *, size_t>>>;
+
+        // 把键名的字符复制进当前块，空间不够时申请新块
+        const char *store(string_view key)
+        {
+            if (_cur == nullptr || key.size() > _left)
+            {
+                size_t n = key.size() > block_size ? key.size() : block_size;
+                _blocks.reserve(_blocks.size() + 1);
+                _cur = traits::allocate(_alloc, n);
+                _blocks.push_back(std::make_pair(_cur, n));
+                _left = n;
+            }
+            char *data = _cur;
+            if (key.size() != 0)
+            {
+                std::memcpy(data, key.data(), key.size());
+            }
+            _cur += key.size();
+            _left -= key.size();
+            _bytes += key.size();
+            return data;
+        }
+
+        // 按新的容量（2 的幂）重建散列表，复用保存的哈希值
+        void rehash(size_t capacity)
+        {
+            table_t table(capacity, entry(), _table.get_allocator());
+            size_t mask = capacity - 1;
+            for (size_t i = 0; i < _table.size(); i++)
+            {
+                if (_table[i].data != nullptr)
+                {
+                    size_t s = _table[i].hash & mask;
+                    while (table[s].data != nullptr)
+                    {
+                        s = (s + 1) & mask;
+                    }
+                    table[s] = _table[i];
+                }
+            }
+            _table.swap(table);
+        }
+
+        allocator_type _alloc; ///< 字符块和散列表使用的分配器
+        table_t _table;        ///< 开放寻址（线性探测）的散列表
+        blocks_t _blocks;      ///< 已申请的字符块及其大小
+        char *_cur;            ///< 当前块中下一个可用的位置
+        size_t _left;          ///< 当前块剩余的字节数
+        size_t _count;         ///< 不同键名的数量
+        size_t _bytes;         ///< 键名占用的字符数
+    };
+
+    using key_pool = basic_key_pool<>;
+
+    // 键名驻留的对象存储，可替代 std::map 作为 basic_json 的对象类型
+    // 成员与 ordered_map 一样保持插入顺序，但键名只是指向键名池的视图：
+    // 同一次解析（以及由它拷贝出的对象）共享一个池，大量结构相同的记录只保存一份键名，
+    // 池内键名之间的比较只需比较指针
+    // 池由共享它的对象共同持有，最后一个对象销毁时释放；共享同一个池的对象不能被并发修改
+    template <class Key, class T, class Compare = std::less<Key>,
+              class Alloc = std::allocator<std::pair<const Key, T>>>
+    class interned_map
+    {
+        using map_t = ordered_map<string_view, T, std::less<string_view>, Alloc>;
+
+    public:
+        using key_type = string_view;
+        using mapped_type = T;
+        using value_type = typename map_t::value_type;
+        using allocator_type = typename map_t::allocator_type;
+        using size_type = typename map_t::size_type;
+        using iterator = typename map_t::iterator;
+        using const_iterator = typename map_t::const_iterator;
+        using pool_type = basic_key_pool<Alloc>;
+
+        interned_map() : interned_map(allocator_type()) {}
+        explicit interned_map(const allocator_type &alloc) : _map(alloc), _pool(make_pool(alloc)) {}
+
+        /// 与其他对象共享键名池，pool 必须使用与 alloc 相等的分配器
+        interned_map(const allocator_type &alloc, std::shared_ptr<pool_type> pool)
+            : _map(alloc), _pool(std::move(pool)) {}
+
+        allocator_type get_allocator() const { return _map.get_allocator(); }
+
+        /// 对象使用的键名池
+        const std::shared_ptr<pool_type> &pool() const { return _pool; }
+
+        iterator begin() { return _map.begin(); }
+        iterator end() { return _map.end(); }
+        const_iterator begin() const { return _map.begin(); }
+        const_iterator end() const { return _map.end(); }
+
+        size_type size() const { return _map.size(); }
+        bool empty() const { return _map.empty(); }
+        void clear() { _map.clear(); }
+        void reserve(size_type n) { _map.reserve(n); }
+
+        iterator find(string_view key) { return _map.find(key); }
+        const_iterator find(string_view key) const { return _map.find(key); }
+        size_type count(string_view key) const { return _map.count(key); }
+
+        /// 访问成员，不存在时先把键名放入池中，再在末尾插入默认值
+        T &operator[](string_view key) { return emplace(key).first->second; }
+
+        template <class K, class... Args>
+        std::pair<iterator, bool> emplace(K &&key, Args &&...args)
+        {
+            return _map.emplace(intern(string_view(key)), std::forward<Args>(args)...);
+        }
+
+        template <class K, class... Args>
+        iterator emplace_hint(const_iterator, K &&key, Args &&...args)
+        {
+            return emplace(std::forward<K>(key), std::forward<Args>(args)...).first;
+        }
+
+        friend bool operator==(const interned_map &a, const interned_map &b) { return a._map == b._map; }
+        friend bool operator!=(const interned_map &a, const interned_map &b) { return !(a == b); }
+
+    private:
+        static std::shared_ptr<pool_type> make_pool(const allocator_type &alloc)
+        {
+            typename pool_type::allocator_type chars(alloc);
+            return std::allocate_shared<pool_type>(rebind_alloc<Alloc, pool_type>(alloc), chars);
+        }
+
+        // 被移动过的对象没有池，再次插入时重新创建
+        string_view intern(string_view key)
+        {
+            if (!_pool)
+            {
+                _pool = make_pool(_map.get_allocator());
+            }
+            return _pool->intern(key);
+        }
+
+        map_t _map;                        ///< 键名为池内视图的成员
+        std::shared_ptr<pool_type> _pool;  ///< 键名池
+    };
+
+    // 按键名在对象中查找成员
+    // std::map 需要先按对象的分配器构造出键名；ordered_map 和 interned_map 直接用字符串视图查找，不产生临时字符串
+    template <class Map>
+    inline typename Map::const_iterator object_find(const Map &members, string_view key)
+    {
+        using key_type = typename Map::key_type;
+        return members.find(key_type(key.data(), key.size(), typename key_type::allocator_type(members.get_allocator())));
+    }
+
+    template <class Key, class T, class Compare, class Alloc>
+    inline typename ordered_map<Key, T, Compare, Alloc>::const_iterator
+    object_find(const ordered_map<Key, T, Compare, Alloc> &members, string_view key)
+    {
+        return members.find(key);
+    }
+
+    template <class Key, class T, class Compare, class Alloc>
+    inline typename interned_map<Key, T, Compare, Alloc>::const_iterator
+    object_find(const interned_map<Key, T, Compare, Alloc> &members, string_view key)
+    {
+        return members.find(key);
+    }
+
+    // 创建一个与 proto 处在同一上下文中的空对象，用于解析和深拷贝
+    // 一般的对象类型只需要分配器；interned_map 在分配器相等时与 proto 共享键名池
+    template <class Map>
+    inline Map object_like(const Map &, const typename Map::allocator_type &alloc)
+    {
+        return Map(alloc);
+    }
+
+    template <class Key, class T, class Compare, class Alloc>
+    inline interned_map<Key, T, Compare, Alloc>
+    object_like(const interned_map<Key, T, Compare, Alloc> &proto,
+                const typename interned_map<Key, T, Compare, Alloc>::allocator_type &alloc)
+    {
+        using map_t = interned_map<Key, T, Compare, Alloc>;
+        if (proto.pool() && proto.pool()->get_allocator() == typename map_t::pool_type::allocator_type(alloc))
+        {
+            return map_t(alloc, proto.pool());
+        }
+        return map_t(alloc);
+    }
+
+    template <class Allocator = std::allocator<char>,
+              template <class, class, class, class> class ObjectMap = std::map>
+    class basic_json;
+
+    // 构造借用外部字符、不复制的字符串值时使用的标记，见 basic_json(borrow_t, string_view)
+    struct borrow_t
+    {
+    };
+    constexpr borrow_t borrow = borrow_t();
+
+    using json = basic_json<>;
+    using json_object = std::map<std::string, json>;
+    using json_array = std::vector<json>;
+
+    // 任意 basic_json 的对象和数组类型，元素使用与 BasicJson 相同的分配器，如 basic_json_object<arena_json>
+    template <class BasicJson>
+    using basic_json_object = typename BasicJson::object_t;
+    template <class BasicJson>
+    using basic_json_array = typename BasicJson::array_t;
+
+    // 对象成员保持插入顺序的 json
+    using ordered_json = basic_json<std::allocator<char>, ordered_map>;
+
+    // 对象键名驻留在共享键名池中的 json，适合大量结构相同的记录
+    using interned_json = basic_json<std::allocator<char>, interned_map>;
+
+    // basic_json 类表示一个 JSON 值
+    // 可以是字符串、数字、数组、布尔值、对象或 null
+    // Allocator 决定字符串、数组和对象的存储从哪里分配，json 使用默认的全局堆
+    // ObjectMap 决定对象成员的存储方式：std::map 按键名排序，ordered_map 保持插入顺序并使用哈希索引，
+    // interned_map 在此基础上让键名共享同一个键名池
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    class basic_json
+    {
+    public:
+        using allocator_type = Allocator;
+        using string_t = std::basic_string<char, std::char_traits<char>, rebind_alloc<Allocator, char>>;
+        using array_t = std::vector<basic_json, rebind_alloc<Allocator, basic_json>>;
+        using object_t = ObjectMap<string_t, basic_json, std::less<string_t>,
+                                   rebind_alloc<Allocator, std::pair<const string_t, basic_json>>>;
+
+    private:
+        /// JSON 值的实际数据
+        /// 布尔值和数值直接内联存储，只有字符串、数组和对象才分配，
+        /// 并且使用其自身保存的分配器来分配和释放
+        union json_value
+        {
+            bool boolean;             ///< 布尔值
+            long long number_integer; ///< 整数值
+            double number_double;     ///< 浮点数值
+            string_t *string;         ///< 指向字符串数据
+            const char *view;         ///< 借用的字符串数据（原位解析），不属于当前值
+            array_t *array;           ///< 指向数组数据
+            object_t *object;         ///< 指向对象数据
+        } _value;
+        /// JSON 值的类型
+        json_t _type;
+        /// 借用的字符串长度加一，0 表示字符串由当前值持有；占用 _type 之后的填充，不增加对象大小
+        uint32_t _view_size = 0;
+
+    public:
+        basic_json();
+        basic_json(const string_t &val); // 字符串类型
+        basic_json(string_t &&val);
+        basic_json(const char *val, const allocator_type &alloc = allocator_type());
+        basic_json(string_view val, const allocator_type &alloc = allocator_type());
+        /// 借用 val 指向的字符而不复制，val 必须在当前值（及其拷贝）的整个生命周期内有效
+        basic_json(borrow_t, string_view val);
+        basic_json(double val);              // 浮点数类型
+        basic_json(int val);                 // 整数类型
+        basic_json(long val);                // 长整型类型
+        basic_json(long long val);           // 长整型类型
+        basic_json(bool val);                // 布尔类型
+        basic_json(const array_t &array);    // 数组类型
+        basic_json(array_t &&array);         // 数组类型（移动语义）
+        basic_json(const object_t &obj);     // 对象类型
+        basic_json(object_t &&obj);          // 对象类型（移动语义）
+
+        ~basic_json();
+
+        /// 获取 JSON 值的类型
+        const json_t type() const;           // 返回 JSON 值的类型
+        const std::string type_name() const; // 返回 JSON 值类型的名称
+
+        basic_json(const basic_json &other);
+        basic_json(basic_json &&other) noexcept;
+        basic_json &operator=(const basic_json &other);
+        basic_json &operator=(basic_json &&other) noexcept;
+
+        /// 使用指定的分配器拷贝 other
+        basic_json(const basic_json &other, const allocator_type &alloc);
+        /// 分配器相同时直接接管 other 的数据，否则拷贝到指定的分配器上
+        basic_json(basic_json &&other, const allocator_type &alloc);
+
+        /// 返回当前值的数据所使用的分配器
+        /// 标量和借用的字符串没有自己的数据，返回默认构造的分配器；分配器不能默认构造时抛出异常
+        allocator_type get_allocator() const;
+
+        bool operator==(const basic_json &rhs) const;
+        bool operator!=(const basic_json &rhs) const;
+
+        /// 只读访问返回引用，不复制数据
+        /// 借用的字符串没有可供引用的 string_t，const 的 get_string() 对它抛出 std::logic_error，
+        /// 应改用 get_string_view()；需要持有的字符串时调用非 const 的 get_string()，它会先复制一份
+        const string_t &get_string() const;
+        /// 对拥有的和借用的字符串都适用，不复制数据；视图在值被修改或销毁（借用时为缓冲区失效）前有效
+        string_view get_string_view() const;
+        const long long get_integer() const;
+        const double get_double() const;
+        const bool get_bool() const;
+        const object_t &get_object() const;
+        const array_t &get_array() const;
+        const void *get_null() const;
+
+        /// 可修改的引用访问
+        string_t &get_string();
+        object_t &get_object();
+        array_t &get_array();
+
+        /// 获取 JSON 值的大小（数组或对象）
+        size_t size() const;
+
+        /// 是否为借用外部缓冲区的字符串（原位解析的结果）
+        bool is_borrowed() const { return _type == json_t::string && _view_size != 0; }
+
+        /// 检查对象中是否存在指定的成员
+        bool has_member(string_view member_name) const;
+
+        /// 查找对象的成员或数组的元素；不是相应的容器或者找不到时返回 nullptr，不抛出异常
+        const basic_json *find(string_view key) const;
+        basic_json *find(string_view key);
+        const basic_json *find(size_t index) const;
+        basic_json *find(size_t index);
+
+        /// 类型相符时把值写入 out 并返回 true，否则返回 false 且不修改 out，不抛出异常
+        bool try_get_string(string_view &out) const;
+        bool try_get_integer(long long &out) const;
+        bool try_get_double(double &out) const;
+        bool try_get_bool(bool &out) const;
+
+        /// 添加成员或元素，数据会被转移到当前容器的分配器上
+        void add_member(string_t member_name, basic_json member_value);
+        void add_element(basic_json elem); // 向数组添加一个元素
+
+        basic_json &operator[](const char *key); // 访问对象的成员
+        basic_json &operator[](int index);       // 访问数组的元素
+        const basic_json &operator[](const char *key) const;
+        const basic_json &operator[](int index) const;
+
+        operator const std::string() const; // 将 JSON 值转换为字符串
+        operator const double() const;      // 将 JSON 值转换为双精度浮点数
+        operator const long long() const;   // 将 JSON 值转换为长整型
+        operator const bool() const;        // 将 JSON 值转换为布尔值
+
+        /// 序列化 JSON 值
+        const std::string to_string() const;
+
+        /// 将序列化结果直接追加到 sink 中，整个过程只遍历一次、不产生中间字符串
+        template <class Sink>
+        void dump(Sink &sink) const;
+        /// 追加到 out 的末尾，out 可以跨多次调用复用
+        void dump(std::string &out) const;
+        /// 写入输出流
+        void dump(std::ostream &os) const;
+
+        /// 序列化结果的精确字节数，可用于一次性预留空间
+        size_t dump_size() const;
+
+        /// 按 options 指定的格式序列化：紧凑（不含任何空白）或带换行和缩进
+        const std::string to_string(const dump_options &options) const;
+        template <class Sink>
+        void dump(Sink &sink, const dump_options &options) const;
+        void dump(std::string &out, const dump_options &options) const;
+        void dump(std::ostream &os, const dump_options &options) const;
+        size_t dump_size(const dump_options &options) const;
+
+    private:
+        /// 使用 alloc 深拷贝 other 的数据，调用前当前值必须为 null
+        void copy_from(const basic_json &other, const allocator_type &alloc);
+
+        /// 释放数据，之后当前值处于 null 状态
+        void destroy();
+
+        /// 使用 alloc 分配并构造一个 T（字符串、数组或对象）
+        template <class T, class... Args>
+        static T *create(const allocator_type &alloc, Args &&...args);
+
+        /// 用 T 自身保存的分配器析构并释放 p
+        template <class T>
+        static void dispose(T *p);
+
+        /// 按对象使用的分配器构造键名，用于查找
+        static string_t make_key(string_view key, const object_t &obj);
+
+        /// 把借用的字符串复制为自身持有的字符串（使用默认构造的分配器）
+        void own_string();
+
+        /// 是否持有分配得到的数据（自身持有的字符串、数组或对象）
+        bool owns_storage() const
+        {
+            return (_type == json_t::string && _view_size == 0) || _type == json_t::array || _type == json_t::object;
+        }
+    };
+
+    //
+    // 具体实现
+    //
+
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    template <class T, class... Args>
+    inline T *basic_json<Allocator, ObjectMap>::create(const allocator_type &alloc, Args &&...args)
+    {
+        rebind_alloc<Allocator, T> a(alloc);
+#if defined(TINYJSON_INSTRUMENT)
+        if (std::is_same<T, string_t>::value)
+        {
+            TINYJSON_STAT_ADD(strings_allocated, 1);
+        }
+        T *p = instrument::allocate_node(a);
+#else
+        using traits = std::allocator_traits<rebind_alloc<Allocator, T>>;
+        T *p = traits::allocate(a, 1);
+#endif
+        TINYJSON_TRY
+        {
+            ::new (static_cast<void *>(p)) T(std::forward<Args>(args)...);
+        }
+        TINYJSON_CATCH(...)
+        {
+#if defined(TINYJSON_INSTRUMENT)
+            instrument::deallocate_node(a, p);
+#else
+            traits::deallocate(a, p, 1);
+#endif
+            TINYJSON_RETHROW;
+        }
+        return p;
+    }
+
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    template <class T>
+    inline void basic_json<Allocator, ObjectMap>::dispose(T *p)
+    {
+        rebind_alloc<Allocator, T> a(p->get_allocator());
+        p->~T();
+#if defined(TINYJSON_INSTRUMENT)
+        instrument::deallocate_node(a, p);
+#else
+        std::allocator_traits<rebind_alloc<Allocator, T>>::deallocate(a, p, 1);
+#endif
+    }
+
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline typename basic_json<Allocator, ObjectMap>::string_t basic_json<Allocator, ObjectMap>::make_key(string_view key, const object_t &obj)
+    {
+        return string_t(key.data(), key.size(), typename string_t::allocator_type(obj.get_allocator()));
+    }
+
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline basic_json<Allocator, ObjectMap>::basic_json() : _type(json_t::null) { _value.object = nullptr; }
+
+    // 字符串类型的 JSON 对象
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline basic_json<Allocator, ObjectMap>::basic_json(const string_t &val) : _type(json_t::string)
+    {
+        _value.string = create<string_t>(allocator_type(val.get_allocator()), val);
+    }
+
+    // 字符串类型的 JSON 对象（移动语义）
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline basic_json<Allocator, ObjectMap>::basic_json(string_t &&val) : _type(json_t::string)
+    {
+        _value.string = create<string_t>(allocator_type(val.get_allocator()), std::move(val));
+    }
+
+    // 字符串类型的 JSON 对象（C 风格字符串）
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline basic_json<Allocator, ObjectMap>::basic_json(const char *val, const allocator_type &alloc) : _type(json_t::string)
+    {
+        _value.string = create<string_t>(alloc, val, typename string_t::allocator_type(alloc));
+    }
+
+    // 字符串类型的 JSON 对象（字符串视图，也用于从其他类型的字符串构造）
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline basic_json<Allocator, ObjectMap>::basic_json(string_view val, const allocator_type &alloc) : _type(json_t::string)
+    {
+        _value.string = create<string_t>(alloc, val.data(), val.size(), typename string_t::allocator_type(alloc));
+    }
+
+    // 借用外部字符的字符串，过长时（超过 32 位长度）退回为复制
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline basic_json<Allocator, ObjectMap>::basic_json(borrow_t, string_view val) : _type(json_t::string)
+    {
+        if (val.size() < UINT32_MAX)
+        {
+            _value.view = val.data();
+            _view_size = static_cast<uint32_t>(val.size() + 1);
+        }
+        else
+        {
+            allocator_type alloc = default_allocator<allocator_type>();
+            _value.string = create<string_t>(alloc, val.data(), val.size(), typename string_t::allocator_type(alloc));
+        }
+    }
+
+    // 双精度浮点数类型的 JSON 对象
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline basic_json<Allocator, ObjectMap>::basic_json(double val) : _type(json_t::number_double)
+    {
+        _value.number_double = val;
+    }
+
+    // 长整型类型的 JSON 对象
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline basic_json<Allocator, ObjectMap>::basic_json(long long val) : _type(json_t::number_integer)
+    {
+        _value.number_integer = val;
+    }
+
+    // 长整型类型的 JSON 对象（LP64 平台上的 long 与 long long 是不同类型）
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline basic_json<Allocator, ObjectMap>::basic_json(long val) : _type(json_t::number_integer)
+    {
+        _value.number_integer = val;
+    }
+
+    // 整型类型的 JSON 对象
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline basic_json<Allocator, ObjectMap>::basic_json(int val) : _type(json_t::number_integer)
+    {
+        _value.number_integer = val;
+    }
+
+    // 布尔类型的 JSON 对象
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline basic_json<Allocator, ObjectMap>::basic_json(bool val) : _type(json_t::boolean)
+    {
+        _value.boolean = val;
+    }
+
+    // 数组类型的 JSON 对象
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline basic_json<Allocator, ObjectMap>::basic_json(const array_t &array) : _type(json_t::array)
+    {
+        _value.array = create<array_t>(allocator_type(array.get_allocator()), array);
+    }
+
+    // 数组类型的 JSON 对象（移动语义）
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline basic_json<Allocator, ObjectMap>::basic_json(array_t &&array) : _type(json_t::array)
+    {
+        _value.array = create<array_t>(allocator_type(array.get_allocator()), std::move(array));
+    }
+
+    // 对象类型的 JSON 对象
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline basic_json<Allocator, ObjectMap>::basic_json(const object_t &obj) : _type(json_t::object)
+    {
+        _value.object = create<object_t>(allocator_type(obj.get_allocator()), obj);
+    }
+
+    // 对象类型的 JSON 对象（移动语义）
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline basic_json<Allocator, ObjectMap>::basic_json(object_t &&obj) : _type(json_t::object)
+    {
+        _value.object = create<object_t>(allocator_type(obj.get_allocator()), std::move(obj));
+    }
+
+    // 获取 JSON 对象的类型
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline const json_t basic_json<Allocator, ObjectMap>::type() const { return _type; }
+
+    // 获取数据类型
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline const std::string basic_json<Allocator, ObjectMap>::type_name() const
+    {
+        switch (_type)
+        {
+        case (json_t::string):
+            return "string";
+
+        case (json_t::array):
+            return "array";
+
+        case (json_t::object):
+            return "object";
+
+        case (json_t::number_double):
+        case (json_t::number_integer):
+            return "number";
+
+        case (json_t::boolean):
+            return "boolean";
+
+        case (json_t::null):
+            return "null";
+
+        case (json_t::invalid):
+        default:
+            return "invalid";
+        }
+    }
+
+    // 拷贝构造函数
+    // 数据按分配器的拷贝约定（select_on_container_copy_construction）分配，标量和借用的字符串不需要分配器
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline basic_json<Allocator, ObjectMap>::basic_json(const basic_json &other) : _type(json_t::null)
+    {
+        if (other.owns_storage())
+        {
+            copy_from(other, std::allocator_traits<Allocator>::select_on_container_copy_construction(other.get_allocator()));
+        }
+        else
+        {
+            _value = other._value;
+            _type = other._type;
+            _view_size = other._view_size;
+        }
+    }
+
+    // 使用指定分配器的拷贝构造函数
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline basic_json<Allocator, ObjectMap>::basic_json(const basic_json &other, const allocator_type &alloc) : _type(json_t::null)
+    {
+        copy_from(other, alloc);
+    }
+
+    // 深拷贝 other 的数据
+    // 标量直接按位复制，只有字符串、数组和对象需要深拷贝
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline void basic_json<Allocator, ObjectMap>::copy_from(const basic_json &other, const allocator_type &alloc)
+    {
+        switch (other._type)
+        {
+        case json_t::string:
+            if (other._view_size != 0)
+            {
+                _value.view = other._value.view; // 借用的字符串只复制视图
+            }
+            else
+            {
+                _value.string = create<string_t>(alloc, other._value.string->data(), other._value.string->size(),
+                                                 typename string_t::allocator_type(alloc));
+            }
+            _view_size = other._view_size;
+            break;
+        case json_t::object:
+        {
+            // 先在局部构造，拷贝中途失败时由局部对象负责清理
+            typename object_t::allocator_type members_alloc(alloc);
+            object_t members = object_like(*other._value.object, members_alloc);
+            for (auto it = other._value.object->begin(); it != other._value.object->end(); ++it)
+            {
+                members.emplace_hint(members.end(), make_key(it->first, members), basic_json(it->second, alloc));
+            }
+            _value.object = create<object_t>(alloc, std::move(members));
+            break;
+        }
+        case json_t::array:
+        {
+            typename array_t::allocator_type elems_alloc(alloc);
+            array_t elems(elems_alloc);
+            elems.reserve(other._value.array->size());
+            for (auto it = other._value.array->begin(); it != other._value.array->end(); ++it)
+            {
+                elems.emplace_back(*it, alloc);
+            }
+            _value.array = create<array_t>(alloc, std::move(elems));
+            break;
+        }
+        case json_t::number_double:
+        case json_t::number_integer:
+        case json_t::boolean:
+        case json_t::null:
+            _value = other._value;
+            break;
+        default:
+            TINYJSON_THROW(std::runtime_error("unexpected json type: " + other.type_name()));
+        }
+        _type = other._type;
+    }
+
+    // 移动构造函数
+    // 直接接管数据的所有权，被移动的对象变为 null
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline basic_json<Allocator, ObjectMap>::basic_json(basic_json &&other) noexcept
+        : _value(other._value), _type(other._type), _view_size(other._view_size)
+    {
+        other._type = json_t::null;
+    }
+
+    // 使用指定分配器的移动构造函数
+    // 分配器不同时无法接管数据，只能拷贝一份到 alloc 上
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline basic_json<Allocator, ObjectMap>::basic_json(basic_json &&other, const allocator_type &alloc) : _type(json_t::null)
+    {
+        if (other.owns_storage() && !(other.get_allocator() == alloc))
+        {
+            copy_from(other, alloc);
+        }
+        else
+        {
+            _value = other._value;
+            _type = other._type;
+            _view_size = other._view_size;
+            other._type = json_t::null;
+        }
+    }
+
+    // 拷贝赋值运算符
+    // 先完成拷贝再释放旧数据，拷贝失败时当前值保持不变
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline basic_json<Allocator, ObjectMap> &basic_json<Allocator, ObjectMap>::operator=(const basic_json &other)
+    {
+        if (this != &other)
+        {
+            *this = basic_json(other);
+        }
+        return *this;
+    }
+
+    // 移动赋值运算符
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline basic_json<Allocator, ObjectMap> &basic_json<Allocator, ObjectMap>::operator=(basic_json &&other) noexcept
+    {
+        if (this != &other)
+        {
+            destroy();
+
+            _type = other._type;
+            _value = other._value;
+            _view_size = other._view_size;
+            other._type = json_t::null; // 数据的所有权已转移
+        }
+        return *this;
+    }
+
+    // 返回当前值的数据所使用的分配器
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline typename basic_json<Allocator, ObjectMap>::allocator_type basic_json<Allocator, ObjectMap>::get_allocator() const
+    {
+        switch (_type)
+        {
+        case json_t::string:
+            return _view_size != 0 ? default_allocator<allocator_type>() : allocator_type(_value.string->get_allocator());
+        case json_t::array:
+            return allocator_type(_value.array->get_allocator());
+        case json_t::object:
+            return allocator_type(_value.object->get_allocator());
+        default:
+            return default_allocator<allocator_type>();
+        }
+    }
+
+    // 比较当前 JSON 对象与另一个 JSON 对象是否相等
+    // 两个 JSON 对象相等当且仅当它们类型相同且值相等
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline bool basic_json<Allocator, ObjectMap>::operator==(const basic_json &rhs) const
+    {
+        // 如果类型不同，则不相等
+        if (_type != rhs._type)
+        {
+            return false;
+        }
+
+        // 根据 JSON 对象的类型，比较具体的值
+        switch (_type)
+        {
+        case json_t::array:
+            // 如果都是数组类型，则比较数组中的每个元素
+            return *_value.array == *rhs._value.array;
+
+        case json_t::object:
+            // 如果都是对象类型，则比较对象中的每个键值对
+            return *_value.object == *rhs._value.object;
+
+        case json_t::null:
+            // 如果都是 null 类型，则它们相等
+            return true;
+
+        case json_t::string:
+            // 如果都是字符串类型，则比较字符串内容（可能是借用的字符串）
+            return get_string_view() == rhs.get_string_view();
+
+        case json_t::boolean:
+            // 如果都是布尔类型，则比较布尔值
+            return _value.boolean == rhs._value.boolean;
+
+        case json_t::number_integer:
+            // 如果都是整数类型，则比较整数值
+            return _value.number_integer == rhs._value.number_integer;
+
+        case json_t::number_double:
+            // 如果都是浮点数类型，则比较浮点数值
+            return _value.number_double == rhs._value.number_double;
+
+        default:
+            // 其他类型（如 invalid）不相等
+            return false;
+        }
+    }
+
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline bool basic_json<Allocator, ObjectMap>::operator!=(const basic_json &rhs) const
+    {
+        return !(*this == rhs);
+    }
+
+    // 获取当前 JSON 对象的字符串值
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline const typename basic_json<Allocator, ObjectMap>::string_t &basic_json<Allocator, ObjectMap>::get_string() const
+    {
+        CHECK_TYPE_MISMATCH(this->_type, json_t::string);
+        if (_view_size != 0)
+        {
+            // 只读访问不修改值，多个线程可以同时读取同一个借用的文档
+            TINYJSON_THROW(std::logic_error("borrowed string has no owned copy, use get_string_view()"));
+        }
+        return *_value.string;
+    }
+
+    // 获取当前 JSON 对象字符串值的只读视图
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline string_view basic_json<Allocator, ObjectMap>::get_string_view() const
+    {
+        CHECK_TYPE_MISMATCH(this->_type, json_t::string);
+        if (_view_size != 0)
+        {
+            return string_view(_value.view, _view_size - 1);
+        }
+        return string_view(_value.string->data(), _value.string->size());
+    }
+
+    // 获取当前 JSON 对象字符串值的可修改引用
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline typename basic_json<Allocator, ObjectMap>::string_t &basic_json<Allocator, ObjectMap>::get_string()
+    {
+        CHECK_TYPE_MISMATCH(this->_type, json_t::string);
+        if (_view_size != 0)
+        {
+            own_string();
+        }
+        return *_value.string;
+    }
+
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline void basic_json<Allocator, ObjectMap>::own_string()
+    {
+        string_view val(_value.view, _view_size - 1);
+        allocator_type alloc = default_allocator<allocator_type>();
+        _value.string = create<string_t>(alloc, val.data(), val.size(), typename string_t::allocator_type(alloc));
+        _view_size = 0;
+    }
+
+    // 获取当前 JSON 对象的整数值
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline const long long basic_json<Allocator, ObjectMap>::get_integer() const
+    {
+        CHECK_TYPE_MISMATCH(this->_type, json_t::number_integer);
+        return _value.number_integer;
+    }
+
+    // 获取当前 JSON 对象的双精度浮点数值
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline const double basic_json<Allocator, ObjectMap>::get_double() const
+    {
+        CHECK_TYPE_MISMATCH(this->_type, json_t::number_double);
+        return _value.number_double;
+    }
+
+    // 获取当前 JSON 对象的布尔值
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline const bool basic_json<Allocator, ObjectMap>::get_bool() const
+    {
+        CHECK_TYPE_MISMATCH(this->_type, json_t::boolean);
+        return _value.boolean;
+    }
+
+    // 获取当前 JSON 对象的对象值
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline const typename basic_json<Allocator, ObjectMap>::object_t &basic_json<Allocator, ObjectMap>::get_object() const
+    {
+        CHECK_TYPE_MISMATCH(this->_type, json_t::object);
+        return *_value.object;
+    }
+
+    // 获取当前 JSON 对象的数组值
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline const typename basic_json<Allocator, ObjectMap>::array_t &basic_json<Allocator, ObjectMap>::get_array() const
+    {
+        CHECK_TYPE_MISMATCH(this->_type, json_t::array);
+        return *_value.array;
+    }
+
+    // 获取当前 JSON 对象的对象值的可修改引用
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline typename basic_json<Allocator, ObjectMap>::object_t &basic_json<Allocator, ObjectMap>::get_object()
+    {
+        CHECK_TYPE_MISMATCH(this->_type, json_t::object);
+        return *_value.object;
+    }
+
+    // 获取当前 JSON 对象的数组值的可修改引用
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline typename basic_json<Allocator, ObjectMap>::array_t &basic_json<Allocator, ObjectMap>::get_array()
+    {
+        CHECK_TYPE_MISMATCH(this->_type, json_t::array);
+        return *_value.array;
+    }
+
+    // 获取当前 JSON 对象的 null 值
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline const void *basic_json<Allocator, ObjectMap>::get_null() const
+    {
+        CHECK_TYPE_MISMATCH(this->_type, json_t::null);
+        return nullptr;
+    }
+
+    // 检查当前 JSON 对象是否包含指定名称的成员
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline bool basic_json<Allocator, ObjectMap>::has_member(string_view member_name) const
+    {
+        CHECK_TYPE_MISMATCH(this->_type, json_t::object);
+        return object_find(*_value.object, member_name) != _value.object->end();
+    }
+
+    // 查找对象的成员，只查找一次
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline const basic_json<Allocator, ObjectMap> *basic_json<Allocator, ObjectMap>::find(string_view key) const
+    {
+        if (_type != json_t::object)
+        {
+            return nullptr;
+        }
+        auto it = object_find(*_value.object, key);
+        return it == _value.object->end() ? nullptr : &it->second;
+    }
+
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline basic_json<Allocator, ObjectMap> *basic_json<Allocator, ObjectMap>::find(string_view key)
+    {
+        return const_cast<basic_json *>(static_cast<const basic_json &>(*this).find(key));
+    }
+
+    // 查找数组的元素
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline const basic_json<Allocator, ObjectMap> *basic_json<Allocator, ObjectMap>::find(size_t index) const
+    {
+        if (_type != json_t::array || index >= _value.array->size())
+        {
+            return nullptr;
+        }
+        return &(*_value.array)[index];
+    }
+
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline basic_json<Allocator, ObjectMap> *basic_json<Allocator, ObjectMap>::find(size_t index)
+    {
+        return const_cast<basic_json *>(static_cast<const basic_json &>(*this).find(index));
+    }
+
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline bool basic_json<Allocator, ObjectMap>::try_get_string(string_view &out) const
+    {
+        if (_type != json_t::string)
+        {
+            return false;
+        }
+        out = get_string_view();
+        return true;
+    }
+
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline bool basic_json<Allocator, ObjectMap>::try_get_integer(long long &out) const
+    {
+        if (_type != json_t::number_integer)
+        {
+            return false;
+        }
+        out = _value.number_integer;
+        return true;
+    }
+
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline bool basic_json<Allocator, ObjectMap>::try_get_double(double &out) const
+    {
+        if (_type != json_t::number_double)
+        {
+            return false;
+        }
+        out = _value.number_double;
+        return true;
+    }
+
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline bool basic_json<Allocator, ObjectMap>::try_get_bool(bool &out) const
+    {
+        if (_type != json_t::boolean)
+        {
+            return false;
+        }
+        out = _value.boolean;
+        return true;
+    }
+
+    // 向当前 JSON 对象添加一个成员
+    // 键名和值都会转移到对象自身的分配器上（分配器相同时不发生拷贝）
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline void basic_json<Allocator, ObjectMap>::add_member(string_t member_name, basic_json member_value)
+    {
+        CHECK_TYPE_MISMATCH(this->_type, json_t::object);
+        object_t &members = *_value.object;
+        allocator_type alloc(members.get_allocator());
+
+        if (allocator_type(member_name.get_allocator()) == alloc)
+        {
+            members[std::move(member_name)] = basic_json(std::move(member_value), alloc);
+        }
+        else
+        {
+            members[make_key(member_name, members)] = basic_json(std::move(member_value), alloc);
+        }
+    }
+
+    // 向当前 JSON 数组添加一个元素
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline void basic_json<Allocator, ObjectMap>::add_element(basic_json elem)
+    {
+        CHECK_TYPE_MISMATCH(this->_type, json_t::array);
+        array_t &elems = *_value.array;
+        elems.emplace_back(std::move(elem), allocator_type(elems.get_allocator()));
+    }
+
+    // 获取当前 JSON 对象的大小
+    // 如果当前类型是数组或对象，返回数组的长度或对象的成员数
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline size_t basic_json<Allocator, ObjectMap>::size() const
+    {
+        if (_type == json_t::array)
+        {
+            // 如果是数组类型，返回数组的大小
+            return _value.array->size();
+        }
+        else if (_type == json_t::object)
+        {
+            // 如果是对象类型，返回对象的成员数量
+            return _value.object->size();
+        }
+
+        // 如果不是数组或对象类型，抛出异常
+        TINYJSON_THROW(std::runtime_error("Unexpected json type " + type_name() + ", expected array or object"));
+    }
+
+    // 重载对象类型的 JSON 对象的下标运算符
+    // 如果当前类型不是对象类型，则抛出异常
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline basic_json<Allocator, ObjectMap> &basic_json<Allocator, ObjectMap>::operator[](const char *key)
+    {
+        return const_cast<basic_json &>(static_cast<const basic_json &>(*this)[key]);
+    }
+
+    // 只读访问对象的成员，只查找一次
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline const basic_json<Allocator, ObjectMap> &basic_json<Allocator, ObjectMap>::operator[](const char *key) const
+    {
+        CHECK_TYPE_MISMATCH(this->_type, json_t::object);
+        const object_t *members = _value.object;
+
+        // 通过键名访问对象中的成员
+        auto it = object_find(*members, key);
+        if (it == members->end())
+        {
+            TINYJSON_THROW(std::runtime_error("key " + std::string(key) + " not found."));
+        }
+
+        return it->second;
+    }
+
+    // 重载数组类型的 JSON 对象的下标运算符
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline basic_json<Allocator, ObjectMap> &basic_json<Allocator, ObjectMap>::operator[](int index)
+    {
+        return const_cast<basic_json &>(static_cast<const basic_json &>(*this)[index]);
+    }
+
+    // 只读访问数组的元素
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline const basic_json<Allocator, ObjectMap> &basic_json<Allocator, ObjectMap>::operator[](int index) const
+    {
+        CHECK_TYPE_MISMATCH(this->_type, json_t::array);
+        const array_t *array = _value.array;
+
+        // 通过索引访问数组中的元素
+        if (index < 0 || (size_t)index >= array->size())
+        {
+            TINYJSON_THROW(std::runtime_error("index " + std::to_string(index) + " out of range."));
+        }
+
+        return (*array)[index];
+    }
+
+    // 析构函数
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline basic_json<Allocator, ObjectMap>::~basic_json()
+    {
+        destroy();
+    }
+
+    // 释放数据（只有字符串、数组和对象需要释放）
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline void basic_json<Allocator, ObjectMap>::destroy()
+    {
+        switch (_type)
+        {
+        case (json_t::array):
+            dispose(_value.array);
+            break;
+        case (json_t::object):
+            dispose(_value.object);
+            break;
+        case (json_t::string):
+            if (_view_size == 0)
+            {
+                dispose(_value.string);
+            }
+            break;
+        default:
+            break;
+        }
+
+        _type = json_t::null;
+    }
+
+    // 类型转换运算符，将 json 对象转换为 const std::string 类型
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline basic_json<Allocator, ObjectMap>::operator const std::string() const
+    {
+        switch (_type)
+        {
+        case json_t::string:
+        {
+            string_view val = get_string_view();
+            return std::string(val.data(), val.size());
+        }
+        default:
+            TINYJSON_THROW(std::runtime_error("cannot cast " + type_name() + " to json string"));
+        }
+    }
+
+    // 类型转换运算符，将 json 对象转换为 const double 类型
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline basic_json<Allocator, ObjectMap>::operator const double() const
+    {
+        switch (_type)
+        {
+        case json_t::number_double:
+            return _value.number_double;
+        default:
+            TINYJSON_THROW(std::runtime_error("cannot cast " + type_name() + " to json number"));
+        }
+    }
+
+    // 类型转换运算符，将 json 对象转换为 const long long 类型
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline basic_json<Allocator, ObjectMap>::operator const long long() const
+    {
+        switch (_type)
+        {
+        case json_t::number_integer:
+            return _value.number_integer;
+        default:
+            TINYJSON_THROW(std::runtime_error("cannot cast " + type_name() + " to json number"));
+        }
+    }
+
+    // 类型转换运算符，将 json 对象转换为 const bool 类型
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline basic_json<Allocator, ObjectMap>::operator const bool() const
+    {
+        switch (_type)
+        {
+        case json_t::boolean:
+            return _value.boolean;
+        default:
+            TINYJSON_THROW(std::runtime_error("cannot cast " + type_name() + " to json boolean"));
+        }
+    }
+    // 将当前 JSON 对象转换为字符串表示
+    // 先计算精确长度，再一次性分配并写入
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline const std::string basic_json<Allocator, ObjectMap>::to_string() const
+    {
+        std::string out;
+        out.reserve(dump_size());
+        dump(out);
+        return out;
+    }
+
+    // 序列化当前 JSON 值到 sink
+    // 对象和数组递归写入子元素，所有输出都直接进入 sink
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    template <class Sink>
+    inline void basic_json<Allocator, ObjectMap>::dump(Sink &sink) const
+    {
+        switch (type())
+        {
+        case json_t::object:
+        {
+            sink.put('{'); // 输出对象开始标志 {
+            const object_t &jobj = *_value.object;
+            for (auto it = jobj.begin(); it != jobj.end(); ++it)
+            {
+                if (it != jobj.begin())
+                    sink.put(','); // 成员之间输出分隔符 ,
+                write_string(sink, string_view(it->first.data(), it->first.size())); // 输出键名，并加双引号
+                sink.write(" : ", 3);                                              // 输出键值对分隔符 :
+                it->second.dump(sink);
+            }
+            sink.put('}'); // 输出对象结束标志 }
+            break;
+        }
+
+        case json_t::array:
+        {
+            sink.put('['); // 输出数组开始标志 [
+            const array_t &jarray = *_value.array;
+            for (auto it = jarray.begin(); it != jarray.end(); ++it)
+            {
+                if (it != jarray.begin())
+                    sink.put(','); // 元素之间输出分隔符 ,
+                it->dump(sink);
+            }
+            sink.put(']'); // 输出数组结束标志 ]
+            break;
+        }
+
+        case json_t::string:
+            // 字符串两侧添加双引号
+            write_string(sink, get_string_view());
+            break;
+
+        case json_t::number_integer:
+        {
+            // 在栈上的缓冲区中格式化，不分配内存
+            char buf[24];
+            char *end = buf + sizeof(buf);
+            char *begin = format_integer(_value.number_integer, end);
+            sink.write(begin, static_cast<size_t>(end - begin));
+            break;
+        }
+
+        case json_t::number_double:
+        {
+            char buf[double_buffer_size];
+            sink.write(buf, format_double(_value.number_double, buf));
+            break;
+        }
+
+        case json_t::boolean:
+            // 根据布尔值输出 "true" 或 "false"
+            if (_value.boolean)
+                sink.write("true", 4);
+            else
+                sink.write("false", 5);
+            break;
+
+        case json_t::null:
+            sink.write("null", 4);
+            break;
+
+        default:
+            // 如果遇到无效的 JSON 类型，抛出异常
+            TINYJSON_THROW(std::runtime_error("invalid json type"));
+        }
+    }
+
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline void basic_json<Allocator, ObjectMap>::dump(std::string &out) const
+    {
+        TINYJSON_STAT_TIMER(serialize_ns);
+        string_sink<std::string> sink(out);
+        dump(sink);
+    }
+
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline void basic_json<Allocator, ObjectMap>::dump(std::ostream &os) const
+    {
+        TINYJSON_STAT_TIMER(serialize_ns);
+        ostream_sink sink(os);
+        dump(sink);
+    }
+
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline size_t basic_json<Allocator, ObjectMap>::dump_size() const
+    {
+        counting_sink sink;
+        dump(sink);
+        return sink.count();
+    }
+
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline const std::string basic_json<Allocator, ObjectMap>::to_string(const dump_options &options) const
+    {
+        std::string out;
+        out.reserve(dump_size(options));
+        dump(out, options);
+        return out;
+    }
+
+    // 按 options 序列化当前 JSON 值到 sink
+    // 只有对象和数组受格式影响，标量直接交给 dump(sink)；空的对象和数组总是输出为 {} 和 []
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    template <class Sink>
+    inline void basic_json<Allocator, ObjectMap>::dump(Sink &sink, const dump_options &options) const
+    {
+        json_writer<Sink> writer(sink, options);
+        writer.write(*this);
+    }
+
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline void basic_json<Allocator, ObjectMap>::dump(std::string &out, const dump_options &options) const
+    {
+        TINYJSON_STAT_TIMER(serialize_ns);
+        string_sink<std::string> sink(out);
+        dump(sink, options);
+    }
+
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline void basic_json<Allocator, ObjectMap>::dump(std::ostream &os, const dump_options &options) const
+    {
+        TINYJSON_STAT_TIMER(serialize_ns);
+        ostream_sink sink(os);
+        dump(sink, options);
+    }
+
+    template <class Allocator, template <class, class, class, class> class ObjectMap>
+    inline size_t basic_json<Allocator, ObjectMap>::dump_size(const dump_options &options) const
+    {
+        counting_sink sink;
+        dump(sink, options);
+        return sink.count();
+    }
+
+    // 单调增长的内存区（arena）
+    // 分配只需移动指针；单个对象的释放只回收最近一次分配，
+    // 其余内存在 reset()/release() 时按块整体归还
+    class arena
+    {
+    public:
+        explicit arena(size_t initial_block_size = 4096)
+            : _head(nullptr), _cur(nullptr), _end(nullptr),
+              _initial_block_size(initial_block_size < 64 ? 64 : initial_block_size),
+              _next_block_size(_initial_block_size), _bytes_allocated(0) {}
+
+        ~arena() { release(); }
+
+        arena(const arena &) = delete;
+        arena &operator=(const arena &) = delete;
+
+        /// 分配 size 字节，按 alignment 对齐
+        void *allocate(size_t size, size_t alignment)
+        {
+            char *p = align_up(_cur, alignment);
+            if (_cur == nullptr || p + size > _end)
+            {
+                add_block(size + alignment);
+                p = align_up(_cur, alignment);
+            }
+
+            _cur = p + size;
+            _bytes_allocated += size;
+            return p;
+        }
+
+        /// 只有最近一次分配的内存可以立即回收（例如 vector 扩容前的旧缓冲区），其余忽略
+        void deallocate(void *p, size_t size)
+        {
+            if (static_cast<char *>(p) + size == _cur)
+            {
+                _cur = static_cast<char *>(p);
+                _bytes_allocated -= size;
+            }
+        }
+
+        /// 归还除最近一块以外的全部内存块，保留的块可被后续分配复用
+        void reset()
+        {
+            if (_head == nullptr)
+                return;
+
+            block *keep = _head;
+            free_blocks(keep->prev);
+            keep->prev = nullptr;
+            _cur = reinterpret_cast<char *>(keep + 1);
+            _bytes_allocated = 0;
+        }
+
+        /// 归还全部内存块
+        void release()
+        {
+            free_blocks(_head);
+            _head = nullptr;
+            _cur = _end = nullptr;
+            _next_block_size = _initial_block_size;
+            _bytes_allocated = 0;
+        }
+
+        /// 已分配给调用者的字节数
+        size_t bytes_allocated() const { return _bytes_allocated; }
+
+        /// 从系统申请的字节数
+        size_t bytes_reserved() const
+        {
+            size_t total = 0;
+            for (block *b = _head; b != nullptr; b = b->prev)
+                total += b->size;
+            return total;
+        }
+
+    private:
+        /// 每个内存块头部记录前一块和本块大小，块之间组成单链表
+        struct block
+        {
+            block *prev;
+            size_t size;
+        };
+
+        static char *align_up(char *p, size_t alignment)
+        {
+            uintptr_t v = reinterpret_cast<uintptr_t>(p);
+            return reinterpret_cast<char *>((v + alignment - 1) & ~(uintptr_t)(alignment - 1));
+        }
+
+        // 申请一个至少能容纳 min_size 字节的新块，块大小按倍数增长
+        void add_block(size_t min_size)
+        {
+            size_t size = _next_block_size;
+            while (size < min_size + sizeof(block))
+                size *= 2;
+            _next_block_size = size * 2;
+
+            block *b = static_cast<block *>(::operator new(size));
+            b->prev = _head;
+            b->size = size;
+            _head = b;
+            _cur = reinterpret_cast<char *>(b + 1);
+            _end = reinterpret_cast<char *>(b) + size;
+        }
+
+        static void free_blocks(block *b)
+        {
+            while (b != nullptr)
+            {
+                block *prev = b->prev;
+                ::operator delete(b);
+                b = prev;
+            }
+        }
+
+        block *_head;               ///< 最近申请的内存块
+        char *_cur;                 ///< 当前块中下一次分配的位置
+        char *_end;                 ///< 当前块的结束位置
+        size_t _initial_block_size; ///< 第一个内存块的大小
+        size_t _next_block_size;    ///< 下一个内存块的大小
+        size_t _bytes_allocated;    ///< 已分配给调用者的字节数
+    };
+
+    // 从 arena 分配内存的分配器
+    // 未绑定 arena（默认构造）时退回全局堆，因此 basic_json 的便捷构造函数仍然可用；
+    // 绑定同一个 arena 的分配器相等，数据可以在它们之间直接移动
+    template <class T>
+    class arena_allocator
+    {
+    public:
+        using value_type = T;
+
+        template <class U>
+        struct rebind
+        {
+            using other = arena_allocator<U>;
+        };
+
+        arena_allocator() noexcept : _arena(nullptr) {}
+        explicit arena_allocator(arena *a) noexcept : _arena(a) {}
+
+        template <class U>
+        arena_allocator(const arena_allocator<U> &other) noexcept : _arena(other.get_arena()) {}
+
+        T *allocate(size_t n)
+        {
+            if (_arena != nullptr)
+            {
+                return static_cast<T *>(_arena->allocate(n * sizeof(T), alignof(T)));
+            }
+            return static_cast<T *>(::operator new(n * sizeof(T)));
+        }
+
+        void deallocate(T *p, size_t n) noexcept
+        {
+            if (_arena != nullptr)
+            {
+                _arena->deallocate(p, n * sizeof(T));
+            }
+            else
+            {
+                ::operator delete(p);
+            }
+        }
+
+        arena *get_arena() const noexcept { return _arena; }
+
+    private:
+        arena *_arena; ///< 为 nullptr 时使用全局堆
+    };
+
+    template <class T, class U>
+    inline bool operator==(const arena_allocator<T> &a, const arena_allocator<U> &b) noexcept
+    {
+        return a.get_arena() == b.get_arena();
+    }
+
+    template <class T, class U>
+    inline bool operator!=(const arena_allocator<T> &a, const arena_allocator<U> &b) noexcept
+    {
+        return !(a == b);
+    }
+
+    // 所有数据都存放在 arena 中的 JSON 值
+    using arena_json = basic_json<arena_allocator<char>>;
+
+    // 拥有一个 arena 的 JSON 文档
+    // 节点、字符串、数组和对象的存储全部从文档的 arena 分配，销毁或 clear() 时整块归还内存
+    // 归还前会析构根节点：arena 中的节点析构时不释放任何内存，只是遍历一遍；
+    // 通过 operator= 赋值进来、仍在全局堆上的值（例如默认分配器创建的 arena_json）借此正常释放
+    // 要把值放到文档的 arena 上，使用 set_root() 或用 get_allocator() 创建它
+    // 注意：文档中的值只在文档存活期间有效；被移动后的文档没有根节点，只能 clear() 或重新解析后再使用
+    class document
+    {
+    public:
+        using json_type = arena_json;
+        using allocator_type = arena_json::allocator_type;
+
+        explicit document(size_t initial_block_size = 4096)
+            : _arena(new arena(initial_block_size)), _root(nullptr), _block_size(initial_block_size)
+        {
+            reset_root();
+        }
+
+        ~document() { destroy_root(); }
+
+        document(document &&other) noexcept
+            : _arena(std::move(other._arena)), _root(other._root), _block_size(other._block_size)
+        {
+            other._root = nullptr;
+        }
+
+        document &operator=(document &&other) noexcept
+        {
+            if (this != &other)
+            {
+                destroy_root();
+                _arena = std::move(other._arena);
+                _root = other._root;
+                _block_size = other._block_size;
+                other._root = nullptr;
+            }
+            return *this;
+        }
+
+        document(const document &) = delete;
+        document &operator=(const document &) = delete;
+
+        /// 文档的根节点，文档被移动后抛出 std::logic_error
+        json_type &root()
+        {
+            check_root();
+            return *_root;
+        }
+        const json_type &root() const
+        {
+            check_root();
+            return *_root;
+        }
+
+        /// 把 value 转移到文档的 arena 上作为新的根节点（分配器不同时复制一份）
+        json_type &set_root(json_type value)
+        {
+            root() = json_type(std::move(value), get_allocator());
+            return *_root;
+        }
+
+        /// 绑定到文档 arena 的分配器，用于创建要放入文档的值
+        allocator_type get_allocator() const { return allocator_type(_arena.get()); }
+
+        /// 一次性归还所有节点占用的内存（保留一个内存块供复用），根节点重置为 null
+        /// 被移动后的文档会重新创建 arena，之后可以继续使用
+        void clear()
+        {
+            destroy_root();
+            if (_arena)
+            {
+                _arena->reset();
+            }
+            else
+            {
+                _arena.reset(new arena(_block_size));
+            }
+            reset_root();
+        }
+
+        /// 文档当前从系统申请的内存字节数，被移动后为 0
+        size_t memory_usage() const { return _arena ? _arena->bytes_reserved() : 0; }
+
+    private:
+        // 在 arena 中构造一个 null 根节点
+        void reset_root()
+        {
+            void *p = _arena->allocate(sizeof(json_type), alignof(json_type));
+            _root = ::new (p) json_type();
+        }
+
+        // 析构根节点，释放其中不在 arena 上的数据
+        void destroy_root() noexcept
+        {
+            if (_root != nullptr)
+            {
+                _root->~json_type();
+                _root = nullptr;
+            }
+        }
+
+        void check_root() const
+        {
+            if (_root == nullptr)
+            {
+                TINYJSON_THROW(std::logic_error("document has been moved from"));
+            }
+        }
+
+        std::unique_ptr<arena> _arena; ///< 文档拥有的 arena，移动文档时节点地址不变
+        json_type *_root;              ///< 根节点，同样存放在 arena 中
+        size_t _block_size;            ///< 创建 arena 时的初始块大小
+    };
+
+    // 直接在 UTF-8 字节序列上移动的只读游标
+    // 不做编码转换，多字节序列只在字符串内部校验
+    struct byte_cursor
+    {
+        const char *cur;              ///< 当前读取位置
+        const char *end;              ///< 输入结束位置（不包含）
+        const char *begin;            ///< 输入开始位置，用于计算出错的位置
+        bool insitu = false;          ///< 输入可写：含转义的字符串就地解码并写回输入
+        parse_error *error = nullptr; ///< 不为空时错误写入这里而不抛出异常，解析函数随即逐层返回 false
+        size_t depth = 0;             ///< 当前所在的对象和数组的层数
+
+        byte_cursor(const char *b, size_t length) : cur(b), end(b + length), begin(b) {}
+
+        /// 是否已经记录了错误
+        bool failed() const { return error != nullptr && error->code != parse_errc::none; }
+
+        /// 查看当前字节，到达末尾时返回 EOF
+        int peek() const { return cur < end ? static_cast<unsigned char>(*cur) : EOF; }
+
+        /// 读取当前字节并前进，到达末尾时返回 EOF
+        int get() { return cur < end ? static_cast<unsigned char>(*cur++) : EOF; }
+    };
+
+    // 报告字节级解析中的错误，位置为游标的当前位置；游标已经到达输入末尾时报告为 unexpected_end
+    // 游标带有 error 时只记录第一个错误并返回 false，否则抛出 parse_exception
+    TINYJSON_COLD inline bool parse_fail(byte_cursor &cursor, parse_errc code)
+    {
+        if (cursor.cur >= cursor.end && code != parse_errc::number_out_of_range && code != parse_errc::depth_exceeded)
+        {
+            code = parse_errc::unexpected_end;
+        }
+        parse_error err = parse_error::at(code, cursor.begin, cursor.cur < cursor.end ? cursor.cur : cursor.end);
+        if (cursor.error == nullptr)
+        {
+            TINYJSON_THROW(parse_exception(err));
+        }
+        if (!cursor.failed())
+        {
+            *cursor.error = err;
+        }
+        return false;
+    }
+
+    // 进入一层对象或数组，层数超过 TINYJSON_MAX_DEPTH 时报告 depth_exceeded；离开时由调用者减少 cursor.depth
+    inline bool enter_nested(byte_cursor &cursor)
+    {
+        if (cursor.depth >= TINYJSON_MAX_DEPTH)
+        {
+            return parse_fail(cursor, parse_errc::depth_exceeded);
+        }
+        ++cursor.depth;
+        return true;
+    }
+
+    // 以只读方式把整个文件映射到内存；不支持 mmap 时把文件一次性读入内存
+    // 数据在对象销毁前一直有效，解析结果中的字符串视图（例如 lazy_document）可以直接指向它
+    class mapped_file
+    {
+    public:
+        explicit mapped_file(const char *path) : _data(nullptr), _size(0), _mapped(false) { open(path); }
+        explicit mapped_file(const std::string &path) : mapped_file(path.c_str()) {}
+        ~mapped_file() { close(); }
+
+        mapped_file(mapped_file &&other) noexcept
+            : _data(other._data), _size(other._size), _mapped(other._mapped), _buffer(std::move(other._buffer))
+        {
+            other._data = nullptr;
+            other._size = 0;
+            other._mapped = false;
+        }
+
+        mapped_file &operator=(mapped_file &&other) noexcept
+        {
+            if (this != &other)
+            {
+                close();
+                _data = other._data;
+                _size = other._size;
+                _mapped = other._mapped;
+                _buffer = std::move(other._buffer);
+                other._data = nullptr;
+                other._size = 0;
+                other._mapped = false;
+            }
+            return *this;
+        }
+
+        mapped_file(const mapped_file &) = delete;
+        mapped_file &operator=(const mapped_file &) = delete;
+
+        /// 文件内容，不以 NUL 结尾
+        const char *data() const { return _mapped ? _data : _buffer.data(); }
+        /// 可写的文件内容：映射是私有的（写时复制），修改只影响本进程中的这份数据，不会写回文件
+        /// 用于原位解析，见 basic_parser::parse_insitu(mapped_file &)
+        char *data() { return _mapped ? _data : _buffer.data(); }
+        size_t size() const { return _size; }
+
+        /// 是否通过 mmap 映射（否则为读入内存的副本）
+        bool is_mapped() const { return _mapped; }
+
+    private:
+        void open(const char *path)
+        {
+#if defined(TINYJSON_MMAP)
+            int fd = ::open(path, O_RDONLY);
+            if (fd < 0)
+            {
+                TINYJSON_THROW(std::runtime_error(std::string("cannot open file ") + path));
+            }
+            struct stat st;
+            if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0)
+            {
+                // 私有的可写映射：只读打开的文件同样可以映射，写入的页面在进程内复制，不会写回文件
+                void *p = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+                if (p != MAP_FAILED)
+                {
+#if defined(MADV_SEQUENTIAL)
+                    ::madvise(p, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL); // 解析按顺序读取
+#endif
+                    ::close(fd);
+                    _data = static_cast<char *>(p);
+                    _size = static_cast<size_t>(st.st_size);
+                    _mapped = true;
+                    return;
+                }
+            }
+            ::close(fd); // 空文件、管道等无法映射的文件改为读入内存
+#endif
+            read(path);
+        }
+
+        // 把文件全部读入 _buffer；移动 mapped_file 时 vector 的存储地址不变，借用它的字符串仍然有效
+        void read(const char *path)
+        {
+            std::FILE *f = std::fopen(path, "rb");
+            if (f == nullptr)
+            {
+                TINYJSON_THROW(std::runtime_error(std::string("cannot open file ") + path));
+            }
+            char chunk[65536];
+            size_t n;
+            while ((n = std::fread(chunk, 1, sizeof(chunk), f)) != 0)
+            {
+                _buffer.insert(_buffer.end(), chunk, chunk + n);
+            }
+            bool failed = std::ferror(f) != 0;
+            std::fclose(f);
+            if (failed)
+            {
+                TINYJSON_THROW(std::runtime_error(std::string("cannot read file ") + path));
+            }
+            _size = _buffer.size();
+        }
+
+        void close()
+        {
+#if defined(TINYJSON_MMAP)
+            if (_mapped)
+            {
+                ::munmap(_data, _size);
+            }
+#endif
+            _data = nullptr;
+            _size = 0;
+            _mapped = false;
+            _buffer.clear();
+        }
+
+        char *_data;               ///< 映射的地址
+        size_t _size;              ///< 文件的字节数
+        bool _mapped;              ///< 是否通过 mmap 映射
+        std::vector<char> _buffer; ///< 无法映射时读入的文件内容
+    };
+
+    // SAX 事件处理器的基类，所有回调默认什么都不做
+    // 解析器按文档顺序调用回调，任一回调返回 false 时解析立即停止；
+    // 字符串参数可能指向输入或解析器内部的缓冲区，只在回调期间有效
+    // basic_parser::sax_parse 接受任何提供同名成员函数的类型，继承本类只是为了方便
+    class json_sax
+    {
+    public:
+        virtual ~json_sax() {}
+
+        virtual bool null() { return true; }                        // null
+        virtual bool boolean(bool) { return true; }                 // true 或 false
+        virtual bool number_integer(long long) { return true; }     // 整数
+        virtual bool number_double(double) { return true; }         // 浮点数
+        virtual bool string(string_view) { return true; }           // 字符串值
+        virtual bool start_object() { return true; }                // 遇到 '{'
+        virtual bool key(string_view) { return true; }              // 对象成员的键名，随后是该成员的值
+        virtual bool end_object() { return true; }                  // 遇到 '}'
+        virtual bool start_array() { return true; }                 // 遇到 '['
+        virtual bool end_array() { return true; }                   // 遇到 ']'
+    };
+
+    // 根据 SAX 事件构建 JSON 树的处理器，parser::parse 即基于它实现
+    // 只保存从根到当前容器的路径，节点全部使用构造时传入的分配器
+    template <class BasicJson>
+    class dom_handler
+    {
+    public:
+        using json_type = BasicJson;
+        using allocator_type = typename json_type::allocator_type;
+        using string_t = typename json_type::string_t;
+        using array_t = typename json_type::array_t;
+        using object_t = typename json_type::object_t;
+
+        /// borrow_strings 为 true 时字符串值借用事件中的字符而不复制，用于原位解析
+        explicit dom_handler(const allocator_type &alloc = allocator_type(), bool borrow_strings = false)
+            : _alloc(alloc), _stack(typename stack_t::allocator_type(alloc)), _key(alloc),
+              _proto(typename object_t::allocator_type(alloc)), _borrow(borrow_strings) {}
+
+        bool null()
+        {
+            add(json_type());
+            return true;
+        }
+
+        bool boolean(bool val)
+        {
+            add(json_type(val));
+            return true;
+        }
+
+        bool number_integer(long long val)
+        {
+            add(json_type(val));
+            return true;
+        }
+
+        bool number_double(double val)
+        {
+            add(json_type(val));
+            return true;
+        }
+
+        bool string(string_view val)
+        {
+            add(_borrow ? json_type(borrow, val) : json_type(val, _alloc));
+            return true;
+        }
+
+        /// 总是复制字符串值，用于借用模式下不在输入中、只是临时拼接出来的字符串
+        bool copy_string(string_view val)
+        {
+            add(json_type(val, _alloc));
+            return true;
+        }
+
+        bool start_object()
+        {
+            _stack.push_back(&add(json_type{object_like(_proto, typename object_t::allocator_type(_alloc))}));
+            TINYJSON_STAT_MAX(max_depth, _stack.size());
+            return true;
+        }
+
+        bool key(string_view name)
+        {
+            _key.assign(name.data(), name.size());
+            return true;
+        }
+
+        bool end_object()
+        {
+            _stack.pop_back();
+            return true;
+        }
+
+        bool start_array()
+        {
+            _stack.push_back(&add(json_type{array_t(_alloc)}));
+            TINYJSON_STAT_MAX(max_depth, _stack.size());
+            return true;
+        }
+
+        bool end_array()
+        {
+            _stack.pop_back();
+            return true;
+        }
+
+        /// 构建完成的根节点
+        json_type &result() { return _root; }
+
+        /// 丢弃已构建的内容
+        void clear()
+        {
+            _root = json_type();
+            _stack.clear();
+        }
+
+    private:
+        // 将值放入当前容器（没有容器时作为根节点），返回其在树中的位置
+        // 容器在其子节点结束前不会再增长，因此栈中保存的地址始终有效
+        json_type &add(json_type &&val)
+        {
+            TINYJSON_STAT_ADD(nodes_created, 1);
+            if (_stack.empty())
+            {
+                _root = std::move(val);
+                return _root;
+            }
+
+            json_type &parent = *_stack.back();
+            if (parent.type() == json_t::array)
+            {
+                array_t &elems = parent.get_array();
+                elems.push_back(std::move(val));
+                return elems.back();
+            }
+
+            // 重复的键名与 add_member 一致，后出现的值覆盖前面的值
+            // _key 作为缓冲区反复使用，键名驻留的对象可以直接在池中找到已有的键名
+            json_type &slot = parent.get_object()[_key];
+            slot = std::move(val);
+            return slot;
+        }
+
+        using stack_t = std::vector<json_type *, rebind_alloc<allocator_type, json_type *>>;
+
+        allocator_type _alloc;           ///< 所有节点使用的分配器
+        json_type _root;                 ///< 根节点
+        stack_t _stack;                  ///< 从根到当前容器的路径，同样使用节点的分配器
+        string_t _key;                   ///< 等待对应值的键名
+        object_t _proto;                 ///< 新对象的原型，同一次解析的对象共享它的上下文（如键名池）
+        bool _borrow;                    ///< 字符串值是否借用输入中的字符
+    };
+
+    template <class Handler>
+    class sax_push_parser;
+
+    // JSON 解析器
+    // BasicJson 为解析结果的类型，字节级解析的全部节点都使用调用者传入的分配器
+    template <class BasicJson>
+    class basic_parser
+    {
+    public:
+        using json_type = BasicJson;
+        using allocator_type = typename json_type::allocator_type;
+        using string_t = typename json_type::string_t;
+        using array_t = typename json_type::array_t;
+        using object_t = typename json_type::object_t;
+
+        // 从 UTF-8 编码的字符串解析 JSON 对象
+        static json_type parse(const char *s, const allocator_type &alloc = allocator_type())
+        {
+            return parse(s, std::char_traits<char>::length(s), alloc);
+        }
+
+        // 从 UTF-8 编码的字符串解析 JSON 对象
+        static json_type parse(const std::string &s, const allocator_type &alloc = allocator_type())
+        {
+            return parse(s.data(), s.size(), alloc);
+        }
+
+        // 从指定长度的 UTF-8 字节序列解析 JSON 对象，输入无需以 NUL 结尾
+        static json_type parse(const char *s, size_t length, const allocator_type &alloc = allocator_type())
+        {
+            dom_handler<json_type> handler(alloc);
+            sax_parse(s, length, handler);
+            return std::move(handler.result()); // 返回解析后的 JSON 对象
+        }
+
+        // 不抛出异常的解析：格式错误时返回 null，并把错误的种类和位置写入 error；成功时 error 被清空
+        static json_type parse(const char *s, size_t length, parse_error &error, const allocator_type &alloc = allocator_type())
+        {
+            dom_handler<json_type> handler(alloc);
+            if (!sax_parse(s, length, handler, error))
+            {
+                return json_type();
+            }
+            return std::move(handler.result());
+        }
+
+        static json_type parse(const std::string &s, parse_error &error, const allocator_type &alloc = allocator_type())
+        {
+            return parse(s.data(), s.size(), error, alloc);
+        }
+
+        static json_type parse(const char *s, parse_error &error, const allocator_type &alloc = allocator_type())
+        {
+            return parse(s, std::char_traits<char>::length(s), error, alloc);
+        }
+
+        // 原位解析可写的缓冲区：含转义的字符串就地解码，字符串值借用缓冲区中的字符而不复制
+        // 缓冲区的内容会被改写，并且必须在结果（及其拷贝）的整个生命周期内保持有效；键名仍然复制到对象中
+        static json_type parse_insitu(char *s, size_t length, const allocator_type &alloc = allocator_type())
+        {
+            dom_handler<json_type> handler(alloc, true);
+            byte_cursor cursor(s, length);
+            cursor.insitu = true;
+            sax_parse(cursor, handler);
+            return std::move(handler.result());
+        }
+
+        static json_type parse_insitu(std::string &s, const allocator_type &alloc = allocator_type())
+        {
+            return parse_insitu(&s[0], s.size(), alloc);
+        }
+
+        // 解析文件：文件被映射到内存后直接在映射的字节上解析，不经过中间的字符串或流
+        static json_type parse_file(const char *path, const allocator_type &alloc = allocator_type())
+        {
+            mapped_file file(path);
+            return parse(file.data(), file.size(), alloc);
+        }
+
+        static json_type parse_file(const std::string &path, const allocator_type &alloc = allocator_type())
+        {
+            return parse_file(path.c_str(), alloc);
+        }
+
+        // 直接在文件的私有映射上原位解析，字符串值借用映射中的字节；file 必须在结果的整个生命周期内保持有效
+        static json_type parse_insitu(mapped_file &file, const allocator_type &alloc = allocator_type())
+        {
+            return parse_insitu(file.data(), file.size(), alloc);
+        }
+
+        /// 原位解析文件的结果：映射与解析结果保存在一起，字符串值借用 file 中的字节
+        /// 整体移动后借用仍然有效（映射和读入的缓冲区的地址都不随 mapped_file 移动）
+        struct mapped_json
+        {
+            mapped_file file; ///< 文件的私有映射，原位解码会改写其中的字节，但不会写回文件
+            json_type root;   ///< 解析结果，必须先于 file 销毁
+        };
+
+        // 以借用方式解析文件：映射文件后原位解析，字符串值不复制
+        static mapped_json parse_file(const char *path, borrow_t, const allocator_type &alloc = allocator_type())
+        {
+            mapped_json result{mapped_file(path), json_type()};
+            result.root = parse_insitu(result.file, alloc);
+            return result;
+        }
+
+        static mapped_json parse_file(const std::string &path, borrow_t, const allocator_type &alloc = allocator_type())
+        {
+            return parse_file(path.c_str(), borrow, alloc);
+        }
+
+        // 以 SAX 方式解析 UTF-8 字节序列，按文档顺序调用 handler 的回调而不构建 JSON 树
+        // 除输入本身外只占用与嵌套深度成正比的内存；根节点必须是对象或数组
+        // handler 的回调返回 false 时停止解析并返回 false，格式错误时抛出异常
+        template <class Handler>
+        static bool sax_parse(const char *s, size_t length, Handler &handler)
+        {
+            byte_cursor cursor(s, length);
+            return sax_parse(cursor, handler);
+        }
+
+        // 不抛出异常的 SAX 解析：格式错误时返回 false 并写入 error，handler 中止时返回 false 而 error 保持为空
+        template <class Handler>
+        static bool sax_parse(const char *s, size_t length, Handler &handler, parse_error &error)
+        {
+            error = parse_error();
+            byte_cursor cursor(s, length);
+            cursor.error = &error;
+            return sax_parse(cursor, handler);
+        }
+
+        template <class Handler>
+        static bool sax_parse(const std::string &s, Handler &handler, parse_error &error)
+        {
+            return sax_parse(s.data(), s.size(), handler, error);
+        }
+
+        // 从游标处解析一个完整的文档，解析结束后游标之后只能有空白
+        template <class Handler>
+        static bool sax_parse(byte_cursor &cursor, Handler &handler)
+        {
+            TINYJSON_STAT_TIMER(parse_ns);
+            TINYJSON_STAT_ADD(bytes_parsed, static_cast<uint64_t>(cursor.end - cursor.cur));
+            std::string scratch;                          // 解码转义字符串的缓冲区
+            int first_char = peek_next_non_space(cursor); // 查看第一个非空白字符
+
+            // 根据第一个非空白字符判断 JSON 的类型
+            bool completed;
+            if (first_char == '{')
+            {
+                completed = sax_object(cursor, handler, scratch); // 解析对象
+            }
+            else if (first_char == '[')
+            {
+                completed = sax_array(cursor, handler, scratch); // 解析数组
+            }
+            else
+            {
+                return parse_fail(cursor, parse_errc::invalid_root); // 格式错误
+            }
+
+            if (!completed)
+            {
+                return false; // 被 handler 中止或者格式错误
+            }
+
+            // 预期解析结束后应到达输入末尾
+            if (peek_next_non_space(cursor) != EOF)
+            {
+                return parse_fail(cursor, parse_errc::trailing_characters); // 格式错误
+            }
+
+            return true;
+        }
+
+        template <class Handler>
+        static bool sax_parse(const char *s, Handler &handler)
+        {
+            return sax_parse(s, std::char_traits<char>::length(s), handler);
+        }
+
+        template <class Handler>
+        static bool sax_parse(const std::string &s, Handler &handler)
+        {
+            return sax_parse(s.data(), s.size(), handler);
+        }
+
+        // 解析到 arena 文档中，全部节点都从文档的 arena 分配，返回文档的根节点
+        static arena_json &parse(const char *s, size_t length, document &doc)
+        {
+            doc.clear();
+            doc.root() = basic_parser<arena_json>::parse(s, length, doc.get_allocator());
+            return doc.root();
+        }
+
+        static arena_json &parse(const char *s, document &doc)
+        {
+            return parse(s, std::char_traits<char>::length(s), doc);
+        }
+
+        static arena_json &parse(const std::string &s, document &doc)
+        {
+            return parse(s.data(), s.size(), doc);
+        }
+
+        // 从字节流解析 JSON 对象（逐码点的 UTF-32 流式解析，作为后备路径）
+        static json_type parse(std::istream &strm)
+        {
+            // 读出全部输入并直接解码为 UTF-32，以便逐字符解析
+            std::string bytes((std::istreambuf_iterator<char>(strm)), std::istreambuf_iterator<char>());
+            u32_sstream u32strm(U8ToU32(bytes));
+            return parse(u32strm);
+        }
+
+        // 从 UTF-32 字符流解析 JSON 对象
+        static json_type parse(u32_istream &u32strm)
+        {
+            json_type ret_val;                                       // 用于存储解析后的 JSON 值
+            char32_t first_char = peek_next_non_space(u32strm); // 查看第一个非空白字符
+
+            // 根据第一个非空白字符判断 JSON 的类型
+            if (first_char == U'{')
+            {
+                ret_val = parse_object(u32strm); // 解析对象
+            }
+            else if (first_char == U'[')
+            {
+                ret_val = parse_array(u32strm); // 解析数组
+            }
+            else
+            {
+                TINYJSON_THROW(std::runtime_error("invalid json format")); // 格式错误
+            }
+
+            // 预期解析结束后应到达文件末尾
+            if (peek_next_non_space(u32strm) != (char32_t)EOF)
+            {
+                TINYJSON_THROW(std::runtime_error("invalid json format")); // 格式错误
+            }
+
+            return ret_val; // 返回解析后的 JSON 对象
+        }
+
+        // 解析 JSON 值
+        // depth 为外层对象和数组的层数
+        static json_type parse_value(u32_istream &strm, size_t depth = 0)
+        {
+            // 查看下一个非空白字符以确定要解析的值类型
+            switch (peek_next_non_space(strm))
+            {
+            case U'"': // 字符串
+                return parse_string(strm);
+
+            case U'[': // 数组
+                return parse_array(strm, depth);
+
+            // 数字，包括整数和浮点数
+            case U'0':
+            case U'1':
+            case U'2':
+            case U'3':
+            case U'4':
+            case U'5':
+            case U'6':
+            case U'7':
+            case U'8':
+            case U'9':
+            case U'-':
+            case U'.':
+                return parse_number(strm);
+
+            case U'{': // 对象
+                return parse_object(strm, depth);
+
+            // 布尔值
+            case U'T':
+            case U't':
+            case U'F':
+            case U'f':
+                return parse_bool(strm);
+
+            // null
+            case U'n':
+            case U'N':
+                return parse_null(strm);
+
+            default: // 遇到意外的字符
+                TINYJSON_THROW(std::runtime_error("unexpected character"));
+            }
+        }
+
+        // 解析 JSON 对象
+        static json_type parse_object(u32_istream &strm, size_t depth = 0)
+        {
+            check_depth(depth);
+            json_type return_val(object_t{}); // 创建一个空对象
+
+            // 跳过开头的 '{' 字符
+            skip_char(strm, U'{');
+
+            int c = peek_next_non_space(strm);
+            // 循环直到遇到 '}'
+            while (c != EOF)
+            {
+                if (c == U'"')
+                {                                            // 键名是字符串
+                    std::string member = parse_member(strm); // 解析成员键名
+
+                    skip_char(strm, U':'); // 跳过冒号
+
+                    return_val.add_member(std::move(member), parse_value(strm, depth + 1)); // 解析并添加成员值
+                }
+                else if (c == U'}')
+                {
+                    break; // 遇到 '}', 结束对象解析
+                }
+                else if (c == U',')
+                {
+                    // 跳过逗号，继续解析下一个成员
+                    c = get_next_non_space(strm);
+                }
+                else
+                {
+                    TINYJSON_THROW(std::runtime_error("invalid object format")); // 对象格式错误
+                }
+
+                c = peek_next_non_space(strm); // 查看下一个非空白字符
+            }
+
+            skip_char(strm, U'}'); // 跳过结尾的 '}' 字符
+
+            return return_val; // 返回解析后的对象
+        }
+
+        // 解析 JSON 成员（键）
+        static std::string parse_member(u32_istream &strm)
+        {
+            std::u32string returnVal;
+
+            // 跳过开头的双引号
+            skip_char(strm, U'"');
+
+            unsigned int c = strm.peek(); // 查看当前字符
+            while (c != (unsigned int)EOF && c != U'"')
+            { // 当不是文件结束且不是双引号时循环
+                if (c == U'\\')
+                {
+                    // 转义字符
+                    returnVal.push_back(escape_char(strm));
+                }
+                else
+                {
+                    c = strm.get(); // 获取当前字符
+                    returnVal.push_back(c);
+                }
+
+                c = strm.peek(); // 再次查看当前字符
+            }
+
+            // 跳过结尾的双引号
+            skip_char(strm, U'"');
+
+            return U32ToU8(returnVal); // 将 UTF-32 字符串转换为 UTF-8 字符串
+        }
+
+        // 解析 JSON 数组
+        static json_type parse_array(u32_istream &strm, size_t depth = 0)
+        {
+            check_depth(depth);
+            array_t vector_val;
+
+            // 跳过开头的 '[' 字符
+            skip_char(strm, U'[');
+            int c = peek_next_non_space(strm); // 查看下一个非空白字符
+
+            // 空数组
+            if (c == U']')
+            {
+                skip_char(strm, U']');   // 跳过结尾的 ']' 字符
+                return json_type(std::move(vector_val)); // 返回空数组
+            }
+
+            do
+            {
+                vector_val.push_back(parse_value(strm, depth + 1)); // 解析值并添加到数组
+                c = peek_next_non_space(strm);           // 查看下一个非空白字符
+
+                if (c == U',')
+                {
+                    skip_char(strm, U','); // 跳过逗号
+                }
+                else if (c == U']')
+                {
+                    break; // 遇到结尾的 ']' 字符时结束循环
+                }
+            } while (c != EOF); // 直到文件结束
+
+            // 跳过结尾的 ']' 字符
+            skip_char(strm, U']');
+
+            json_type array_val(std::move(vector_val)); // 创建 JSON 数组对象，接管数组数据
+            return array_val;                      // 返回 JSON 数组对象
+        }
+
+        // 解析 JSON 布尔值
+        static json_type parse_bool(u32_istream &strm)
+        {
+            std::u32string val_str;
+
+            int c = strm.peek(); // 查看当前字符
+            while (c != EOF && c != U',' && c != U'}' && c != U']')
+            {                                                              // 当不是文件结束且不是逗号、} 或 ] 时循环
+                c = strm.get();                                            // 获取当前字符
+                val_str.push_back(static_cast<char32_t>(std::tolower(c))); // 转换为小写并添加到字符串
+                c = strm.peek();                                           // 再次查看当前字符
+            }
+
+            std::string bool_str = trim(U32ToU8(val_str)); // 转换为 UTF-8 字符串并去除空白字符
+
+            bool val_bool = to_bool(bool_str); // 转换为布尔值
+            json_type return_val(val_bool);         // 创建 JSON 布尔值对象
+            return return_val;                 // 返回 JSON 布尔值对象
+        }
+
+        // 解析 JSON null 值
+        static json_type parse_null(u32_istream &strm)
+        {
+            std::u32string val_str;
+
+            int c = strm.peek(); // 查看当前字符
+            while (c != EOF && c != U',' && c != U'}' && c != U']')
+            {                                                              // 当不是文件结束且不是逗号、} 或 ] 时循环
+                c = strm.get();                                            // 获取当前字符
+                val_str.push_back(static_cast<char32_t>(std::tolower(c))); // 转换为小写并添加到字符串
+                c = strm.peek();                                           // 再次查看当前字符
+            }
+
+            std::string null_str = trim(U32ToU8(val_str)); // 转换为 UTF-8 字符串并去除空白字符
+
+            if (null_str == "null")
+            {                  // 如果字符串是 "null"
+                return json_type(); // 返回 JSON null 对象
+            }
+            else
+            {
+                TINYJSON_THROW(std::runtime_error("unexpected null string")); // 抛出异常，null 字符串不符合预期
+            }
+        }
+
+        // 解析 JSON 字符串值
+        static json_type parse_string(u32_istream &strm)
+        {
+            std::u32string string_val;
+
+            // 跳过字符串开头的双引号
+            skip_char(strm, U'"');
+
+            char32_t c = strm.peek(); // 查看当前字符
+
+            // 当字符不是文件结束标志且不是双引号时循环
+            while (c != EOF && c != U'"')
+            {
+                if (c == U'\\')
+                {
+                    // 处理转义字符
+                    string_val.push_back(escape_char(strm));
+                }
+                else
+                {
+                    strm.get(c);             // 获取当前字符
+                    string_val.push_back(c); // 添加到字符串
+                }
+
+                c = strm.peek(); // 查看下一个字符
+            }
+
+            // 跳过字符串结尾的双引号
+            skip_char(strm, U'"');
+
+            // 将 UTF-32 编码的字符串转换为 UTF-8 编码，并创建 JSON 字符串对象
+            json_type return_val(U32ToU8(string_val));
+            return return_val; // 返回 JSON 字符串对象
+        }
+
+        // 解析 JSON 数值
+        static json_type parse_number(u32_istream &strm)
+        {
+            std::u32string num_str;
+
+            int c = strm.peek(); // 查看当前字符
+            while (c != EOF && c != U',' && c != U']' && c != U'}')
+            {                         // 当不是文件结束且不是逗号、] 或 } 时循环
+                c = strm.get();       // 获取当前字符
+                num_str.push_back(c); // 添加到字符串
+                c = strm.peek();      // 查看下一个字符
+            }
+
+            std::string nums = trim(U32ToU8(num_str)); // 转换为 UTF-8 字符串并去除空白字符
+
+            // 没有小数点和指数的数值为整数，超出长整型范围时为浮点数
+            parsed_number num = to_number(nums.data(), nums.data() + nums.size());
+            if (num.type == json_t::number_integer)
+            {
+                return json_type(num.integer); // 整数
+            }
+            return json_type(num.number); // 双精度浮点数
+        }
+
+        // 将字符串转换为布尔值
+        static bool to_bool(std::string str)
+        {
+            std::transform(str.begin(), str.end(), str.begin(), // 转换字符串中所有字符为小写
+                           [](unsigned char c)
+                           {
+                               return static_cast<unsigned char>(std::tolower(c));
+                           });
+
+            if (str == "true") // 如果字符串是 "true"
+                return true;   // 返回 true
+
+            if (str == "false") // 如果字符串是 "false"
+                return false;   // 返回 false
+
+            TINYJSON_THROW(std::runtime_error("invalid boolean string")); // 抛出异常，布尔字符串不符合预期
+        }
+
+        // 将字符串转换为长整型数
+        static long long to_integer(const std::string &str)
+        {
+            parsed_number num = to_number(str.data(), str.data() + str.size());
+            if (num.type != json_t::number_integer)
+            {
+                // 含有小数点或指数，或者超出了长整型的范围
+                TINYJSON_THROW(std::runtime_error("Unexpected number(integer) format."));
+            }
+            return num.integer;
+        }
+
+        // 将字符串转换为双精度浮点数
+        static double to_double(const std::string &str)
+        {
+            parsed_number num = to_number(str.data(), str.data() + str.size());
+            return num.type == json_t::number_integer ? static_cast<double>(num.integer) : num.number;
+        }
+
+        // 将 [begin, end) 转换为数值，整个范围必须恰好是一个数值
+        // 不依赖区域设置，超出双精度浮点数范围时抛出异常
+        static parsed_number to_number(const char *begin, const char *end)
+        {
+            parsed_number num{};
+            if (scan_number(begin, end, num) != end)
+            {
+                TINYJSON_THROW(std::runtime_error("Unexpected number format."));
+            }
+            if (num.type == json_t::number_double && std::isinf(num.number))
+            {
+                TINYJSON_THROW(std::runtime_error("number out of range"));
+            }
+            return num;
+        }
+
+        // 解析转义字符
+        static char32_t escape_char(u32_istream &strm)
+        {
+            skip_char(strm, U'\\'); // 跳过反斜杠
+
+            char32_t c = strm.get(); // 获取下一个字符
+
+            switch (c)
+            {
+            case U'"':
+                c = U'"'; // 双引号
+                break;
+
+            case U'\\':
+                c = U'\\'; // 反斜杠
+                break;
+
+            case U'/':
+                c = U'/'; // 斜杠
+                break;
+
+            case U'b':
+                c = U'\b'; // 退格符
+                break;
+
+            case U'f':
+                c = U'\f'; // 换页符
+                break;
+
+            case U'n':
+                c = U'\n'; // 换行符
+                break;
+
+            case U'r':
+                c = U'\r'; // 回车符
+                break;
+
+            case U't':
+                c = U'\t'; // 制表符
+                break;
+
+            case U'u':
+                // 解析 Unicode 转义序列，UTF-16 代理对需要合并为一个码点
+                c = parse_hex(strm);
+                if (c >= 0xD800 && c <= 0xDBFF)
+                {
+                    if (strm.get() != U'\\' || strm.get() != U'u')
+                    {
+                        TINYJSON_THROW(std::runtime_error("unpaired utf-16 surrogate")); // 高位代理之后缺少低位代理
+                    }
+                    char32_t low = parse_hex(strm);
+                    if (low < 0xDC00 || low > 0xDFFF)
+                    {
+                        TINYJSON_THROW(std::runtime_error("unpaired utf-16 surrogate"));
+                    }
+                    c = 0x10000 + ((c - 0xD800) << 10) + (low - 0xDC00);
+                }
+                else if (c >= 0xDC00 && c <= 0xDFFF)
+                {
+                    TINYJSON_THROW(std::runtime_error("unpaired utf-16 surrogate")); // 单独的低位代理
+                }
+                break;
+
+            default:
+                // 如果反斜杠后不是有效的转义字符，则抛出异常
+                TINYJSON_THROW(std::runtime_error("backslash is followed by invalid character"));
+            }
+
+            return c; // 返回转义后的字符
+        }
+
+        // 外层已有 depth 层对象或数组时再进入一层，超过 TINYJSON_MAX_DEPTH 时抛出异常
+        static void check_depth(size_t depth)
+        {
+            if (depth >= TINYJSON_MAX_DEPTH)
+            {
+                TINYJSON_THROW(std::runtime_error(parse_errc_message(parse_errc::depth_exceeded)));
+            }
+        }
+
+        // 获取下一个非空白字符
+        static char32_t get_next_non_space(u32_istream &strm)
+        {
+            skip_space(strm);  // 跳过所有空白字符
+            return strm.get(); // 获取下一个字符
+        }
+
+        // 查看下一个非空白字符，但不从流中移除它
+        static int peek_next_non_space(u32_istream &strm)
+        {
+            skip_space(strm);   // 跳过所有空白字符
+            return strm.peek(); // 查看下一个字符，但不移除
+        }
+
+        // 跳过字符直到遇到预期的字符，如果遇到不同的字符则抛出异常
+        static void skip_char(u32_istream &strm, char32_t expected)
+        {
+            skip_space(strm);                      // 跳过所有空白字符
+            char32_t next = (char32_t)strm.peek(); // 查看下一个字符
+
+            if (next != expected || next == (char32_t)EOF)
+            { // 如果下一个字符不是预期的字符或文件结束
+                std::string msg = "expected char '";
+                append_utf8(msg, expected); // 直接以 UTF-8 构建错误信息
+                msg += "' not found";
+                TINYJSON_THROW(std::runtime_error(msg));
+            }
+
+            strm.get(); // 移除预期的字符
+        }
+
+        // 跳过所有空白字符
+        static void skip_space(u32_istream &strm)
+        {
+            unsigned int next = strm.peek(); // 查看下一个字符
+            while (next != (char32_t)EOF && std::isspace(next))
+            {                       // 如果下一个字符是空白字符
+                strm.get();         // 移除空白字符
+                next = strm.peek(); // 查看下一个字符
+            }
+        }
+
+        // 解析 Unicode 转义序列（例如 \uXXXX）
+        static char32_t parse_hex(u32_istream &strm)
+        {
+            char32_t uc = 0;
+
+            // 读取四位十六进制数
+            for (int i = 0; i < 4; i++)
+            {
+                char32_t c = strm.get(); // 获取下一个字符
+                int digit = (c != std::char_traits<char32_t>::eof()) ? hex_value(c) : -1;
+                if (digit < 0)
+                {
+                    TINYJSON_THROW(std::runtime_error("not hex number")); // 抛出异常，输入不是有效的十六进制数
+                }
+                uc = (uc << 4) | static_cast<char32_t>(digit);
+            }
+
+            return uc; // 返回转换后的字符
+        }
+
+        //
+        // 字节级解析：直接在 UTF-8 输入上工作，不经过 UTF-32 流转换
+        // 词法分析只产生 SAX 事件，构建 JSON 树由 dom_handler 完成
+        //
+
+        // 解析 JSON 值并构建为 JSON 树
+        static json_type parse_value(byte_cursor &cursor, const allocator_type &alloc = allocator_type())
+        {
+            dom_handler<json_type> handler(alloc);
+            std::string scratch;
+            sax_value(cursor, handler, scratch);
+            return std::move(handler.result());
+        }
+
+        // 解析 JSON 值，并把对应的事件交给 handler
+        // scratch 用于存放含有转义字符的字符串，在整个解析过程中复用
+        template <class Handler>
+        static bool sax_value(byte_cursor &cursor, Handler &handler, std::string &scratch)
+        {
+            // 查看下一个非空白字符以确定要解析的值类型
+            switch (peek_next_non_space(cursor))
+            {
+            case '"': // 字符串
+            {
+                string_view str = scan_string(cursor, scratch);
+                return str.data() != nullptr && handler.string(str);
+            }
+
+            case '[': // 数组
+                return sax_array(cursor, handler, scratch);
+
+            // 数字，包括整数和浮点数
+            case '0':
+            case '1':
+            case '2':
+            case '3':
+            case '4':
+            case '5':
+            case '6':
+            case '7':
+            case '8':
+            case '9':
+            case '-':
+            case '.':
+                return sax_number(cursor, handler);
+
+            case '{': // 对象
+                return sax_object(cursor, handler, scratch);
+
+            // 布尔值（与流式解析一致，不区分大小写）
+            case 'T':
+            case 't':
+                if (!match_literal(cursor, "true"))
+                {
+                    return parse_fail(cursor, parse_errc::invalid_literal);
+                }
+                return handler.boolean(true);
+
+            case 'F':
+            case 'f':
+                if (!match_literal(cursor, "false"))
+                {
+                    return parse_fail(cursor, parse_errc::invalid_literal);
+                }
+                return handler.boolean(false);
+
+            // null
+            case 'n':
+            case 'N':
+                if (!match_literal(cursor, "null"))
+                {
+                    return parse_fail(cursor, parse_errc::invalid_literal);
+                }
+                return handler.null();
+
+            default: // 遇到意外的字符
+                return parse_fail(cursor, parse_errc::unexpected_character);
+            }
+        }
+
+        // 解析 JSON 对象
+        template <class Handler>
+        static bool sax_object(byte_cursor &cursor, Handler &handler, std::string &scratch)
+        {
+            // 跳过开头的 '{' 字符
+            if (!enter_nested(cursor) || !skip_char(cursor, '{') || !handler.start_object())
+            {
+                return false;
+            }
+
+            // 空对象
+            if (peek_next_non_space(cursor) == '}')
+            {
+                cursor.get();
+                --cursor.depth;
+                return handler.end_object();
+            }
+
+            while (true)
+            {
+                if (peek_next_non_space(cursor) != '"')
+                {
+                    return parse_fail(cursor, parse_errc::invalid_object); // 对象格式错误
+                }
+
+                string_view key = scan_string(cursor, scratch); // 解析成员键名
+                if (key.data() == nullptr || !handler.key(key))
+                {
+                    return false;
+                }
+                if (!skip_char(cursor, ':', parse_errc::invalid_object) || // 跳过冒号
+                    !sax_value(cursor, handler, scratch))                 // 解析成员值
+                {
+                    return false;
+                }
+
+                int c = get_next_non_space(cursor);
+                if (c == '}')
+                {
+                    break; // 遇到 '}', 结束对象解析
+                }
+                if (c != ',')
+                {
+                    return separator_error(cursor, c, parse_errc::invalid_object); // 对象格式错误
+                }
+            }
+
+            --cursor.depth;
+            return handler.end_object();
+        }
+
+        // 解析 JSON 数组
+        template <class Handler>
+        static bool sax_array(byte_cursor &cursor, Handler &handler, std::string &scratch)
+        {
+            // 跳过开头的 '[' 字符
+            if (!enter_nested(cursor) || !skip_char(cursor, '[') || !handler.start_array())
+            {
+                return false;
+            }
+
+            // 空数组
+            if (peek_next_non_space(cursor) == ']')
+            {
+                cursor.get();
+                --cursor.depth;
+                return handler.end_array();
+            }
+
+            while (true)
+            {
+                if (!sax_value(cursor, handler, scratch)) // 解析数组元素
+                {
+                    return false;
+                }
+
+                int c = get_next_non_space(cursor);
+                if (c == ']')
+                {
+                    break; // 遇到结尾的 ']' 字符时结束循环
+                }
+                if (c != ',')
+                {
+                    return separator_error(cursor, c, parse_errc::invalid_array);
+                }
+            }
+
+            --cursor.depth;
+            return handler.end_array();
+        }
+
+        // 解析 JSON 数值
+        template <class Handler>
+        static bool sax_number(byte_cursor &cursor, Handler &handler)
+        {
+            skip_space(cursor);
+
+            // 数值可能出现的全部字符，其余交给 to_number 校验
+            const char *begin = cursor.cur;
+            while (cursor.cur < cursor.end && is_number_byte(*cursor.cur))
+            {
+                ++cursor.cur;
+            }
+
+            parsed_number num{};
+            if (scan_number(begin, cursor.cur, num) != cursor.cur)
+            {
+                cursor.cur = begin; // 错误位置为数值的开头
+                return parse_fail(cursor, parse_errc::invalid_number);
+            }
+            if (num.type == json_t::number_integer)
+            {
+                return handler.number_integer(num.integer); // 整数
+            }
+            if (std::isinf(num.number))
+            {
+                cursor.cur = begin;
+                return parse_fail(cursor, parse_errc::number_out_of_range);
+            }
+            return handler.number_double(num.number); // 双精度浮点数
+        }
+
+        // 解析 JSON 字符串（包括键名），字符串内部的 UTF-8 序列在此校验
+        // 不含转义字符时直接返回指向输入的视图，否则解码到 scratch 中并返回它的视图；
+        // 原位解析时解码结果（总是不长于原文）写回输入中原来的位置，返回的视图同样指向输入
+        // 不抛出异常的解析中出错时返回 data() 为空指针的视图（成功时总是指向输入或 scratch）
+        static string_view scan_string(byte_cursor &cursor, std::string &scratch)
+        {
+            // 跳过开头的双引号
+            if (!skip_char(cursor, '"'))
+            {
+                return string_view();
+            }
+
+            // 普通字节成段处理，只有遇到转义或多字节序列时才停下
+            const char *begin = cursor.cur;
+            const char *run = cursor.cur;
+            bool escaped = false;
+            while (true)
+            {
+                cursor.cur = find_string_special(cursor.cur, cursor.end); // 向量化地跳过普通字节
+                if (cursor.cur == cursor.end)
+                {
+                    break;
+                }
+
+                unsigned char c = static_cast<unsigned char>(*cursor.cur);
+                if (c == '"')
+                {
+                    string_view result(run, static_cast<size_t>(cursor.cur - run));
+                    if (escaped)
+                    {
+                        scratch.append(run, cursor.cur);
+                        result = string_view(scratch);
+                        if (cursor.insitu)
+                        {
+                            char *dst = const_cast<char *>(begin); // 输入由调用方以可写的缓冲区提供
+                            std::memcpy(dst, scratch.data(), scratch.size());
+                            result = string_view(dst, scratch.size());
+                        }
+                    }
+                    ++cursor.cur; // 跳过结尾的双引号
+                    return result;
+                }
+
+                if (c == '\\')
+                {
+                    if (!escaped)
+                    {
+                        scratch.clear();
+                        escaped = true;
+                    }
+                    scratch.append(run, cursor.cur);
+                    if (!escape_char(cursor, scratch)) // 转义字符
+                    {
+                        return string_view();
+                    }
+                    run = cursor.cur;
+                }
+                else if (c < 0x80)
+                {
+                    ++cursor.cur; // 控制字符
+                }
+                else
+                {
+                    size_t n = utf8_sequence_length(cursor.cur, cursor.end);
+                    if (n == 0)
+                    {
+                        parse_fail(cursor, parse_errc::invalid_utf8);
+                        return string_view();
+                    }
+                    cursor.cur += n;
+                }
+            }
+
+            parse_fail(cursor, parse_errc::unexpected_end); // 缺少结尾的双引号
+            return string_view();
+        }
+
+        // 解析转义字符，并将结果以 UTF-8 追加到 out，出错时返回 false
+        static bool escape_char(byte_cursor &cursor, std::string &out)
+        {
+            if (!skip_char(cursor, '\\')) // 跳过反斜杠
+            {
+                return false;
+            }
+
+            int c = cursor.get();
+            switch (c)
+            {
+            case '"':
+                out.push_back('"'); // 双引号
+                break;
+
+            case '\\':
+                out.push_back('\\'); // 反斜杠
+                break;
+
+            case '/':
+                out.push_back('/'); // 斜杠
+                break;
+
+            case 'b':
+                out.push_back('\b'); // 退格符
+                break;
+
+            case 'f':
+                out.push_back('\f'); // 换页符
+                break;
+
+            case 'n':
+                out.push_back('\n'); // 换行符
+                break;
+
+            case 'r':
+                out.push_back('\r'); // 回车符
+                break;
+
+            case 't':
+                out.push_back('\t'); // 制表符
+                break;
+
+            case 'u':
+            {
+                // 解析 Unicode 转义序列，UTF-16 代理对需要合并为一个码点
+                char32_t cp = parse_hex(cursor);
+                if (cursor.failed())
+                {
+                    return false;
+                }
+                if (cp >= 0xD800 && cp <= 0xDBFF)
+                {
+                    if (cursor.get() != '\\' || cursor.get() != 'u')
+                    {
+                        return parse_fail(cursor, parse_errc::invalid_unicode_escape); // 高位代理之后缺少低位代理
+                    }
+                    char32_t low = parse_hex(cursor);
+                    if (cursor.failed())
+                    {
+                        return false;
+                    }
+                    if (low < 0xDC00 || low > 0xDFFF)
+                    {
+                        return parse_fail(cursor, parse_errc::invalid_unicode_escape);
+                    }
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                }
+                else if (cp >= 0xDC00 && cp <= 0xDFFF)
+                {
+                    return parse_fail(cursor, parse_errc::invalid_unicode_escape); // 单独的低位代理
+                }
+                append_utf8(out, cp);
+                break;
+            }
+
+            default:
+                // 如果反斜杠后不是有效的转义字符，则报告错误
+                if (c != EOF)
+                {
+                    --cursor.cur; // 错误位置为这个字符
+                }
+                return parse_fail(cursor, parse_errc::invalid_escape);
+            }
+            return true;
+        }
+
+        // 获取下一个非空白字符
+        static int get_next_non_space(byte_cursor &cursor)
+        {
+            skip_space(cursor);  // 跳过所有空白字符
+            return cursor.get(); // 获取下一个字符
+        }
+
+        // 查看下一个非空白字符，但不移动游标
+        static int peek_next_non_space(byte_cursor &cursor)
+        {
+            skip_space(cursor);   // 跳过所有空白字符
+            return cursor.peek(); // 查看下一个字符，但不移除
+        }
+
+        // 跳过字符直到遇到预期的字符，如果遇到不同的字符则报告错误 code 并返回 false
+        static bool skip_char(byte_cursor &cursor, char expected, parse_errc code = parse_errc::unexpected_character)
+        {
+            skip_space(cursor); // 跳过所有空白字符
+
+            if (cursor.peek() != static_cast<unsigned char>(expected))
+            {
+                return parse_fail(cursor, code);
+            }
+
+            ++cursor.cur; // 移除预期的字符
+            return true;
+        }
+
+        // 跳过所有空白字符
+        static void skip_space(byte_cursor &cursor)
+        {
+            cursor.cur = skip_whitespace(cursor.cur, cursor.end); // 长段空白按向量宽度跳过
+        }
+
+        // 解析 Unicode 转义序列中的四位十六进制数（例如 \uXXXX 中的 XXXX）
+        // 不抛出异常的解析中出错时返回 0，调用者需检查 cursor.failed()
+        static char32_t parse_hex(byte_cursor &cursor)
+        {
+            char32_t uc = 0;
+
+            for (int i = 0; i < 4; i++)
+            {
+                int c = cursor.get();
+                int digit = (c != EOF) ? hex_value(static_cast<char32_t>(c)) : -1;
+                if (digit < 0)
+                {
+                    if (c != EOF)
+                    {
+                        --cursor.cur;
+                    }
+                    parse_fail(cursor, parse_errc::invalid_unicode_escape); // 输入不是有效的十六进制数
+                    return 0;
+                }
+                uc = (uc << 4) | static_cast<char32_t>(digit);
+            }
+
+            return uc;
+        }
+
+    private:
+        template <class Handler>
+        friend class sax_push_parser;
+
+        // 值之后读到了意外的字符 c：退回到这个字符处报告错误
+        static bool separator_error(byte_cursor &cursor, int c, parse_errc code)
+        {
+            if (c != EOF)
+            {
+                --cursor.cur;
+            }
+            return parse_fail(cursor, code);
+        }
+
+        // 不区分大小写地匹配字面量（true/false/null），匹配成功时移动游标
+        static bool match_literal(byte_cursor &cursor, const char *literal)
+        {
+            size_t n = std::char_traits<char>::length(literal);
+            if (static_cast<size_t>(cursor.end - cursor.cur) < n)
+            {
+                return false;
+            }
+
+            for (size_t i = 0; i < n; i++)
+            {
+                if (std::tolower(static_cast<unsigned char>(cursor.cur[i])) != literal[i])
+                {
+                    return false;
+                }
+            }
+
+            cursor.cur += n;
+            return true;
+        }
+    };
+
+    // 解析为默认的 json 类型
+    using parser = basic_parser<json>;
+
+    // 增量（推送式）SAX 解析器，适用于分块到达的输入（例如网络数据）
+    // 每收到一块数据就调用 feed()，解析状态在块之间保留；全部数据到达后调用 finish()
+    // 只有跨越块边界的那个字符串、数值或字面量会被缓存，其余内容直接在输入块上解析
+    template <class Handler>
+    class sax_push_parser
+    {
+    public:
+        explicit sax_push_parser(Handler &handler) : _handler(handler) { reset(); }
+
+        sax_push_parser(const sax_push_parser &) = delete;
+        sax_push_parser &operator=(const sax_push_parser &) = delete;
+
+        // 解析下一块输入，handler 中止解析后返回 false
+        // 格式错误时抛出 parse_exception，位置从第一块的开头算起
+        bool feed(const char *s, size_t length)
+        {
+            if (_stopped)
+            {
+                return false;
+            }
+
+            const char *p = s;
+            const char *end = s + length;
+            _chunk = s;
+            if (_token != token::none)
+            {
+                p = resume_token(p, end); // 先完成上一块中未结束的词法单元
+            }
+
+            while (!_stopped)
+            {
+                p = skip_whitespace(p, end);
+                if (p == end)
+                {
+                    break;
+                }
+
+                char c = *p;
+
+                switch (_state)
+                {
+                case state::start:
+                    // 根节点必须是对象或数组
+                    if (c != '{' && c != '[')
+                    {
+                        fail(parse_errc::invalid_root, p);
+                    }
+                    open(p);
+                    ++p;
+                    break;
+
+                case state::key_or_end:
+                case state::key:
+                    if (c == '}' && _state == state::key_or_end)
+                    {
+                        close(p);
+                        ++p;
+                    }
+                    else if (c == '"')
+                    {
+                        _token_is_key = true;
+                        p = start_token(token::string, p, end);
+                    }
+                    else
+                    {
+                        fail(parse_errc::invalid_object, p);
+                    }
+                    break;
+
+                case state::colon:
+                    if (c != ':')
+                    {
+                        fail(parse_errc::invalid_object, p);
+                    }
+                    _state = state::value;
+                    ++p;
+                    break;
+
+                case state::value_or_end:
+                case state::value:
+                    if (c == ']' && _state == state::value_or_end)
+                    {
+                        close(p);
+                        ++p;
+                    }
+                    else
+                    {
+                        p = start_value(p, end);
+                    }
+                    break;
+
+                case state::after_value:
+                    if (c == ',')
+                    {
+                        _state = _stack.back() == '{' ? state::key : state::value;
+                        ++p;
+                    }
+                    else if (c == '}' || c == ']')
+                    {
+                        close(p);
+                        ++p;
+                    }
+                    else
+                    {
+                        throw_separator_error(p);
+                    }
+                    break;
+
+                case state::done:
+                    // 根节点结束后只允许空白字符
+                    fail(parse_errc::trailing_characters, p);
+                }
+            }
+
+            advance(_pos, s, end);
+            return !_stopped;
+        }
+
+        bool feed(const std::string &s) { return feed(s.data(), s.size()); }
+
+        // 输入结束，校验文档是否完整；handler 中止过解析时返回 false
+        bool finish()
+        {
+            if (_stopped)
+            {
+                return false;
+            }
+
+            // 数值和字面量只有在看到后续字符或输入结束时才能确定已完整
+            if (_token == token::string)
+            {
+                fail(parse_errc::unexpected_end, nullptr);
+            }
+            if (_token != token::none)
+            {
+                token kind = _token;
+                _token = token::none;
+                byte_cursor cursor(_pending.data(), _pending.size());
+                if (!emit_token(kind, cursor, _token_pos))
+                {
+                    return false;
+                }
+            }
+
+            if (_state != state::done)
+            {
+                fail(parse_errc::unexpected_end, nullptr);
+            }
+            return true;
+        }
+
+        /// 根节点是否已经完整解析
+        bool done() const { return _state == state::done; }
+
+        /// 丢弃全部状态，准备解析新的文档
+        void reset()
+        {
+            _state = state::start;
+            _token = token::none;
+            _token_is_key = false;
+            _escape = false;
+            _stopped = false;
+            _pending.clear();
+            _stack.clear();
+            _chunk = nullptr;
+            _pos = position();
+            _token_pos = position();
+        }
+
+    private:
+        /// 语法状态：下一个非空白字符应当是什么
+        enum class state
+        {
+            start,        ///< 根节点的 '{' 或 '['
+            key_or_end,   ///< 对象的第一个键名或 '}'
+            key,          ///< 键名
+            colon,        ///< ':'
+            value_or_end, ///< 数组的第一个元素或 ']'
+            value,        ///< 值
+            after_value,  ///< ',' 或容器结束
+            done          ///< 根节点已结束
+        };
+
+        /// 可能跨越块边界的词法单元
+        enum class token
+        {
+            none,
+            string,
+            number,
+            literal
+        };
+
+        /// 输入中的绝对位置
+        struct position
+        {
+            size_t offset = 0;     ///< 距第一块开头的字节数
+            size_t line = 1;       ///< 所在的行，从 1 开始
+            size_t line_begin = 0; ///< 所在行开头的 offset
+        };
+
+        using parser_type = basic_parser<json>;
+
+        // 在 p 处开始一个值
+        const char *start_value(const char *p, const char *end)
+        {
+            switch (*p)
+            {
+            case '"':
+                _token_is_key = false;
+                return start_token(token::string, p, end);
+
+            case '{':
+            case '[':
+                open(p);
+                return p + 1;
+
+            case '0':
+            case '1':
+            case '2':
+            case '3':
+            case '4':
+            case '5':
+            case '6':
+            case '7':
+            case '8':
+            case '9':
+            case '-':
+            case '.':
+                return start_token(token::number, p, end);
+
+            case 'T':
+            case 't':
+            case 'F':
+            case 'f':
+            case 'n':
+            case 'N':
+                return start_token(token::literal, p, end);
+
+            default: // 遇到意外的字符
+                fail(parse_errc::unexpected_character, p);
+            }
+        }
+
+        // 在 p 处开始一个词法单元，整个单元都在当前块中时直接在块上解析，否则缓存起来
+        const char *start_token(token kind, const char *p, const char *end)
+        {
+            _escape = false;
+            const char *e = find_token_end(kind, kind == token::string ? p + 1 : p, end, _escape);
+            if (e == nullptr)
+            {
+                _token = kind;
+                _pending.assign(p, end);
+                _token_pos = _pos;
+                advance(_token_pos, _chunk, p);
+                return end;
+            }
+
+            // 游标延伸到块的末尾，使出错时看到的后续字符与 basic_parser 相同
+            byte_cursor cursor(p, static_cast<size_t>(end - p));
+            cursor.begin = _chunk; // 出错位置从块的开头算起
+            emit_token(kind, cursor, _pos);
+            return e;
+        }
+
+        // 继续上一块中未结束的词法单元
+        const char *resume_token(const char *p, const char *end)
+        {
+            const char *e = find_token_end(_token, p, end, _escape);
+            if (e == nullptr)
+            {
+                _pending.append(p, end);
+                return end;
+            }
+
+            _pending.append(p, e < end ? e + 1 : e); // 带上结束后的一个字符，理由同 start_token
+            token kind = _token;
+            _token = token::none;
+            byte_cursor cursor(_pending.data(), _pending.size());
+            emit_token(kind, cursor, _token_pos);
+            return e;
+        }
+
+        // 查找词法单元的结束位置（不包含），单元在 end 之前没有结束时返回 nullptr
+        // 对于字符串，p 位于开头的双引号之后，escape 记录上一个字符是否为未配对的反斜杠
+        static const char *find_token_end(token kind, const char *p, const char *end, bool &escape)
+        {
+            if (kind == token::string)
+            {
+                while (p < end)
+                {
+                    if (escape)
+                    {
+                        escape = false;
+                        ++p;
+                        continue;
+                    }
+
+                    p = find_string_special(p, end);
+                    if (p == end)
+                    {
+                        break;
+                    }
+                    if (*p == '"')
+                    {
+                        return p + 1;
+                    }
+                    escape = *p == '\\';
+                    ++p;
+                }
+                return nullptr;
+            }
+
+            while (p < end && (kind == token::number ? is_number_byte(*p)
+                                                     : std::isalpha(static_cast<unsigned char>(*p)) != 0))
+            {
+                ++p;
+            }
+            return p < end ? p : nullptr;
+        }
+
+        // 解析游标处一个完整的词法单元并交给 handler，origin 为 cursor.begin 在输入中的位置
+        bool emit_token(token kind, byte_cursor &cursor, const position &origin)
+        {
+            parse_error err;
+            cursor.error = &err; // 先记录相对位置，再换算成绝对位置抛出
+            bool ok;
+            if (kind == token::string)
+            {
+                string_view val = parser_type::scan_string(cursor, _scratch);
+                ok = _token_is_key ? _handler.key(val) : _handler.string(val);
+            }
+            else if (kind == token::number)
+            {
+                ok = parser_type::sax_number(cursor, _handler);
+            }
+            else
+            {
+                ok = emit_literal(cursor);
+            }
+
+            if (cursor.failed())
+            {
+                raise(err, origin);
+            }
+            if (!ok)
+            {
+                _stopped = true;
+            }
+
+            if (kind == token::string && _token_is_key)
+            {
+                _state = state::colon;
+            }
+            else
+            {
+                value_done();
+            }
+            return ok;
+        }
+
+        // 解析 true/false/null（与 basic_parser 一致，不区分大小写）
+        bool emit_literal(byte_cursor &cursor)
+        {
+            switch (std::tolower(cursor.peek()))
+            {
+            case 't':
+                if (!parser_type::match_literal(cursor, "true") || std::isalpha(cursor.peek()) != 0)
+                {
+                    return parse_fail(cursor, parse_errc::invalid_literal);
+                }
+                return _handler.boolean(true);
+
+            case 'f':
+                if (!parser_type::match_literal(cursor, "false") || std::isalpha(cursor.peek()) != 0)
+                {
+                    return parse_fail(cursor, parse_errc::invalid_literal);
+                }
+                return _handler.boolean(false);
+
+            default:
+                if (!parser_type::match_literal(cursor, "null") || std::isalpha(cursor.peek()) != 0)
+                {
+                    return parse_fail(cursor, parse_errc::invalid_literal);
+                }
+                return _handler.null();
+            }
+        }
+
+        // 进入对象或数组，p 指向当前块中的 '{' 或 '['
+        void open(const char *p)
+        {
+            if (_stack.size() >= TINYJSON_MAX_DEPTH)
+            {
+                fail(parse_errc::depth_exceeded, p);
+            }
+            char c = *p;
+            _stack.push_back(c);
+            _state = c == '{' ? state::key_or_end : state::value_or_end;
+            if (!(c == '{' ? _handler.start_object() : _handler.start_array()))
+            {
+                _stopped = true;
+            }
+        }
+
+        // 结束当前的对象或数组，p 指向当前块中的 '}' 或 ']'
+        void close(const char *p)
+        {
+            char c = *p;
+            if ((c == '}') != (_stack.back() == '{'))
+            {
+                throw_separator_error(p);
+            }
+
+            _stack.pop_back();
+            value_done();
+            if (!(c == '}' ? _handler.end_object() : _handler.end_array()))
+            {
+                _stopped = true;
+            }
+        }
+
+        // 一个值结束后，根据所在容器决定下一个状态
+        void value_done()
+        {
+            _state = _stack.empty() ? state::done : state::after_value;
+        }
+
+        // 值之后出现了意外的字符
+        void throw_separator_error(const char *p) const
+        {
+            fail(_stack.back() == '{' ? parse_errc::invalid_object : parse_errc::invalid_array, p);
+        }
+
+        // 报告当前块中 p 处的错误；p 为空时位置为已输入内容的末尾
+        [[noreturn]] TINYJSON_COLD void fail(parse_errc code, const char *p) const
+        {
+            raise(p != nullptr ? parse_error::at(code, _chunk, p) : parse_error::at(code, nullptr, nullptr), _pos);
+        }
+
+        // 把相对于 origin 的错误位置换算成绝对位置，抛出 parse_exception
+        [[noreturn]] TINYJSON_COLD static void raise(parse_error err, const position &origin)
+        {
+            if (err.line == 1)
+            {
+                err.column += origin.offset - origin.line_begin;
+            }
+            err.line += origin.line - 1;
+            err.offset += origin.offset;
+            TINYJSON_THROW(parse_exception(err));
+        }
+
+        // 把位置向后移动到 p，[begin, p) 为跳过的输入
+        static void advance(position &pos, const char *begin, const char *p)
+        {
+            for (const char *q = begin; q < p && (q = static_cast<const char *>(std::memchr(q, '\n', static_cast<size_t>(p - q)))) != nullptr; ++q)
+            {
+                pos.line++;
+                pos.line_begin = pos.offset + static_cast<size_t>(q - begin) + 1;
+            }
+            pos.offset += static_cast<size_t>(p - begin);
+        }
+
+        Handler &_handler;        ///< 接收事件的处理器
+        state _state;             ///< 当前的语法状态
+        token _token;             ///< 跨越块边界、尚未结束的词法单元
+        bool _token_is_key;       ///< 当前字符串是否为键名
+        bool _escape;             ///< 字符串中上一个字符是否为未配对的反斜杠
+        bool _stopped;            ///< handler 是否已中止解析
+        std::string _pending;     ///< 未结束的词法单元已经到达的部分
+        std::string _scratch;     ///< 解码转义字符串的缓冲区
+        std::vector<char> _stack; ///< 从根到当前位置的容器（'{' 或 '['）
+        const char *_chunk;       ///< 正在解析的块的开头
+        position _pos;            ///< _chunk 在输入中的位置
+        position _token_pos;      ///< 未结束的词法单元开头在输入中的位置
+    };
+
+    // 增量解析并构建 JSON 树
+    template <class BasicJson>
+    class basic_push_parser
+    {
+    public:
+        using json_type = BasicJson;
+        using allocator_type = typename json_type::allocator_type;
+
+        explicit basic_push_parser(const allocator_type &alloc = allocator_type())
+            : _handler(alloc), _parser(_handler) {}
+
+        /// 解析下一块输入
+        void feed(const char *s, size_t length) { _parser.feed(s, length); }
+        void feed(const std::string &s) { _parser.feed(s); }
+
+        /// 输入结束，返回解析结果
+        json_type &finish()
+        {
+            _parser.finish();
+            return _handler.result();
+        }
+
+        /// 根节点是否已经完整解析
+        bool done() const { return _parser.done(); }
+
+        /// 丢弃已解析的内容，准备解析新的文档
+        void reset()
+        {
+            _handler.clear();
+            _parser.reset();
+        }
+
+    private:
+        dom_handler<json_type> _handler;                 ///< 构建 JSON 树
+        sax_push_parser<dom_handler<json_type>> _parser; ///< 增量词法与语法分析
+    };
+
+    using push_parser = basic_push_parser<json>;
+
+    // JSON Lines（NDJSON）读取器：逐行读取，每行可以包含一个或多个完整的值，空行被跳过
+    // 行缓冲区、转义字符串的缓冲区以及构建 JSON 树的处理器在记录之间复用
+    // 某条记录格式错误时只报告这一条，并跳过该行余下的内容，之后的记录照常读取：
+    //     ndjson_reader reader(in);
+    //     while (reader.next())
+    //         if (reader.ok()) use(reader.value()); else log(reader.line(), reader.error());
+    template <class BasicJson>
+    class basic_ndjson_reader
+    {
+    public:
+        using json_type = BasicJson;
+        using allocator_type = typename json_type::allocator_type;
+
+        /// 从输入流逐行读取
+        explicit basic_ndjson_reader(std::istream &in, const allocator_type &alloc = allocator_type())
+            : _in(&in), _next(nullptr), _data_end(nullptr), _handler(alloc) {}
+
+        /// 读取内存中的输入，不复制，输入必须在读取期间保持有效
+        basic_ndjson_reader(const char *s, size_t length, const allocator_type &alloc = allocator_type())
+            : _in(nullptr), _next(s), _data_end(s + length), _handler(alloc) {}
+
+        explicit basic_ndjson_reader(const std::string &s, const allocator_type &alloc = allocator_type())
+            : basic_ndjson_reader(s.data(), s.size(), alloc) {}
+        basic_ndjson_reader(std::string &&, const allocator_type & = allocator_type()) = delete;
+
+        basic_ndjson_reader(const basic_ndjson_reader &) = delete;
+        basic_ndjson_reader &operator=(const basic_ndjson_reader &) = delete;
+
+        /// 读取下一条记录；读到一条记录（包括格式错误的记录）时返回 true，输入结束时返回 false
+        bool next()
+        {
+            while ((_cur = skip_whitespace(_cur, _end)) == _end)
+            {
+                if (!next_line())
+                {
+                    return false;
+                }
+            }
+
+            _record_line = _line;
+            byte_cursor cursor(_cur, static_cast<size_t>(_end - _cur));
+            parse_error error; // 格式错误的记录很常见，不通过异常报告
+            cursor.error = &error;
+            _handler.clear();
+            bool parsed;
+            {
+                TINYJSON_STAT_TIMER(parse_ns);
+                parsed = basic_parser<json_type>::sax_value(cursor, _handler, _scratch);
+            }
+            TINYJSON_STAT_ADD(bytes_parsed, static_cast<uint64_t>(cursor.cur - _cur));
+            if (parsed)
+            {
+                _value = std::move(_handler.result());
+                _error.clear();
+                _ok = true;
+                _cur = cursor.cur;
+            }
+            else
+            {
+                _value = json_type();
+                _error = error.to_string(); // 位置相对于记录的开头
+                _ok = false;
+                _cur = _end; // 无法确定这一行中下一个值从哪里开始
+            }
+            return true;
+        }
+
+        /// 当前记录是否解析成功
+        bool ok() const { return _ok; }
+
+        /// 当前记录，格式错误时为 null
+        json_type &value() { return _value; }
+        const json_type &value() const { return _value; }
+
+        /// 当前记录的错误信息，解析成功时为空
+        const std::string &error() const { return _error; }
+
+        /// 当前记录所在的行号，从 1 开始
+        size_t line() const { return _record_line; }
+
+    private:
+        // 读入下一行，没有更多输入时返回 false
+        bool next_line()
+        {
+            if (_in != nullptr)
+            {
+                if (!std::getline(*_in, _buffer))
+                {
+                    return false;
+                }
+                _cur = _buffer.data();
+                _end = _cur + _buffer.size();
+            }
+            else
+            {
+                if (_next == _data_end)
+                {
+                    return false;
+                }
+                const void *nl = std::memchr(_next, '\n', static_cast<size_t>(_data_end - _next));
+                _cur = _next;
+                _end = nl ? static_cast<const char *>(nl) : _data_end;
+                _next = nl ? _end + 1 : _data_end;
+            }
+            ++_line;
+            return true;
+        }
+
+        std::istream *_in;               ///< 输入流，读取内存中的输入时为空
+        const char *_next;               ///< 内存输入中下一行的开头
+        const char *_data_end;           ///< 内存输入的结束位置
+        std::string _buffer;             ///< 从输入流读入的当前行
+        const char *_cur = nullptr;      ///< 当前行中尚未解析的部分
+        const char *_end = nullptr;      ///< 当前行的结束位置
+        size_t _line = 0;                ///< 已读入的行数
+        size_t _record_line = 0;         ///< 当前记录所在的行号
+        dom_handler<json_type> _handler; ///< 构建 JSON 树，在记录之间复用
+        std::string _scratch;            ///< 解码转义字符串的缓冲区
+        json_type _value;                ///< 当前记录
+        std::string _error;              ///< 当前记录的错误信息
+        bool _ok = false;                ///< 当前记录是否解析成功
+    };
+
+    using ndjson_reader = basic_ndjson_reader<json>;
+
+    // JSON Lines（NDJSON）写入器：每条记录由 dump 序列化为一行，直接写入 Sink
+    //     ndjson_writer writer(os);          // 写入 std::ostream
+    //     basic_ndjson_writer<string_sink<>> to_string(out); // 追加到 std::string
+    template <class Sink>
+    class basic_ndjson_writer
+    {
+    public:
+        /// 用 target 构造内部的 Sink（例如输出流或字符串）
+        template <class Target>
+        explicit basic_ndjson_writer(Target &target) : _sink(target), _count(0), _formatted(false) {}
+
+        /// 按 options 输出每条记录，例如 dump_options::compact() 不输出任何空白
+        /// 每条记录必须在一行之内，带缩进的格式会抛出 std::logic_error
+        template <class Target>
+        basic_ndjson_writer(Target &target, const dump_options &options)
+            : _sink(target), _count(0), _options(options), _formatted(true)
+        {
+            if (options.indent >= 0)
+            {
+                TINYJSON_THROW(std::logic_error("ndjson records must be written on a single line"));
+            }
+        }
+
+        basic_ndjson_writer(const basic_ndjson_writer &) = delete;
+        basic_ndjson_writer &operator=(const basic_ndjson_writer &) = delete;
+
+        /// 写入一条记录及结尾的换行
+        template <class BasicJson>
+        void write(const BasicJson &record)
+        {
+            if (_formatted)
+                record.dump(_sink, _options);
+            else
+                record.dump(_sink);
+            _sink.put('\n');
+            ++_count;
+        }
+
+        /// 已写入的记录数
+        size_t count() const { return _count; }
+
+        /// 写出 Sink 中缓冲的数据（Sink 提供 flush 时可用）
+        void flush() { _sink.flush(); }
+
+    private:
+        Sink _sink;            ///< 输出目标
+        size_t _count;         ///< 已写入的记录数
+        dump_options _options; ///< 记录的输出格式
+        bool _formatted;       ///< 是否按 _options 输出，否则使用 dump() 的默认格式
+    };
+
+    using ndjson_writer = basic_ndjson_writer<ostream_sink>;
+
+    //
+    // 二进制编码：MessagePack 和 CBOR，与 json 使用同一套值模型（null、布尔、整数、浮点数、字符串、数组、对象）
+    // 解码直接产生 SAX 事件，字符串事件中的视图指向输入本身；以 borrow 解码时字符串值借用输入而不复制
+    // 对象的键名必须是字符串；二进制数据（MessagePack 的 bin、CBOR 的 byte string）按字符串读取
+    // 字符串按原样读取，不校验 UTF-8；根节点可以是任意值，值之后不能有多余的字节
+    //
+
+    // 从游标处读取 bytes 个字节的大端无符号整数，输入不足时报告错误
+    inline bool read_big_endian(byte_cursor &cursor, size_t bytes, uint64_t &out)
+    {
+        if (static_cast<size_t>(cursor.end - cursor.cur) < bytes)
+        {
+            cursor.cur = cursor.end;
+            return parse_fail(cursor, parse_errc::unexpected_end);
+        }
+        uint64_t v = 0;
+        for (size_t i = 0; i < bytes; i++)
+        {
+            v = (v << 8) | static_cast<unsigned char>(cursor.cur[i]);
+        }
+        cursor.cur += bytes;
+        out = v;
+        return true;
+    }
+
+    // 从游标处取出 length 个字节作为字符串，输入不足时报告错误并返回 data() 为空指针的视图
+    inline string_view read_bytes(byte_cursor &cursor, uint64_t length)
+    {
+        if (static_cast<uint64_t>(cursor.end - cursor.cur) < length)
+        {
+            cursor.cur = cursor.end;
+            parse_fail(cursor, parse_errc::unexpected_end);
+            return string_view();
+        }
+        string_view bytes(cursor.cur, static_cast<size_t>(length));
+        cursor.cur += length;
+        return bytes;
+    }
+
+    // 写入 bytes 个字节的大端无符号整数
+    template <class Sink>
+    inline void write_big_endian(Sink &sink, uint64_t v, size_t bytes)
+    {
+        char buf[8];
+        for (size_t i = bytes; i-- > 0; v >>= 8)
+        {
+            buf[i] = static_cast<char>(v & 0xff);
+        }
+        sink.write(buf, bytes);
+    }
+
+    // 按 MessagePack 格式写出 json 值，整数和长度使用最短的表示，浮点数使用 float64
+    template <class Sink>
+    class basic_msgpack_writer
+    {
+    public:
+        explicit basic_msgpack_writer(Sink &sink) : _sink(sink) {}
+
+        template <class BasicJson>
+        void write(const BasicJson &j)
+        {
+            switch (j.type())
+            {
+            case json_t::null:
+                _sink.put('\xc0');
+                break;
+
+            case json_t::boolean:
+                _sink.put(j.get_bool() ? '\xc3' : '\xc2');
+                break;
+
+            case json_t::number_integer:
+                write_integer(j.get_integer());
+                break;
+
+            case json_t::number_double:
+            {
+                double d = j.get_double();
+                uint64_t bits;
+                std::memcpy(&bits, &d, sizeof(bits));
+                _sink.put('\xcb');
+                write_big_endian(_sink, bits, 8);
+                break;
+            }
+
+            case json_t::string:
+                write_string(j.get_string_view());
+                break;
+
+            case json_t::array:
+                write_header(j.size(), 0x90, 0xdc, 0xdd);
+                for (const auto &elem : j.get_array())
+                {
+                    write(elem);
+                }
+                break;
+
+            case json_t::object:
+                write_header(j.size(), 0x80, 0xde, 0xdf);
+                for (const auto &member : j.get_object())
+                {
+                    write_string(string_view(member.first.data(), member.first.size()));
+                    write(member.second);
+                }
+                break;
+
+            default:
+                TINYJSON_THROW(std::runtime_error("invalid json type"));
+            }
+        }
+
+    private:
+        void write_integer(long long v)
+        {
+            if (v >= 0)
+            {
+                uint64_t u = static_cast<uint64_t>(v);
+                if (u <= 0x7f)
+                {
+                    _sink.put(static_cast<char>(u)); // positive fixint
+                }
+                else if (u <= 0xff)
+                {
+                    _sink.put('\xcc');
+                    write_big_endian(_sink, u, 1);
+                }
+                else if (u <= 0xffff)
+                {
+                    _sink.put('\xcd');
+                    write_big_endian(_sink, u, 2);
+                }
+                else if (u <= 0xffffffffULL)
+                {
+                    _sink.put('\xce');
+                    write_big_endian(_sink, u, 4);
+                }
+                else
+                {
+                    _sink.put('\xcf');
+                    write_big_endian(_sink, u, 8);
+                }
+                return;
+            }
+
+            uint64_t bits = static_cast<uint64_t>(v); // 补码，写出低位字节即可
+            if (v >= -32)
+            {
+                _sink.put(static_cast<char>(bits & 0xff)); // negative fixint
+            }
+            else if (v >= INT8_MIN)
+            {
+                _sink.put('\xd0');
+                write_big_endian(_sink, bits, 1);
+            }
+            else if (v >= INT16_MIN)
+            {
+                _sink.put('\xd1');
+                write_big_endian(_sink, bits, 2);
+            }
+            else if (v >= INT32_MIN)
+            {
+                _sink.put('\xd2');
+                write_big_endian(_sink, bits, 4);
+            }
+            else
+            {
+                _sink.put('\xd3');
+                write_big_endian(_sink, bits, 8);
+            }
+        }
+
+        void write_string(string_view s)
+        {
+            size_t n = s.size();
+            if (n <= 31)
+            {
+                _sink.put(static_cast<char>(0xa0 | n)); // fixstr
+            }
+            else if (n <= 0xff)
+            {
+                _sink.put('\xd9');
+                write_big_endian(_sink, n, 1);
+            }
+            else
+            {
+                write_header(n, 0, 0xda, 0xdb);
+            }
+            _sink.write(s.data(), n);
+        }
+
+        // 数组、对象或长字符串的长度：fix 类型（fix 不为 0 时）、16 位或 32 位
+        void write_header(uint64_t n, unsigned fix, unsigned code16, unsigned code32)
+        {
+            if (fix != 0 && n <= 15)
+            {
+                _sink.put(static_cast<char>(fix | n));
+            }
+            else if (n <= 0xffff)
+            {
+                _sink.put(static_cast<char>(code16));
+                write_big_endian(_sink, n, 2);
+            }
+            else if (n <= 0xffffffffULL)
+            {
+                _sink.put(static_cast<char>(code32));
+                write_big_endian(_sink, n, 4);
+            }
+            else
+            {
+                TINYJSON_THROW(std::runtime_error("value too large for msgpack"));
+            }
+        }
+
+        Sink &_sink; ///< 输出目标
+    };
+
+    // MessagePack 编解码
+    template <class BasicJson>
+    class basic_msgpack
+    {
+    public:
+        using json_type = BasicJson;
+        using allocator_type = typename json_type::allocator_type;
+
+        /// 编码到 sink
+        template <class Sink>
+        static void encode(const json_type &j, Sink &sink)
+        {
+            basic_msgpack_writer<Sink> writer(sink);
+            writer.write(j);
+        }
+
+        /// 编码为字节串
+        static std::string encode(const json_type &j)
+        {
+            std::string out;
+            string_sink<std::string> sink(out);
+            encode(j, sink);
+            return out;
+        }
+
+        /// 解码为 json，格式错误时抛出 parse_exception
+        static json_type decode(const char *s, size_t length, const allocator_type &alloc = allocator_type())
+        {
+            dom_handler<json_type> handler(alloc);
+            sax_decode(s, length, handler);
+            return std::move(handler.result());
+        }
+
+        static json_type decode(const std::string &s, const allocator_type &alloc = allocator_type())
+        {
+            return decode(s.data(), s.size(), alloc);
+        }
+
+        /// 解码为 json，字符串值借用输入中的字节；输入必须在结果（及其拷贝）的整个生命周期内保持有效
+        static json_type decode(const char *s, size_t length, borrow_t, const allocator_type &alloc = allocator_type())
+        {
+            dom_handler<json_type> handler(alloc, true);
+            sax_decode(s, length, handler);
+            return std::move(handler.result());
+        }
+
+        /// 不抛出异常的解码：格式错误时返回 null 并写入 error
+        static json_type decode(const char *s, size_t length, parse_error &error, const allocator_type &alloc = allocator_type())
+        {
+            dom_handler<json_type> handler(alloc);
+            if (!sax_decode(s, length, handler, error))
+            {
+                return json_type();
+            }
+            return std::move(handler.result());
+        }
+
+        /// 解码并把对应的事件交给 handler，事件与文本 JSON 的 SAX 解析相同
+        template <class Handler>
+        static bool sax_decode(const char *s, size_t length, Handler &handler)
+        {
+            byte_cursor cursor(s, length);
+            return decode_document(cursor, handler);
+        }
+
+        template <class Handler>
+        static bool sax_decode(const char *s, size_t length, Handler &handler, parse_error &error)
+        {
+            error = parse_error();
+            byte_cursor cursor(s, length);
+            cursor.error = &error;
+            return decode_document(cursor, handler);
+        }
+
+    private:
+        template <class Handler>
+        static bool decode_document(byte_cursor &cursor, Handler &handler)
+        {
+            if (!decode_value(cursor, handler))
+            {
+                return false;
+            }
+            if (cursor.cur != cursor.end)
+            {
+                return parse_fail(cursor, parse_errc::trailing_characters);
+            }
+            return true;
+        }
+
+        template <class Handler>
+        static bool decode_value(byte_cursor &cursor, Handler &handler)
+        {
+            if (cursor.cur >= cursor.end)
+            {
+                return parse_fail(cursor, parse_errc::unexpected_end);
+            }
+            unsigned b = static_cast<unsigned char>(*cursor.cur++);
+            if (b <= 0x7f)
+            {
+                return handler.number_integer(static_cast<long long>(b)); // positive fixint
+            }
+            if (b >= 0xe0)
+            {
+                return handler.number_integer(static_cast<long long>(b) - 0x100); // negative fixint
+            }
+            if ((b & 0xe0) == 0xa0)
+            {
+                return decode_string(cursor, b & 0x1f, handler); // fixstr
+            }
+            if ((b & 0xf0) == 0x90)
+            {
+                return decode_array(cursor, b & 0x0f, handler); // fixarray
+            }
+            if ((b & 0xf0) == 0x80)
+            {
+                return decode_map(cursor, b & 0x0f, handler); // fixmap
+            }
+
+            uint64_t n = 0;
+            switch (b)
+            {
+            case 0xc0:
+                return handler.null();
+            case 0xc2:
+                return handler.boolean(false);
+            case 0xc3:
+                return handler.boolean(true);
+
+            case 0xcc: // uint 8/16/32/64
+            case 0xcd:
+            case 0xce:
+            case 0xcf:
+                if (!read_big_endian(cursor, size_t(1) << (b - 0xcc), n))
+                {
+                    return false;
+                }
+                if (n > static_cast<uint64_t>(std::numeric_limits<long long>::max()))
+                {
+                    return handler.number_double(static_cast<double>(n)); // 超出 long long 的范围
+                }
+                return handler.number_integer(static_cast<long long>(n));
+
+            case 0xd0: // int 8/16/32/64
+            case 0xd1:
+            case 0xd2:
+            case 0xd3:
+            {
+                size_t bytes = size_t(1) << (b - 0xd0);
+                if (!read_big_endian(cursor, bytes, n))
+                {
+                    return false;
+                }
+                if (bytes < 8 && (n >> (bytes * 8 - 1)) != 0)
+                {
+                    n |= ~uint64_t(0) << (bytes * 8); // 符号扩展
+                }
+                long long v;
+                std::memcpy(&v, &n, sizeof(v));
+                return handler.number_integer(v);
+            }
+
+            case 0xca: // float 32
+            {
+                if (!read_big_endian(cursor, 4, n))
+                {
+                    return false;
+                }
+                uint32_t bits = static_cast<uint32_t>(n);
+                float f;
+                std::memcpy(&f, &bits, sizeof(f));
+                return handler.number_double(static_cast<double>(f));
+            }
+
+            case 0xcb: // float 64
+            {
+                if (!read_big_endian(cursor, 8, n))
+                {
+                    return false;
+                }
+                double d;
+                std::memcpy(&d, &n, sizeof(d));
+                return handler.number_double(d);
+            }
+
+            case 0xd9: // str 8/16/32
+            case 0xc4: // bin 8/16/32
+                return read_big_endian(cursor, 1, n) && decode_string(cursor, n, handler);
+            case 0xda:
+            case 0xc5:
+                return read_big_endian(cursor, 2, n) && decode_string(cursor, n, handler);
+            case 0xdb:
+            case 0xc6:
+                return read_big_endian(cursor, 4, n) && decode_string(cursor, n, handler);
+
+            case 0xdc: // array 16/32
+                return read_big_endian(cursor, 2, n) && decode_array(cursor, n, handler);
+            case 0xdd:
+                return read_big_endian(cursor, 4, n) && decode_array(cursor, n, handler);
+
+            case 0xde: // map 16/32
+                return read_big_endian(cursor, 2, n) && decode_map(cursor, n, handler);
+            case 0xdf:
+                return read_big_endian(cursor, 4, n) && decode_map(cursor, n, handler);
+
+            default: // 扩展类型和保留的类型字节
+                --cursor.cur;
+                return parse_fail(cursor, parse_errc::unexpected_character);
+            }
+        }
+
+        template <class Handler>
+        static bool decode_string(byte_cursor &cursor, uint64_t length, Handler &handler)
+        {
+            string_view s = read_bytes(cursor, length);
+            return s.data() != nullptr && handler.string(s);
+        }
+
+        template <class Handler>
+        static bool decode_array(byte_cursor &cursor, uint64_t count, Handler &handler)
+        {
+            if (!enter_nested(cursor) || !handler.start_array())
+            {
+                return false;
+            }
+            for (uint64_t i = 0; i < count; i++)
+            {
+                if (!decode_value(cursor, handler))
+                {
+                    return false;
+                }
+            }
+            --cursor.depth;
+            return handler.end_array();
+        }
+
+        template <class Handler>
+        static bool decode_map(byte_cursor &cursor, uint64_t count, Handler &handler)
+        {
+            if (!enter_nested(cursor) || !handler.start_object())
+            {
+                return false;
+            }
+            for (uint64_t i = 0; i < count; i++)
+            {
+                string_view key = decode_key(cursor);
+                if (key.data() == nullptr || !handler.key(key) || !decode_value(cursor, handler))
+                {
+                    return false;
+                }
+            }
+            --cursor.depth;
+            return handler.end_object();
+        }
+
+        // 读取对象的键名，键名只能是 str 类型
+        static string_view decode_key(byte_cursor &cursor)
+        {
+            unsigned b = cursor.peek() == EOF ? 0 : static_cast<unsigned char>(*cursor.cur);
+            uint64_t n = 0;
+            bool ok;
+            if ((b & 0xe0) == 0xa0)
+            {
+                ++cursor.cur;
+                n = b & 0x1f;
+                ok = true;
+            }
+            else if (b >= 0xd9 && b <= 0xdb)
+            {
+                ++cursor.cur;
+                ok = read_big_endian(cursor, size_t(1) << (b - 0xd9), n);
+            }
+            else
+            {
+                ok = parse_fail(cursor, parse_errc::invalid_object);
+            }
+            return ok ? read_bytes(cursor, n) : string_view();
+        }
+    };
+
+    using msgpack = basic_msgpack<json>;
+
+    // 按 CBOR（RFC 8949）格式写出值
+    // write 写出 json 值，数组和对象使用确定长度；同时也是 SAX 处理器，
+    // 配合 sax_parse 可以把 JSON 文本直接转换为 CBOR，这时数组和对象使用不定长度，不需要事先知道元素个数
+    template <class Sink>
+    class basic_cbor_writer
+    {
+    public:
+        explicit basic_cbor_writer(Sink &sink) : _sink(sink) {}
+
+        template <class BasicJson>
+        void write(const BasicJson &j)
+        {
+            switch (j.type())
+            {
+            case json_t::null:
+                null();
+                break;
+
+            case json_t::boolean:
+                boolean(j.get_bool());
+                break;
+
+            case json_t::number_integer:
+                number_integer(j.get_integer());
+                break;
+
+            case json_t::number_double:
+                number_double(j.get_double());
+                break;
+
+            case json_t::string:
+                string(j.get_string_view());
+                break;
+
+            case json_t::array:
+                write_header(4, j.size());
+                for (const auto &elem : j.get_array())
+                {
+                    write(elem);
+                }
+                break;
+
+            case json_t::object:
+                write_header(5, j.size());
+                for (const auto &member : j.get_object())
+                {
+                    key(string_view(member.first.data(), member.first.size()));
+                    write(member.second);
+                }
+                break;
+
+            default:
+                TINYJSON_THROW(std::runtime_error("invalid json type"));
+            }
+        }
+
+        bool null()
+        {
+            _sink.put('\xf6');
+            return true;
+        }
+
+        bool boolean(bool val)
+        {
+            _sink.put(val ? '\xf5' : '\xf4');
+            return true;
+        }
+
+        bool number_integer(long long val)
+        {
+            if (val >= 0)
+            {
+                write_header(0, static_cast<uint64_t>(val));
+            }
+            else
+            {
+                write_header(1, static_cast<uint64_t>(-(val + 1))); // 负整数编码为 -1 - n
+            }
+            return true;
+        }
+
+        bool number_double(double val)
+        {
+            uint64_t bits;
+            std::memcpy(&bits, &val, sizeof(bits));
+            _sink.put('\xfb');
+            write_big_endian(_sink, bits, 8);
+            return true;
+        }
+
+        bool string(string_view val)
+        {
+            write_header(3, val.size());
+            _sink.write(val.data(), val.size());
+            return true;
+        }
+
+        bool key(string_view name) { return string(name); }
+
+        bool start_object()
+        {
+            _sink.put('\xbf');
+            return true;
+        }
+
+        bool end_object()
+        {
+            _sink.put('\xff');
+            return true;
+        }
+
+        bool start_array()
+        {
+            _sink.put('\x9f');
+            return true;
+        }
+
+        bool end_array()
+        {
+            _sink.put('\xff');
+            return true;
+        }
+
+    private:
+        // 写出主类型 major 和参数 n，参数使用最短的表示
+        void write_header(unsigned major, uint64_t n)
+        {
+            char m = static_cast<char>(major << 5);
+            if (n < 24)
+            {
+                _sink.put(static_cast<char>(m | static_cast<char>(n)));
+            }
+            else if (n <= 0xff)
+            {
+                _sink.put(static_cast<char>(m | 24));
+                write_big_endian(_sink, n, 1);
+            }
+            else if (n <= 0xffff)
+            {
+                _sink.put(static_cast<char>(m | 25));
+                write_big_endian(_sink, n, 2);
+            }
+            else if (n <= 0xffffffffULL)
+            {
+                _sink.put(static_cast<char>(m | 26));
+                write_big_endian(_sink, n, 4);
+            }
+            else
+            {
+                _sink.put(static_cast<char>(m | 27));
+                write_big_endian(_sink, n, 8);
+            }
+        }
+
+        Sink &_sink; ///< 输出目标
+    };
+
+    // CBOR 编解码；解码支持确定长度和不定长度的字符串与容器、半精度到双精度的浮点数，标签被忽略，undefined 读作 null
+    template <class BasicJson>
+    class basic_cbor
+    {
+    public:
+        using json_type = BasicJson;
+        using allocator_type = typename json_type::allocator_type;
+
+        /// 编码到 sink
+        template <class Sink>
+        static void encode(const json_type &j, Sink &sink)
+        {
+            basic_cbor_writer<Sink> writer(sink);
+            writer.write(j);
+        }
+
+        /// 编码为字节串
+        static std::string encode(const json_type &j)
+        {
+            std::string out;
+            string_sink<std::string> sink(out);
+            encode(j, sink);
+            return out;
+        }
+
+        /// 解码为 json，格式错误时抛出 parse_exception
+        static json_type decode(const char *s, size_t length, const allocator_type &alloc = allocator_type())
+        {
+            dom_handler<json_type> handler(alloc);
+            sax_decode(s, length, handler);
+            return std::move(handler.result());
+        }
+
+        static json_type decode(const std::string &s, const allocator_type &alloc = allocator_type())
+        {
+            return decode(s.data(), s.size(), alloc);
+        }
+
+        /// 解码为 json，确定长度的字符串值借用输入中的字节；输入必须在结果（及其拷贝）的整个生命周期内保持有效
+        static json_type decode(const char *s, size_t length, borrow_t, const allocator_type &alloc = allocator_type())
+        {
+            borrowing_handler handler(s, s + length, alloc);
+            sax_decode(s, length, handler);
+            return std::move(handler.result());
+        }
+
+        /// 不抛出异常的解码：格式错误时返回 null 并写入 error
+        static json_type decode(const char *s, size_t length, parse_error &error, const allocator_type &alloc = allocator_type())
+        {
+            dom_handler<json_type> handler(alloc);
+            if (!sax_decode(s, length, handler, error))
+            {
+                return json_type();
+            }
+            return std::move(handler.result());
+        }
+
+        /// 解码并把对应的事件交给 handler，事件与文本 JSON 的 SAX 解析相同
+        template <class Handler>
+        static bool sax_decode(const char *s, size_t length, Handler &handler)
+        {
+            byte_cursor cursor(s, length);
+            return decode_document(cursor, handler);
+        }
+
+        template <class Handler>
+        static bool sax_decode(const char *s, size_t length, Handler &handler, parse_error &error)
+        {
+            error = parse_error();
+            byte_cursor cursor(s, length);
+            cursor.error = &error;
+            return decode_document(cursor, handler);
+        }
+
+    private:
+        static const uint64_t indefinite = ~uint64_t(0); ///< 不定长度
+
+        // 借用输入中字符串的 dom_handler；不定长度的字符串由多段拼接在临时缓冲区中，不在输入范围内，只能复制
+        class borrowing_handler : public dom_handler<json_type>
+        {
+        public:
+            borrowing_handler(const char *begin, const char *end, const allocator_type &alloc)
+                : dom_handler<json_type>(alloc, true), _begin(begin), _end(end) {}
+
+            bool string(string_view val)
+            {
+                if (_begin <= val.data() && val.data() < _end)
+                {
+                    return dom_handler<json_type>::string(val);
+                }
+                return this->copy_string(val);
+            }
+
+        private:
+            const char *_begin; ///< 输入的起始位置
+            const char *_end;   ///< 输入的结束位置（不包含）
+        };
+
+        template <class Handler>
+        static bool decode_document(byte_cursor &cursor, Handler &handler)
+        {
+            std::string scratch; // 拼接不定长度的字符串
+            if (!decode_value(cursor, handler, scratch))
+            {
+                return false;
+            }
+            if (cursor.cur != cursor.end)
+            {
+                return parse_fail(cursor, parse_errc::trailing_characters);
+            }
+            return true;
+        }
+
+        // 读取初始字节之后的参数；info 为 31 时返回不定长度
+        static bool read_argument(byte_cursor &cursor, unsigned info, uint64_t &n)
+        {
+            if (info < 24)
+            {
+                n = info;
+                return true;
+            }
+            if (info <= 27)
+            {
+                return read_big_endian(cursor, size_t(1) << (info - 24), n);
+            }
+            if (info == 31)
+            {
+                n = indefinite;
+                return true;
+            }
+            --cursor.cur;
+            return parse_fail(cursor, parse_errc::unexpected_character);
+        }
+
+        // 在 cursor 处是否为不定长度容器的结束标记 0xff，是时跳过它
+        static bool at_break(byte_cursor &cursor)
+        {
+            if (cursor.peek() == 0xff)
+            {
+                ++cursor.cur;
+                return true;
+            }
+            return false;
+        }
+
+        template <class Handler>
+        static bool decode_value(byte_cursor &cursor, Handler &handler, std::string &scratch)
+        {
+            if (cursor.cur >= cursor.end)
+            {
+                return parse_fail(cursor, parse_errc::unexpected_end);
+            }
+            unsigned b = static_cast<unsigned char>(*cursor.cur++);
+            unsigned major = b >> 5;
+            unsigned info = b & 0x1f;
+            uint64_t n = 0;
+
+            if (major == 7)
+            {
+                return decode_simple(cursor, info, handler);
+            }
+            if (!read_argument(cursor, info, n))
+            {
+                return false;
+            }
+
+            switch (major)
+            {
+            case 0: // 无符号整数
+                if (info == 31)
+                {
+                    break;
+                }
+                if (n > static_cast<uint64_t>(std::numeric_limits<long long>::max()))
+                {
+                    return handler.number_double(static_cast<double>(n));
+                }
+                return handler.number_integer(static_cast<long long>(n));
+
+            case 1: // 负整数 -1 - n
+                if (info == 31)
+                {
+                    break;
+                }
+                if (n > static_cast<uint64_t>(std::numeric_limits<long long>::max()))
+                {
+                    return handler.number_double(-1.0 - static_cast<double>(n));
+                }
+                return handler.number_integer(-1 - static_cast<long long>(n));
+
+            case 2: // 字节串和文本串
+            case 3:
+            {
+                string_view s = decode_string(cursor, major, n, scratch);
+                return s.data() != nullptr && handler.string(s);
+            }
+
+            case 4: // 数组
+                if (!enter_nested(cursor) || !handler.start_array())
+                {
+                    return false;
+                }
+                for (uint64_t i = 0; n == indefinite ? !at_break(cursor) : i < n; i++)
+                {
+                    if (!decode_value(cursor, handler, scratch))
+                    {
+                        return false;
+                    }
+                }
+                --cursor.depth;
+                return handler.end_array();
+
+            case 5: // 对象，键名只能是文本串
+                if (!enter_nested(cursor) || !handler.start_object())
+                {
+                    return false;
+                }
+                for (uint64_t i = 0; n == indefinite ? !at_break(cursor) : i < n; i++)
+                {
+                    string_view key = decode_key(cursor, scratch);
+                    if (key.data() == nullptr || !handler.key(key) || !decode_value(cursor, handler, scratch))
+                    {
+                        return false;
+                    }
+                }
+                --cursor.depth;
+                return handler.end_object();
+
+            case 6: // 标签：忽略，读取被标记的值；嵌套的标签同样递归，计入嵌套深度
+                if (info == 31)
+                {
+                    break;
+                }
+                if (!enter_nested(cursor) || !decode_value(cursor, handler, scratch))
+                {
+                    return false;
+                }
+                --cursor.depth;
+                return true;
+            }
+
+            --cursor.cur; // 整数和标签不能是不定长度
+            return parse_fail(cursor, parse_errc::unexpected_character);
+        }
+
+        // 主类型 7：简单值和浮点数
+        template <class Handler>
+        static bool decode_simple(byte_cursor &cursor, unsigned info, Handler &handler)
+        {
+            uint64_t n = 0;
+            switch (info)
+            {
+            case 20:
+                return handler.boolean(false);
+            case 21:
+                return handler.boolean(true);
+            case 22: // null
+            case 23: // undefined
+                return handler.null();
+
+            case 25: // 半精度浮点数
+            {
+                if (!read_big_endian(cursor, 2, n))
+                {
+                    return false;
+                }
+                unsigned exp = (n >> 10) & 0x1f;
+                unsigned mant = n & 0x3ff;
+                double d = exp == 0    ? std::ldexp(static_cast<double>(mant), -24)
+                           : exp != 31 ? std::ldexp(static_cast<double>(mant + 1024), static_cast<int>(exp) - 25)
+                           : mant == 0 ? std::numeric_limits<double>::infinity()
+                                       : std::numeric_limits<double>::quiet_NaN();
+                return handler.number_double((n & 0x8000) != 0 ? -d : d);
+            }
+
+            case 26: // 单精度浮点数
+            {
+                if (!read_big_endian(cursor, 4, n))
+                {
+                    return false;
+                }
+                uint32_t bits = static_cast<uint32_t>(n);
+                float f;
+                std::memcpy(&f, &bits, sizeof(f));
+                return handler.number_double(static_cast<double>(f));
+            }
+
+            case 27: // 双精度浮点数
+            {
+                if (!read_big_endian(cursor, 8, n))
+                {
+                    return false;
+                }
+                double d;
+                std::memcpy(&d, &n, sizeof(d));
+                return handler.number_double(d);
+            }
+
+            default: // 其他简单值
+                --cursor.cur;
+                return parse_fail(cursor, parse_errc::unexpected_character);
+            }
+        }
+
+        // 读取字节串或文本串；确定长度时直接返回指向输入的视图，不定长度时把各段拼接到 scratch 中
+        static string_view decode_string(byte_cursor &cursor, unsigned major, uint64_t n, std::string &scratch)
+        {
+            if (n != indefinite)
+            {
+                return read_bytes(cursor, n);
+            }
+            scratch.clear();
+            while (!at_break(cursor))
+            {
+                // 每一段必须是相同主类型、确定长度的字符串
+                unsigned b = cursor.peek() == EOF ? 0 : static_cast<unsigned char>(*cursor.cur);
+                uint64_t length = 0;
+                if (cursor.cur >= cursor.end || (b >> 5) != major || (b & 0x1f) == 31)
+                {
+                    parse_fail(cursor, parse_errc::unexpected_character);
+                    return string_view();
+                }
+                ++cursor.cur;
+                string_view chunk;
+                if (!read_argument(cursor, b & 0x1f, length) || (chunk = read_bytes(cursor, length)).data() == nullptr)
+                {
+                    return string_view();
+                }
+                scratch.append(chunk.data(), chunk.size());
+            }
+            return string_view(scratch.data(), scratch.size());
+        }
+
+        static string_view decode_key(byte_cursor &cursor, std::string &scratch)
+        {
+            if (cursor.cur >= cursor.end || (static_cast<unsigned char>(*cursor.cur) >> 5) != 3)
+            {
+                parse_fail(cursor, parse_errc::invalid_object);
+                return string_view();
+            }
+            unsigned info = static_cast<unsigned char>(*cursor.cur++) & 0x1f;
+            uint64_t n = 0;
+            if (!read_argument(cursor, info, n))
+            {
+                return string_view();
+            }
+            return decode_string(cursor, 3, n, scratch);
+        }
+    };
+
+    using cbor = basic_cbor<json>;
+
+#if !defined(TINYJSON_NO_THREADS)
+    // 多线程并行解析大型 NDJSON 输入或根节点为数组的文档，结果按输入顺序交付
+    // 输入在记录边界处切成若干段：NDJSON 按换行切分；根数组先做一遍识别字符串的预扫描，在顶层的逗号处切分
+    // 各段由线程池解析，同时在途的段数有上限，因此逐条交付时内存占用与输入总量无关
+    // 每条记录使用默认构造的分配器；解析出错或回调抛出异常时停止全部线程，并在调用线程中重新抛出
+    template <class BasicJson>
+    class basic_parallel_parser
+    {
+    public:
+        using json_type = BasicJson;
+
+        /// 输入小于该字节数时直接在调用线程中解析
+        static const size_t min_parallel_size = 1 << 20;
+
+        /// 每段的最小字节数
+        static const size_t min_chunk_size = 1 << 16;
+
+        /// 解析 NDJSON：每个非空行是一条记录，按顺序逐条调用 callback(json_type &&)
+        /// threads 为 0 时使用硬件支持的并发线程数
+        template <class Callback>
+        static void for_each_ndjson(const char *s, size_t length, Callback callback, unsigned threads = 0)
+        {
+            threads = thread_count(length, threads);
+            run(split_lines(s, length, chunk_size(length, threads)), parse_lines, callback, threads);
+        }
+
+        /// 解析根节点为数组的文档，按顺序逐个调用 callback(json_type &&)
+        template <class Callback>
+        static void for_each_array(const char *s, size_t length, Callback callback, unsigned threads = 0)
+        {
+            threads = thread_count(length, threads);
+            run(split_array(s, length, chunk_size(length, threads)), parse_elements, callback, threads);
+        }
+
+        /// 解析 NDJSON，返回全部记录
+        static std::vector<json_type> parse_ndjson(const char *s, size_t length, unsigned threads = 0)
+        {
+            std::vector<json_type> records;
+            for_each_ndjson(s, length, [&records](json_type &&v) { records.push_back(std::move(v)); }, threads);
+            return records;
+        }
+
+        static std::vector<json_type> parse_ndjson(const std::string &s, unsigned threads = 0)
+        {
+            return parse_ndjson(s.data(), s.size(), threads);
+        }
+
+        /// 解析根节点为数组的文档，返回全部元素
+        static std::vector<json_type> parse_array(const char *s, size_t length, unsigned threads = 0)
+        {
+            std::vector<json_type> elems;
+            for_each_array(s, length, [&elems](json_type &&v) { elems.push_back(std::move(v)); }, threads);
+            return elems;
+        }
+
+        static std::vector<json_type> parse_array(const std::string &s, unsigned threads = 0)
+        {
+            return parse_array(s.data(), s.size(), threads);
+        }
+
+    private:
+        using parser_type = basic_parser<json_type>;
+
+        /// 输入中的一段，只包含完整的记录
+        struct chunk
+        {
+            const char *begin; ///< 段的开头
+            const char *end;   ///< 段的结束位置（不包含）
+        };
+
+        static unsigned thread_count(size_t length, unsigned threads)
+        {
+            if (threads == 0)
+            {
+                threads = std::thread::hardware_concurrency();
+            }
+            return length < min_parallel_size || threads == 0 ? 1 : threads;
+        }
+
+        // 每个线程大约分到 8 段，使各线程的负载更均衡
+        static size_t chunk_size(size_t length, unsigned threads)
+        {
+            size_t size = length / (static_cast<size_t>(threads) * 8);
+            if (size < min_chunk_size)
+            {
+                size = min_chunk_size;
+            }
+            return size;
+        }
+
+        // 按换行切分，每段约 target 字节
+        static std::vector<chunk> split_lines(const char *s, size_t length, size_t target)
+        {
+            std::vector<chunk> chunks;
+            const char *end = s + length;
+            const char *begin = s;
+            while (begin < end)
+            {
+                const char *cut = end;
+                if (static_cast<size_t>(end - begin) > target)
+                {
+                    const void *nl = std::memchr(begin + target, '\n', static_cast<size_t>(end - begin - target));
+                    cut = nl ? static_cast<const char *>(nl) + 1 : end;
+                }
+                chunks.push_back(chunk{begin, cut});
+                begin = cut;
+            }
+            return chunks;
+        }
+
+        // 预扫描根数组，在顶层的逗号处切分，每段约 target 字节（不含方括号和切分处的逗号）
+        // 预扫描只负责找出边界，每段内容仍由解析器完整校验
+        static std::vector<chunk> split_array(const char *s, size_t length, size_t target)
+        {
+            std::vector<chunk> chunks;
+            const char *end = s + length;
+            const char *p = skip_whitespace(s, end);
+            if (p == end || *p != '[')
+            {
+                TINYJSON_THROW(std::runtime_error("expected char '[' not found"));
+            }
+
+            const char *begin = ++p;
+            const char *first = skip_whitespace(p, end);
+            if (first != end && *first == ']')
+            {
+                p = first + 1; // 空数组
+            }
+            else
+            {
+                size_t depth = 0;
+                for (;; ++p)
+                {
+                    if (p == end)
+                    {
+                        TINYJSON_THROW(std::runtime_error("expected char ']' not found"));
+                    }
+
+                    char c = *p;
+                    if (c == '"')
+                    {
+                        p = skip_string(p, end) - 1;
+                    }
+                    else if (c == '{' || c == '[')
+                    {
+                        ++depth;
+                    }
+                    else if (c == '}' || c == ']')
+                    {
+                        if (depth == 0)
+                        {
+                            if (c != ']')
+                            {
+                                TINYJSON_THROW(std::runtime_error("expected char ']' not found"));
+                            }
+                            chunks.push_back(chunk{begin, p++});
+                            break;
+                        }
+                        --depth;
+                    }
+                    else if (c == ',' && depth == 0 && static_cast<size_t>(p - begin) >= target)
+                    {
+                        chunks.push_back(chunk{begin, p});
+                        begin = p + 1;
+                    }
+                }
+            }
+
+            if (skip_whitespace(p, end) != end)
+            {
+                TINYJSON_THROW(std::runtime_error("unexpected character"));
+            }
+            return chunks;
+        }
+
+        // 跳过从开头的双引号开始的字符串，返回结尾双引号之后的位置
+        static const char *skip_string(const char *p, const char *end)
+        {
+            for (++p;; ++p)
+            {
+                p = find_string_special(p, end);
+                if (p == end)
+                {
+                    break;
+                }
+                if (*p == '"')
+                {
+                    return p + 1;
+                }
+                if (*p == '\\' && ++p == end)
+                {
+                    break;
+                }
+            }
+            TINYJSON_THROW(std::runtime_error("expected char '\"' not found"));
+        }
+
+        // 解析一段 NDJSON 中的每个非空行
+        static std::vector<json_type> parse_lines(chunk c)
+        {
+            TINYJSON_STAT_TIMER(parse_ns);
+            TINYJSON_STAT_ADD(bytes_parsed, static_cast<uint64_t>(c.end - c.begin));
+            std::vector<json_type> records;
+            for (const char *line = c.begin; line < c.end;)
+            {
+                const void *nl = std::memchr(line, '\n', static_cast<size_t>(c.end - line));
+                const char *line_end = nl ? static_cast<const char *>(nl) : c.end;
+                if (skip_whitespace(line, line_end) != line_end)
+                {
+                    byte_cursor cursor(line, static_cast<size_t>(line_end - line));
+                    records.push_back(parser_type::parse_value(cursor));
+                    if (parser_type::peek_next_non_space(cursor) != EOF)
+                    {
+                        TINYJSON_THROW(std::runtime_error("unexpected character"));
+                    }
+                }
+                line = line_end + 1;
+            }
+            return records;
+        }
+
+        // 解析一段以逗号分隔的数组元素
+        static std::vector<json_type> parse_elements(chunk c)
+        {
+            TINYJSON_STAT_TIMER(parse_ns);
+            TINYJSON_STAT_ADD(bytes_parsed, static_cast<uint64_t>(c.end - c.begin));
+            std::vector<json_type> elems;
+            byte_cursor cursor(c.begin, static_cast<size_t>(c.end - c.begin));
+            while (true)
+            {
+                elems.push_back(parser_type::parse_value(cursor));
+                int next = parser_type::get_next_non_space(cursor);
+                if (next == EOF)
+                {
+                    return elems;
+                }
+                if (next != ',')
+                {
+                    TINYJSON_THROW(std::runtime_error("expected char ']' not found"));
+                }
+            }
+        }
+
+        // 用 threads 个线程解析各段，并按顺序把结果交给 callback
+        // 线程最多领先交付进度 2 * threads 段，避免结果在内存中堆积
+        template <class Parse, class Callback>
+        static void run(const std::vector<chunk> &chunks, Parse parse, Callback &callback, unsigned threads)
+        {
+            if (threads > chunks.size())
+            {
+                threads = static_cast<unsigned>(chunks.size());
+            }
+            if (threads <= 1)
+            {
+                for (size_t i = 0; i < chunks.size(); i++)
+                {
+                    std::vector<json_type> values = parse(chunks[i]);
+                    for (size_t j = 0; j < values.size(); j++)
+                    {
+                        callback(std::move(values[j]));
+                    }
+                }
+                return;
+            }
+
+            std::vector<slot> slots(chunks.size());
+            pool_state state(static_cast<size_t>(threads) * 2);
+            worker_pool pool(state);
+            for (unsigned t = 0; t < threads; t++)
+            {
+                pool.threads.push_back(std::thread([&]() {
+                    size_t i;
+                    while (state.take(chunks.size(), i))
+                    {
+                        slot result;
+                        TINYJSON_TRY
+                        {
+                            result.values = parse(chunks[i]);
+                        }
+                        TINYJSON_CATCH(...)
+                        {
+                            result.error = std::current_exception();
+                        }
+                        state.complete(slots[i], std::move(result));
+                    }
+                }));
+            }
+
+            for (size_t i = 0; i < chunks.size(); i++)
+            {
+                std::vector<json_type> values = state.deliver(slots[i], i);
+                for (size_t j = 0; j < values.size(); j++)
+                {
+                    callback(std::move(values[j]));
+                }
+            }
+        }
+
+        /// 一段的解析结果
+        struct slot
+        {
+            std::vector<json_type> values; ///< 解析出的记录
+            std::exception_ptr error;      ///< 解析失败时的异常
+            bool ready = false;            ///< 是否已经解析完成
+        };
+
+        /// 工作线程与交付线程共享的状态
+        struct pool_state
+        {
+            explicit pool_state(size_t window) : window(window) {}
+
+            // 领取下一段，全部领完或已经停止时返回 false
+            bool take(size_t count, size_t &i)
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cv.wait(lock, [&]() { return stop || next >= count || next < delivered + window; });
+                if (stop || next >= count)
+                {
+                    return false;
+                }
+                i = next++;
+                return true;
+            }
+
+            void complete(slot &s, slot &&result)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    s = std::move(result);
+                    s.ready = true;
+                }
+                cv.notify_all();
+            }
+
+            // 等待第 i 段完成并取走结果，解析失败时重新抛出异常
+            std::vector<json_type> deliver(slot &s, size_t i)
+            {
+                std::vector<json_type> values;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    cv.wait(lock, [&]() { return s.ready; });
+                    if (s.error)
+                    {
+                        std::rethrow_exception(s.error);
+                    }
+                    values.swap(s.values);
+                    delivered = i + 1;
+                }
+                cv.notify_all();
+                return values;
+            }
+
+            std::mutex mutex;
+            std::condition_variable cv;
+            size_t window;        ///< 最多领先交付进度的段数
+            size_t next = 0;      ///< 下一段待领取的下标
+            size_t delivered = 0; ///< 已交付的段数
+            bool stop = false;    ///< 出错时通知工作线程退出
+        };
+
+        /// 离开作用域时（包括异常）停止并等待全部工作线程
+        struct worker_pool
+        {
+            explicit worker_pool(pool_state &state) : state(state) {}
+            ~worker_pool()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(state.mutex);
+                    state.stop = true;
+                }
+                state.cv.notify_all();
+                for (size_t i = 0; i < threads.size(); i++)
+                {
+                    threads[i].join();
+                }
+            }
+
+            pool_state &state;
+            std::vector<std::thread> threads;
+        };
+    };
+
+    using parallel_parser = basic_parallel_parser<json>;
+#endif
+
+    class lazy_value;
+    struct path_access;
+
+    // 按需解析的文档
+    // 构造时只扫描一遍输入，记录每个括号以及与之配对的括号；字符串和数值在通过 lazy_value 访问时才解码，
+    // 查找成员或元素时，途经的无关子树按括号配对直接跳过，不会被递归解析
+    // 文档不复制输入，输入必须在文档及其 lazy_value 使用期间保持有效
+    // 构造时只校验括号配对和字符串的结束位置，其余语法错误在访问到相应的值时才报告
+    class lazy_document
+    {
+    public:
+        lazy_document(const char *s, size_t length) : _begin(s), _end(s + length), _root(nullptr) { build_index(); }
+        explicit lazy_document(const char *s) : lazy_document(s, std::char_traits<char>::length(s)) {}
+        explicit lazy_document(const std::string &s) : lazy_document(s.data(), s.size()) {}
+        lazy_document(std::string &&) = delete; // 临时字符串会先于文档销毁
+
+        /// 根节点
+        lazy_value root() const;
+
+        /// 索引中括号的数量
+        size_t bracket_count() const { return _brackets.size(); }
+
+    private:
+        friend class lazy_value;
+
+        /// 一个括号在输入中的位置以及与之配对的括号
+        struct bracket
+        {
+            uint32_t offset; ///< 在输入中的偏移
+            uint32_t match;  ///< 配对括号在索引中的下标
+        };
+
+        // 扫描输入，建立括号的配对索引，并确认根节点之后只有空白
+        void build_index()
+        {
+            if (static_cast<size_t>(_end - _begin) > UINT32_MAX)
+            {
+                TINYJSON_THROW(std::runtime_error("document too large"));
+            }
+
+            std::vector<uint32_t> open; // 尚未配对的左括号
+            for (const char *p = _begin; p < _end; ++p)
+            {
+                switch (*p)
+                {
+                case '"':
+                    p = skip_string(p) - 1; // 字符串中的括号不参与配对
+                    break;
+
+                case '{':
+                case '[':
+                    open.push_back(static_cast<uint32_t>(_brackets.size()));
+                    _brackets.push_back(bracket{static_cast<uint32_t>(p - _begin), 0});
+                    break;
+
+                case '}':
+                case ']':
+                {
+                    if (open.empty() || _begin[_brackets[open.back()].offset] != (*p == '}' ? '{' : '['))
+                    {
+                        TINYJSON_THROW(std::runtime_error("mismatched brackets"));
+                    }
+                    uint32_t i = open.back();
+                    open.pop_back();
+                    _brackets[i].match = static_cast<uint32_t>(_brackets.size());
+                    _brackets.push_back(bracket{static_cast<uint32_t>(p - _begin), i});
+                    break;
+                }
+
+                default:
+                    break;
+                }
+            }
+            if (!open.empty())
+            {
+                TINYJSON_THROW(std::runtime_error("mismatched brackets"));
+            }
+
+            _root = skip_whitespace(_begin, _end);
+            if (_root == _end)
+            {
+                TINYJSON_THROW(std::runtime_error("unexpected end of input"));
+            }
+            uint32_t next = 0;
+            if (skip_whitespace(skip_value(_root, next), _end) != _end)
+            {
+                TINYJSON_THROW(std::runtime_error("unexpected character"));
+            }
+        }
+
+        // 跳过从开头的双引号开始的字符串，返回结尾双引号之后的位置
+        const char *skip_string(const char *p) const
+        {
+            for (++p;; ++p)
+            {
+                p = find_string_special(p, _end);
+                if (p == _end)
+                {
+                    break;
+                }
+                if (*p == '"')
+                {
+                    return p + 1;
+                }
+                if (*p == '\\' && ++p == _end)
+                {
+                    break;
+                }
+            }
+            TINYJSON_THROW(std::runtime_error("expected char '\"' not found"));
+        }
+
+        // 跳过从 p（值的第一个字节）开始的一个值，返回值之后的位置
+        // next 为尚未经过的第一个括号在索引中的下标，跳过容器时一并前进
+        const char *skip_value(const char *p, uint32_t &next) const
+        {
+            if (*p == '"')
+            {
+                return skip_string(p);
+            }
+            if (*p == '{' || *p == '[')
+            {
+                // 格式错误的输入可能使 p 与索引失去同步，此时不能按配对信息跳过
+                if (next >= _brackets.size() || _begin + _brackets[next].offset != p)
+                {
+                    fail(p, parse_errc::unexpected_character);
+                }
+                uint32_t close = _brackets[next].match;
+                next = close + 1;
+                return _begin + _brackets[close].offset + 1;
+            }
+
+            // 数值和字面量一直延续到分隔符，内容在访问时再校验
+            // 遇到双引号或左括号同样停下，它们不可能属于数值或字面量，由调用方报告格式错误
+            const char *start = p;
+            while (p < _end && !is_space_byte(*p) && *p != ',' && *p != ':' && *p != '}' && *p != ']' &&
+                   *p != '"' && *p != '{' && *p != '[')
+            {
+                ++p;
+            }
+            if (p == start)
+            {
+                TINYJSON_THROW(std::runtime_error("unexpected character"));
+            }
+            return p;
+        }
+
+        // 报告位于 p 处的语法错误
+        TINYJSON_COLD void fail(const char *p, parse_errc code) const
+        {
+            TINYJSON_THROW(parse_exception(parse_error::at(code, _begin, p)));
+        }
+
+        const char *_begin;              ///< 输入的开头
+        const char *_end;                ///< 输入结束位置（不包含）
+        const char *_root;               ///< 根节点的第一个字节
+        std::vector<bracket> _brackets; ///< 按出现顺序排列的全部括号
+    };
+
+    // 按需解析的文档中的一个值，只记录位置，访问时才解码
+    // 访问接口与 basic_json 的只读接口一致，类型不符或成员不存在时同样抛出异常
+    class lazy_value
+    {
+    public:
+        /// 值的类型，只有数值需要解码才能区分整数和浮点数
+        json_t type() const
+        {
+            switch (*_p)
+            {
+            case '"':
+                return json_t::string;
+            case '{':
+                return json_t::object;
+            case '[':
+                return json_t::array;
+            case 't':
+            case 'T':
+            case 'f':
+            case 'F':
+                return json_t::boolean;
+            case 'n':
+            case 'N':
+                return json_t::null;
+            default:
+                return scalar(json_t::number_integer).type();
+            }
+        }
+
+        /// 解码标量值
+        std::string get_string() const { return scalar(json_t::string).get_string(); }
+        long long get_integer() const { return scalar(json_t::number_integer).get_integer(); }
+        double get_double() const { return scalar(json_t::number_double).get_double(); }
+        bool get_bool() const { return scalar(json_t::boolean).get_bool(); }
+
+        /// 数组或对象的成员数量，需要遍历一遍（子树按括号配对跳过）
+        size_t size() const
+        {
+            size_t n = 0;
+            for_each_child(type(), [&n](string_view, const lazy_value &) {
+                ++n;
+                return true;
+            });
+            return n;
+        }
+
+        /// 检查对象中是否存在指定的成员
+        bool has_member(string_view member_name) const
+        {
+            lazy_value member;
+            return find_member(member_name, member);
+        }
+
+        /// 访问对象的成员，不存在时抛出异常
+        lazy_value operator[](const char *key) const
+        {
+            lazy_value member;
+            if (!find_member(key, member))
+            {
+                TINYJSON_THROW(std::runtime_error("key " + std::string(key) + " not found."));
+            }
+            return member;
+        }
+
+        /// 访问数组的元素，越界时抛出异常
+        lazy_value operator[](int index) const
+        {
+            CHECK_TYPE_MISMATCH(type(), json_t::array);
+            lazy_value elem;
+            int i = 0;
+            for_each_child(json_t::array, [&](string_view, const lazy_value &v) {
+                if (i++ != index)
+                {
+                    return true;
+                }
+                elem = v;
+                return false;
+            });
+            if (elem._doc == nullptr)
+            {
+                TINYJSON_THROW(std::runtime_error("index " + std::to_string(index) + " out of range."));
+            }
+            return elem;
+        }
+
+        /// 值在输入中的原始文本
+        string_view raw() const
+        {
+            uint32_t next = _next;
+            const char *end = _doc->skip_value(_p, next);
+            if (end < _p)
+            {
+                _doc->fail(_p, parse_errc::unexpected_character);
+            }
+            return string_view(_p, static_cast<size_t>(end - _p));
+        }
+
+        /// 完整解析这个值
+        template <class BasicJson = json>
+        BasicJson parse(const typename BasicJson::allocator_type &alloc = typename BasicJson::allocator_type()) const
+        {
+            string_view text = raw();
+            return basic_parser<BasicJson>::parse(text.data(), text.size(), alloc);
+        }
+
+    private:
+        friend class lazy_document;
+        friend struct path_access;
+
+        lazy_value() : _doc(nullptr), _p(nullptr), _next(0) {}
+        lazy_value(const lazy_document *doc, const char *p, uint32_t next) : _doc(doc), _p(p), _next(next) {}
+
+        // 解码标量值；容器不解码，直接报告类型不符
+        json scalar(json_t expected) const
+        {
+            if (*_p == '{' || *_p == '[')
+            {
+                CHECK_TYPE_MISMATCH(type(), expected);
+            }
+            string_view text = raw();
+            byte_cursor cursor(text.data(), text.size());
+            dom_handler<json> handler;
+            std::string scratch;
+            parser::sax_value(cursor, handler, scratch);
+            if (cursor.cur != cursor.end)
+            {
+                TINYJSON_THROW(std::runtime_error("unexpected character"));
+            }
+            return std::move(handler.result());
+        }
+
+        // 在对象中查找成员，找不到时返回 false；键名重复时与 json 一致，取最后一个
+        bool find_member(string_view key, lazy_value &member) const
+        {
+            CHECK_TYPE_MISMATCH(type(), json_t::object);
+            for_each_child(json_t::object, [&](string_view name, const lazy_value &v) {
+                if (name == key)
+                {
+                    member = v;
+                }
+                return true;
+            });
+            return member._doc != nullptr;
+        }
+
+        // 依次把容器的成员（对象）或元素（数组的键名为空）交给 visit，visit 返回 false 时停止
+        // 容器的右括号一定在输入范围内，因此遍历过程中不会越过输入的结尾
+        template <class Visit>
+        void for_each_child(json_t t, Visit visit) const
+        {
+            if (t != json_t::object && t != json_t::array)
+            {
+                TINYJSON_THROW(std::runtime_error("expect type array or object, but found type " + std::to_string(t)));
+            }
+            const char close = t == json_t::object ? '}' : ']';
+            const char *end = _doc->_end;
+            uint32_t next = _next + 1;
+            const char *p = skip_whitespace(_p + 1, end);
+            if (*p == close)
+            {
+                return;
+            }
+
+            std::string scratch;
+            while (true)
+            {
+                string_view name;
+                if (t == json_t::object)
+                {
+                    if (*p != '"')
+                    {
+                        TINYJSON_THROW(std::runtime_error("invalid object format"));
+                    }
+                    byte_cursor cursor(p, static_cast<size_t>(end - p));
+                    name = parser::scan_string(cursor, scratch);
+                    p = skip_whitespace(cursor.cur, end);
+                    if (*p != ':')
+                    {
+                        TINYJSON_THROW(std::runtime_error("invalid object format"));
+                    }
+                    p = skip_whitespace(p + 1, end);
+                }
+
+                if (!visit(name, lazy_value(_doc, p, next)))
+                {
+                    return;
+                }
+
+                p = skip_whitespace(_doc->skip_value(p, next), end);
+                if (*p == ',')
+                {
+                    p = skip_whitespace(p + 1, end);
+                }
+                else if (*p == close)
+                {
+                    return;
+                }
+                else
+                {
+                    TINYJSON_THROW(std::runtime_error(t == json_t::object ? "invalid object format"
+                                                                          : "expected char ']' not found"));
+                }
+            }
+        }
+
+        const lazy_document *_doc; ///< 所属的文档
+        const char *_p;            ///< 值的第一个字节
+        uint32_t _next;            ///< 值之后第一个尚未经过的括号下标；值为容器时即它的左括号
+    };
+
+    inline lazy_value lazy_document::root() const { return lazy_value(this, _root, 0); }
+
+    class tape_value;
+    class tape_iterator;
+
+    // 平坦的只读文档（tape）：整篇文档按顺序编码为 64 位条目组成的数组，字符串集中存放在一个缓冲区中
+    // 遍历只是顺序扫描连续内存，跳过一个子树只需一次跳转；适合解析一次、多次读取的场景
+    // 每个条目的高 8 位为类型标记，低 56 位为负载：
+    //   'n' 't' 'f'  null、true、false，没有负载
+    //   'l' 'd'      整数、浮点数，值保存在下一个条目中
+    //   '"'          字符串或键名，负载为它在字符串缓冲区中的偏移，缓冲区中先存 32 位长度再存字节
+    //   '{' '['      容器开始，负载为对应的结束条目之后的下标
+    //   '}' ']'      容器结束，负载为成员或元素的数量
+    // 对象的每个成员依次是一个键名条目和一个值条目；文档通过 SAX 事件构建，根节点必须是对象或数组
+    class tape_document
+    {
+    public:
+        tape_document(const char *s, size_t length)
+        {
+            builder b(*this);
+            parser::sax_parse(s, length, b);
+        }
+        explicit tape_document(const char *s) : tape_document(s, std::char_traits<char>::length(s)) {}
+        explicit tape_document(const std::string &s) : tape_document(s.data(), s.size()) {}
+
+        /// 根节点
+        tape_value root() const;
+
+        /// 条目的数量
+        size_t tape_size() const { return _tape.size(); }
+
+        /// 字符串缓冲区的字节数
+        size_t string_bytes() const { return _strings.size(); }
+
+    private:
+        friend class tape_value;
+        friend class tape_iterator;
+
+        static const int payload_bits = 56;
+        static const uint64_t payload_mask = (1ULL << payload_bits) - 1;
+
+        // 根据 SAX 事件追加条目，容器结束时回填开始条目的跳转位置
+        class builder
+        {
+        public:
+            explicit builder(tape_document &doc) : _doc(doc) {}
+
+            bool null() { return scalar('n'); }
+            bool boolean(bool val) { return scalar(val ? 't' : 'f'); }
+
+            bool number_integer(long long val)
+            {
+                scalar('l');
+                _doc._tape.push_back(static_cast<uint64_t>(val));
+                return true;
+            }
+
+            bool number_double(double val)
+            {
+                scalar('d');
+                uint64_t bits;
+                std::memcpy(&bits, &val, sizeof(bits));
+                _doc._tape.push_back(bits);
+                return true;
+            }
+
+            bool string(string_view val)
+            {
+                count_value();
+                _doc._tape.push_back(make_entry('"', _doc.store(val)));
+                return true;
+            }
+
+            bool key(string_view name)
+            {
+                ++_open.back().second; // 对象的成员在键名处计数
+                _doc._tape.push_back(make_entry('"', _doc.store(name)));
+                return true;
+            }
+
+            bool start_object() { return start('{'); }
+            bool end_object() { return end('}'); }
+            bool start_array() { return start('['); }
+            bool end_array() { return end(']'); }
+
+        private:
+            // 数组中的每个值计为一个元素
+            void count_value()
+            {
+                if (!_open.empty() && tag(_doc._tape[_open.back().first]) == '[')
+                {
+                    ++_open.back().second;
+                }
+            }
+
+            bool scalar(char t)
+            {
+                count_value();
+                _doc._tape.push_back(make_entry(t, 0));
+                return true;
+            }
+
+            bool start(char t)
+            {
+                count_value();
+                _open.push_back(std::make_pair(_doc._tape.size(), size_t(0)));
+                _doc._tape.push_back(make_entry(t, 0));
+                return true;
+            }
+
+            bool end(char t)
+            {
+                std::pair<size_t, size_t> open = _open.back();
+                _open.pop_back();
+                _doc._tape.push_back(make_entry(t, open.second));
+                _doc._tape[open.first] = make_entry(tag(_doc._tape[open.first]), _doc._tape.size());
+                return true;
+            }
+
+            tape_document &_doc;
+            std::vector<std::pair<size_t, size_t>> _open; ///< 尚未结束的容器：开始条目的下标和成员数量
+        };
+
+        static uint64_t make_entry(char t, size_t payload)
+        {
+            return (static_cast<uint64_t>(static_cast<unsigned char>(t)) << payload_bits) | payload;
+        }
+        static char tag(uint64_t e) { return static_cast<char>(e >> payload_bits); }
+        static size_t payload(uint64_t e) { return static_cast<size_t>(e & payload_mask); }
+
+        // 把字符串追加到缓冲区，返回其偏移
+        size_t store(string_view s)
+        {
+            size_t offset = _strings.size();
+            uint32_t length = static_cast<uint32_t>(s.size());
+            _strings.append(reinterpret_cast<const char *>(&length), sizeof(length));
+            _strings.append(s.data(), s.size());
+            return offset;
+        }
+
+        // 偏移处保存的字符串
+        string_view load(size_t offset) const
+        {
+            uint32_t length;
+            std::memcpy(&length, _strings.data() + offset, sizeof(length));
+            return string_view(_strings.data() + offset + sizeof(length), length);
+        }
+
+        // 下标 i 处的值之后的下标
+        size_t skip(size_t i) const
+        {
+            switch (tag(_tape[i]))
+            {
+            case '{':
+            case '[':
+                return payload(_tape[i]);
+            case 'l':
+            case 'd':
+                return i + 2;
+            default:
+                return i + 1;
+            }
+        }
+
+        std::vector<uint64_t> _tape; ///< 按文档顺序排列的条目
+        std::string _strings;        ///< 全部字符串和键名
+    };
+
+    // tape 中的一个值，访问接口与 basic_json 的只读接口一致，类型不符或成员不存在时同样抛出异常
+    // 只记录条目的下标，可以随意拷贝；在所属的 tape_document 销毁后失效
+    class tape_value
+    {
+    public:
+        json_t type() const
+        {
+            switch (tape_document::tag(entry()))
+            {
+            case '"':
+                return json_t::string;
+            case 'l':
+                return json_t::number_integer;
+            case 'd':
+                return json_t::number_double;
+            case '{':
+                return json_t::object;
+            case '[':
+                return json_t::array;
+            case 't':
+            case 'f':
+                return json_t::boolean;
+            default:
+                return json_t::null;
+            }
+        }
+
+        /// 字符串直接指向文档的字符串缓冲区
+        std::string get_string() const
+        {
+            string_view s = get_string_view();
+            return std::string(s.data(), s.size());
+        }
+
+        string_view get_string_view() const
+        {
+            CHECK_TYPE_MISMATCH(type(), json_t::string);
+            return _doc->load(tape_document::payload(entry()));
+        }
+
+        long long get_integer() const
+        {
+            CHECK_TYPE_MISMATCH(type(), json_t::number_integer);
+            return static_cast<long long>(_doc->_tape[_i + 1]);
+        }
+
+        double get_double() const
+        {
+            CHECK_TYPE_MISMATCH(type(), json_t::number_double);
+            double val;
+            std::memcpy(&val, &_doc->_tape[_i + 1], sizeof(val));
+            return val;
+        }
+
+        bool get_bool() const
+        {
+            CHECK_TYPE_MISMATCH(type(), json_t::boolean);
+            return tape_document::tag(entry()) == 't';
+        }
+
+        /// 数组或对象的成员数量，保存在结束条目中
+        size_t size() const { return tape_document::payload(_doc->_tape[container_end()]); }
+
+        /// 检查对象中是否存在指定的成员
+        bool has_member(string_view member_name) const { return find_member(member_name) != 0; }
+
+        /// 访问对象的成员，不存在时抛出异常
+        tape_value operator[](const char *key) const
+        {
+            size_t i = find_member(key);
+            if (i == 0)
+            {
+                TINYJSON_THROW(std::runtime_error("key " + std::string(key) + " not found."));
+            }
+            return tape_value(_doc, i);
+        }
+
+        /// 访问数组的元素，越界时抛出异常；途经的子树直接跳过
+        tape_value operator[](int index) const
+        {
+            CHECK_TYPE_MISMATCH(type(), json_t::array);
+            if (index < 0 || static_cast<size_t>(index) >= size())
+            {
+                TINYJSON_THROW(std::runtime_error("index " + std::to_string(index) + " out of range."));
+            }
+            size_t i = _i + 1;
+            for (int n = 0; n < index; n++)
+            {
+                i = _doc->skip(i);
+            }
+            return tape_value(_doc, i);
+        }
+
+        /// 按文档顺序遍历数组的元素或对象的成员
+        tape_iterator begin() const;
+        tape_iterator end() const;
+
+    private:
+        friend class tape_document;
+        friend class tape_iterator;
+        friend struct path_access;
+
+        tape_value(const tape_document *doc, size_t i) : _doc(doc), _i(i) {}
+
+        uint64_t entry() const { return _doc->_tape[_i]; }
+
+        // 容器结束条目的下标，当前值不是容器时抛出异常
+        size_t container_end() const
+        {
+            json_t t = type();
+            if (t != json_t::object && t != json_t::array)
+            {
+                TINYJSON_THROW(std::runtime_error("expect type array or object, but found type " + std::to_string(t)));
+            }
+            return tape_document::payload(entry()) - 1;
+        }
+
+        // 在对象中查找成员，返回其值的下标，找不到时返回 0（根节点之外的值下标总大于 0）
+        // 键名重复时与 json 一致，取最后一个
+        size_t find_member(string_view key) const
+        {
+            CHECK_TYPE_MISMATCH(type(), json_t::object);
+            size_t end = container_end();
+            size_t found = 0;
+            for (size_t i = _i + 1; i < end; i = _doc->skip(i + 1))
+            {
+                if (_doc->load(tape_document::payload(_doc->_tape[i])) == key)
+                {
+                    found = i + 1;
+                }
+            }
+            return found;
+        }
+
+        const tape_document *_doc; ///< 所属的文档
+        size_t _i;                 ///< 值的条目下标
+    };
+
+    // 遍历 tape 中数组的元素或对象的成员
+    class tape_iterator
+    {
+    public:
+        /// 当前元素，或当前成员的值
+        tape_value operator*() const { return tape_value(_doc, _object ? _i + 1 : _i); }
+
+        /// 当前成员的键名，只用于对象
+        string_view key() const
+        {
+            if (!_object)
+            {
+                TINYJSON_THROW(std::runtime_error("expect type object, but found type array"));
+            }
+            return _doc->load(tape_document::payload(_doc->_tape[_i]));
+        }
+
+        tape_iterator &operator++()
+        {
+            _i = _doc->skip(_object ? _i + 1 : _i);
+            return *this;
+        }
+
+        bool operator==(const tape_iterator &other) const { return _i == other._i && _doc == other._doc; }
+        bool operator!=(const tape_iterator &other) const { return !(*this == other); }
+
+    private:
+        friend class tape_value;
+
+        tape_iterator(const tape_document *doc, size_t i, bool object) : _doc(doc), _i(i), _object(object) {}
+
+        const tape_document *_doc; ///< 所属的文档
+        size_t _i;                 ///< 当前元素或当前成员键名的条目下标
+        bool _object;              ///< 是否在遍历对象
+    };
+
+    inline tape_value tape_document::root() const { return tape_value(this, 0); }
+
+    inline tape_iterator tape_value::begin() const
+    {
+        container_end();
+        return tape_iterator(_doc, _i + 1, type() == json_t::object);
+    }
+
+    inline tape_iterator tape_value::end() const { return tape_iterator(_doc, container_end(), type() == json_t::object); }
+
+    //
+    // 路径查询：JSON Pointer（RFC 6901）和 JSONPath 的一个子集
+    // 路径在构造时编译为一组查找步骤，之后可以对 json、tape_value、lazy_value 反复求值；
+    // 求值不抛出异常，找不到时返回空结果。extract 在 SAX 解析过程中求值，只构建匹配到的值
+    //
+
+    // 路径中的一步
+    struct path_step
+    {
+        std::string name; ///< 对象成员的键名，by_name 为 true 时有效
+        size_t index;     ///< 数组下标，不能作为下标时为 std::string::npos
+        bool by_name;     ///< 是否匹配键名为 name 的成员
+        bool wildcard;    ///< 是否匹配容器的全部子节点
+
+        bool match_key(string_view key) const { return wildcard || (by_name && key == string_view(name)); }
+        bool match_index(size_t i) const { return wildcard || index == i; }
+    };
+
+    // 在各种文档的节点上执行路径步骤；basic_json 的节点以指针表示，tape_value 和 lazy_value 以值表示
+    struct path_access
+    {
+        template <class A, template <class, class, class, class> class M>
+        static bool child(const basic_json<A, M> *node, const path_step &step, const basic_json<A, M> *&out)
+        {
+            const basic_json<A, M> *found = nullptr;
+            if (node->type() == json_t::object && step.by_name)
+            {
+                found = node->find(string_view(step.name));
+            }
+            else if (node->type() == json_t::array && step.index != std::string::npos)
+            {
+                found = node->find(step.index);
+            }
+            if (found == nullptr)
+            {
+                return false;
+            }
+            out = found;
+            return true;
+        }
+
+        template <class A, template <class, class, class, class> class M, class F>
+        static void children(const basic_json<A, M> *node, F f)
+        {
+            if (node->type() == json_t::object)
+            {
+                for (const auto &member : node->get_object())
+                    f(&member.second);
+            }
+            else if (node->type() == json_t::array)
+            {
+                for (const auto &elem : node->get_array())
+                    f(&elem);
+            }
+        }
+
+        static bool child(const tape_value &node, const path_step &step, tape_value &out)
+        {
+            if (node.type() == json_t::object && step.by_name)
+            {
+                size_t i = node.find_member(step.name);
+                if (i == 0)
+                {
+                    return false;
+                }
+                out = tape_value(node._doc, i);
+                return true;
+            }
+            if (node.type() == json_t::array && step.index < node.size())
+            {
+                out = node[static_cast<int>(step.index)]; // 下标已确认在范围内
+                return true;
+            }
+            return false;
+        }
+
+        template <class F>
+        static void children(const tape_value &node, F f)
+        {
+            json_t t = node.type();
+            if (t == json_t::object || t == json_t::array)
+            {
+                for (tape_iterator it = node.begin(); it != node.end(); ++it)
+                    f(*it);
+            }
+        }
+
+        static bool child(const lazy_value &node, const path_step &step, lazy_value &out)
+        {
+            json_t t = node.type();
+            if (t == json_t::object && step.by_name)
+            {
+                lazy_value member;
+                if (!node.find_member(step.name, member))
+                {
+                    return false;
+                }
+                out = member;
+                return true;
+            }
+            if (t == json_t::array && step.index != std::string::npos)
+            {
+                size_t i = 0;
+                bool found = false;
+                node.for_each_child(t, [&](string_view, const lazy_value &v) {
+                    if (i++ != step.index)
+                    {
+                        return true;
+                    }
+                    out = v;
+                    found = true;
+                    return false;
+                });
+                return found;
+            }
+            return false;
+        }
+
+        template <class F>
+        static void children(const lazy_value &node, F f)
+        {
+            node.for_each_child(node.type(), [&](string_view, const lazy_value &v) {
+                f(v);
+                return true;
+            });
+        }
+
+        // 依次执行不含通配的步骤，任何一步找不到时返回 false
+        template <class Node>
+        static bool resolve(const std::vector<path_step> &steps, const Node &root, Node &out)
+        {
+            Node cur(root);
+            for (const path_step &step : steps)
+            {
+                Node next(cur);
+                if (!child(cur, step, next))
+                {
+                    return false;
+                }
+                cur = next;
+            }
+            out = cur;
+            return true;
+        }
+
+        // 从第 depth 步开始求值，把每个匹配的节点交给 f
+        template <class Node, class F>
+        static void walk(const std::vector<path_step> &steps, size_t depth, const Node &node, F &f)
+        {
+            if (depth == steps.size())
+            {
+                f(node);
+                return;
+            }
+            const path_step &step = steps[depth];
+            if (step.wildcard)
+            {
+                children(node, [&](const Node &c) { walk(steps, depth + 1, c, f); });
+                return;
+            }
+            Node next(node);
+            if (child(node, step, next))
+            {
+                walk(steps, depth + 1, next, f);
+            }
+        }
+    };
+
+    // 在 SAX 解析过程中求值路径：不匹配的值只经过解析而不构建，匹配的值构建为 BasicJson 后交给 on_match
+    // on_match 返回 false 时停止解析
+    template <class BasicJson, class OnMatch>
+    class path_filter_handler
+    {
+    public:
+        using allocator_type = typename BasicJson::allocator_type;
+
+        path_filter_handler(const std::vector<path_step> &steps, OnMatch &on_match, const allocator_type &alloc)
+            : _steps(steps), _on_match(on_match), _dom(alloc), _capture(0) {}
+
+        bool null()
+        {
+            return scalar([](dom_handler<BasicJson> &h) { return h.null(); });
+        }
+
+        bool boolean(bool val)
+        {
+            return scalar([=](dom_handler<BasicJson> &h) { return h.boolean(val); });
+        }
+
+        bool number_integer(long long val)
+        {
+            return scalar([=](dom_handler<BasicJson> &h) { return h.number_integer(val); });
+        }
+
+        bool number_double(double val)
+        {
+            return scalar([=](dom_handler<BasicJson> &h) { return h.number_double(val); });
+        }
+
+        bool string(string_view val)
+        {
+            return scalar([=](dom_handler<BasicJson> &h) { return h.string(val); });
+        }
+
+        bool start_object()
+        {
+            return open(false, [](dom_handler<BasicJson> &h) { return h.start_object(); });
+        }
+
+        bool key(string_view name)
+        {
+            if (_capture != 0)
+            {
+                return _dom.key(name);
+            }
+            frame &f = _stack.back();
+            f.child_match = f.live && _steps[_stack.size() - 1].match_key(name);
+            return true;
+        }
+
+        bool end_object()
+        {
+            return close([](dom_handler<BasicJson> &h) { return h.end_object(); });
+        }
+
+        bool start_array()
+        {
+            return open(true, [](dom_handler<BasicJson> &h) { return h.start_array(); });
+        }
+
+        bool end_array()
+        {
+            return close([](dom_handler<BasicJson> &h) { return h.end_array(); });
+        }
+
+    private:
+        /// 一个未被构建的容器
+        struct frame
+        {
+            bool array;       ///< 是否为数组
+            bool live;        ///< 容器自身的路径是否与路径的前缀匹配
+            bool child_match; ///< 当前子节点是否匹配下一步
+            size_t next;      ///< 数组中下一个元素的下标
+        };
+
+        // 一个值开始：返回它的路径是否与路径的前缀匹配
+        // 只有匹配的容器才会查看对应的步骤，这样的容器深度总小于步骤数
+        bool enter()
+        {
+            if (_stack.empty())
+            {
+                return true;
+            }
+            frame &f = _stack.back();
+            if (f.array)
+            {
+                f.child_match = f.live && _steps[_stack.size() - 1].match_index(f.next++);
+            }
+            return f.child_match;
+        }
+
+        template <class Event>
+        bool scalar(Event event)
+        {
+            if (_capture != 0)
+            {
+                return event(_dom);
+            }
+            if (!enter() || _stack.size() != _steps.size())
+            {
+                return true;
+            }
+            event(_dom);
+            return finish();
+        }
+
+        template <class Event>
+        bool open(bool array, Event event)
+        {
+            if (_capture != 0)
+            {
+                _capture++;
+                return event(_dom);
+            }
+            bool live = enter();
+            if (live && _stack.size() == _steps.size())
+            {
+                _capture = 1; // 从这里开始构建
+                return event(_dom);
+            }
+            _stack.push_back(frame{array, live, false, 0});
+            return true;
+        }
+
+        template <class Event>
+        bool close(Event event)
+        {
+            if (_capture != 0)
+            {
+                event(_dom);
+                return --_capture != 0 || finish();
+            }
+            _stack.pop_back();
+            return true;
+        }
+
+        // 交出构建完成的值
+        bool finish()
+        {
+            bool proceed = _on_match(_dom.result());
+            _dom.clear();
+            return proceed;
+        }
+
+        const std::vector<path_step> &_steps; ///< 路径
+        OnMatch &_on_match;                   ///< 匹配时的回调
+        dom_handler<BasicJson> _dom;          ///< 构建匹配的值
+        size_t _capture;                      ///< 正在构建的值内部的嵌套深度，0 表示没有在构建
+        std::vector<frame> _stack;            ///< 从根到当前位置未被构建的容器
+    };
+
+    // JSON Pointer（RFC 6901），例如 "/a/b/0"；空字符串表示根节点
+    // 每个引用标记既可以匹配对象的键名，也可以在是合法下标时匹配数组的元素
+    class json_pointer
+    {
+    public:
+        explicit json_pointer(string_view text) : _text(text.data(), text.size())
+        {
+            if (text.size() != 0 && text[0] != '/')
+            {
+                TINYJSON_THROW(std::runtime_error("invalid json pointer: " + _text));
+            }
+            for (size_t i = 0; i < text.size();)
+            {
+                path_step step{std::string(), std::string::npos, true, false};
+                for (i++; i < text.size() && text[i] != '/'; i++)
+                {
+                    if (text[i] != '~')
+                    {
+                        step.name.push_back(text[i]);
+                    }
+                    else if (i + 1 < text.size() && (text[i + 1] == '0' || text[i + 1] == '1'))
+                    {
+                        step.name.push_back(text[++i] == '0' ? '~' : '/');
+                    }
+                    else
+                    {
+                        TINYJSON_THROW(std::runtime_error("invalid json pointer: " + _text));
+                    }
+                }
+                step.index = parse_index(step.name);
+                _steps.push_back(std::move(step));
+            }
+        }
+
+        explicit json_pointer(const char *text) : json_pointer(string_view(text)) {}
+        explicit json_pointer(const std::string &text) : json_pointer(string_view(text)) {}
+
+        /// 查找指向的值，找不到时返回 nullptr
+        template <class A, template <class, class, class, class> class M>
+        const basic_json<A, M> *find(const basic_json<A, M> &root) const
+        {
+            const basic_json<A, M> *found = nullptr;
+            return path_access::resolve(_steps, &root, found) ? found : nullptr;
+        }
+
+        template <class A, template <class, class, class, class> class M>
+        basic_json<A, M> *find(basic_json<A, M> &root) const
+        {
+            return const_cast<basic_json<A, M> *>(find(static_cast<const basic_json<A, M> &>(root)));
+        }
+
+        /// 在 tape 或按需解析的文档中查找，找到时写入 out 并返回 true
+        bool find(const tape_value &root, tape_value &out) const { return path_access::resolve(_steps, root, out); }
+        bool find(const lazy_value &root, lazy_value &out) const { return path_access::resolve(_steps, root, out); }
+
+        /// 边解析边查找，只构建指向的值；找到后立即停止解析，其后的内容不再校验
+        template <class BasicJson>
+        bool extract(const char *s, size_t length, BasicJson &out,
+                     const typename BasicJson::allocator_type &alloc = typename BasicJson::allocator_type()) const
+        {
+            bool found = false;
+            auto on_match = [&](BasicJson &val) {
+                out = std::move(val);
+                found = true;
+                return false;
+            };
+            path_filter_handler<BasicJson, decltype(on_match)> handler(_steps, on_match, alloc);
+            basic_parser<BasicJson>::sax_parse(s, length, handler);
+            return found;
+        }
+
+        template <class BasicJson>
+        bool extract(const std::string &s, BasicJson &out) const { return extract(s.data(), s.size(), out); }
+
+        /// 引用标记的个数
+        size_t size() const { return _steps.size(); }
+
+        /// 构造时的文本
+        const std::string &to_string() const { return _text; }
+
+    private:
+        template <class>
+        friend class basic_shared_json;
+
+        // "0" 或不以 0 开头的十进制数是合法的下标
+        static size_t parse_index(const std::string &token)
+        {
+            if (token.empty() || token.size() > 18 || (token[0] == '0' && token.size() > 1))
+            {
+                return std::string::npos;
+            }
+            size_t index = 0;
+            for (char c : token)
+            {
+                if (c < '0' || c > '9')
+                {
+                    return std::string::npos;
+                }
+                index = index * 10 + static_cast<size_t>(c - '0');
+            }
+            return index;
+        }
+
+        std::string _text;             ///< 构造时的文本
+        std::vector<path_step> _steps; ///< 编译后的步骤
+    };
+
+    // JSONPath 的子集：以 $ 开头，之后是任意个 .name、['name']、[n]、.* 或 [*]
+    // 例如 "$.store.book[*].title"；不支持递归下降（..）、负下标、切片和过滤表达式
+    class json_path
+    {
+    public:
+        explicit json_path(string_view text) : _text(text.data(), text.size())
+        {
+            if (text.size() == 0 || text[0] != '$')
+            {
+                fail();
+            }
+            size_t i = 1;
+            while (i < text.size())
+            {
+                path_step step{std::string(), std::string::npos, false, false};
+                if (text[i] == '.')
+                {
+                    if (++i < text.size() && text[i] == '*')
+                    {
+                        step.wildcard = true;
+                        i++;
+                    }
+                    else
+                    {
+                        for (; i < text.size() && text[i] != '.' && text[i] != '['; i++)
+                        {
+                            step.name.push_back(text[i]);
+                        }
+                        if (step.name.empty())
+                        {
+                            fail();
+                        }
+                        step.by_name = true;
+                    }
+                }
+                else if (text[i] == '[' && i + 1 < text.size())
+                {
+                    char c = text[++i];
+                    if (c == '*')
+                    {
+                        step.wildcard = true;
+                        i++;
+                    }
+                    else if (c == '\'' || c == '"')
+                    {
+                        for (i++; i < text.size() && text[i] != c; i++)
+                        {
+                            if (text[i] == '\\' && i + 1 < text.size())
+                            {
+                                i++; // 反斜杠转义下一个字符
+                            }
+                            step.name.push_back(text[i]);
+                        }
+                        if (i++ >= text.size())
+                        {
+                            fail();
+                        }
+                        step.by_name = true;
+                    }
+                    else if (c >= '0' && c <= '9')
+                    {
+                        size_t index = 0;
+                        for (; i < text.size() && text[i] >= '0' && text[i] <= '9'; i++)
+                        {
+                            if (index > (std::numeric_limits<size_t>::max() - 9) / 10)
+                            {
+                                fail();
+                            }
+                            index = index * 10 + static_cast<size_t>(text[i] - '0');
+                        }
+                        step.index = index;
+                    }
+                    else
+                    {
+                        fail();
+                    }
+                    if (i >= text.size() || text[i++] != ']')
+                    {
+                        fail();
+                    }
+                }
+                else
+                {
+                    fail();
+                }
+                _steps.push_back(std::move(step));
+            }
+        }
+
+        explicit json_path(const char *text) : json_path(string_view(text)) {}
+        explicit json_path(const std::string &text) : json_path(string_view(text)) {}
+
+        /// 按文档顺序把每个匹配的值交给 f
+        template <class A, template <class, class, class, class> class M, class F>
+        void for_each(const basic_json<A, M> &root, F f) const
+        {
+            auto visit = [&](const basic_json<A, M> *node) { f(*node); };
+            path_access::walk(_steps, 0, &root, visit);
+        }
+
+        template <class F>
+        void for_each(const tape_value &root, F f) const { path_access::walk(_steps, 0, root, f); }
+
+        template <class F>
+        void for_each(const lazy_value &root, F f) const { path_access::walk(_steps, 0, root, f); }
+
+        /// 全部匹配的值，按文档顺序排列
+        template <class A, template <class, class, class, class> class M>
+        std::vector<const basic_json<A, M> *> select(const basic_json<A, M> &root) const
+        {
+            std::vector<const basic_json<A, M> *> found;
+            for_each(root, [&](const basic_json<A, M> &node) { found.push_back(&node); });
+            return found;
+        }
+
+        /// 边解析边求值，只构建匹配的值并依次交给 f，返回匹配的个数
+        template <class BasicJson = json, class F>
+        size_t extract(const char *s, size_t length, F f,
+                       const typename BasicJson::allocator_type &alloc = typename BasicJson::allocator_type()) const
+        {
+            size_t count = 0;
+            auto on_match = [&](BasicJson &val) {
+                count++;
+                f(val);
+                return true;
+            };
+            path_filter_handler<BasicJson, decltype(on_match)> handler(_steps, on_match, alloc);
+            basic_parser<BasicJson>::sax_parse(s, length, handler);
+            return count;
+        }
+
+        template <class BasicJson = json, class F>
+        size_t extract(const std::string &s, F f) const { return extract<BasicJson>(s.data(), s.size(), f); }
+
+        /// 步骤的个数
+        size_t size() const { return _steps.size(); }
+
+        /// 构造时的文本
+        const std::string &to_string() const { return _text; }
+
+    private:
+        [[noreturn]] void fail() const { TINYJSON_THROW(std::runtime_error("invalid json path: " + _text)); }
+
+        std::string _text;             ///< 构造时的文本
+        std::vector<path_step> _steps; ///< 编译后的步骤
+    };
+
+    //
+    // 共享不可变节点的文档：节点创建后不再修改，通过带原子引用计数的 std::shared_ptr 共享
+    // 拷贝只增加引用计数（O(1)），多个线程可以不加锁地同时读取同一份文档（各自持有拷贝即可）；
+    // 修改时只复制从根到被修改节点的路径，其余子树仍与原文档共享，原文档和其他拷贝不受影响。
+    // 节点只被当前值引用时直接就地修改，不再复制
+    // 与 std::shared_ptr 相同，同一个 basic_shared_json 对象不能在修改的同时被其他线程访问
+    //     shared_json cached(parser::parse(text)); // 构建一次
+    //     shared_json copy = cached;                // 每个请求一份拷贝，O(1)
+    //     copy.set(json_pointer("/user/name"), shared_json(json("x"))); // 只复制 /、/user 两个节点
+    //
+
+    template <class BasicJson>
+    class basic_shared_json
+    {
+    public:
+        using json_type = BasicJson;
+        using member = std::pair<std::string, basic_shared_json>;
+
+        /// null 值，不分配节点
+        basic_shared_json() = default;
+
+        /// 从 json 构建，深拷贝一次；借用的字符串也会被复制
+        explicit basic_shared_json(const json_type &j) : _node(build(j)) {}
+
+        json_t type() const { return _node ? _node->type : json_t::null; }
+
+        /// 数组的元素个数或对象的成员个数
+        size_t size() const;
+
+        bool get_bool() const;
+        long long get_integer() const;
+        double get_double() const;
+        string_view get_string_view() const;
+
+        /// 数组的元素
+        const std::vector<basic_shared_json> &get_array() const;
+        /// 对象的成员，保持构建时的顺序
+        const std::vector<member> &get_object() const;
+
+        /// 查找对象的成员（二分查找）或数组的元素；不是相应的容器或者找不到时返回 nullptr
+        /// 返回的指针在当前值被修改或销毁之前有效
+        const basic_shared_json *find(string_view key) const;
+        const basic_shared_json *find(size_t index) const;
+        /// 按 JSON Pointer 查找
+        const basic_shared_json *find(const json_pointer &ptr) const;
+
+        /// 找不到时抛出异常
+        const basic_shared_json &operator[](string_view key) const;
+        const basic_shared_json &operator[](size_t index) const;
+
+        /// 设置对象的成员，键名不存在时添加到末尾
+        void set(string_view key, basic_shared_json value);
+        /// 替换数组的元素
+        void set(size_t index, basic_shared_json value);
+        /// 替换 JSON Pointer 指向的值；路径上的节点必须存在，最后一步可以是对象中新的键名，或 "-" 表示追加到数组末尾
+        void set(const json_pointer &ptr, basic_shared_json value);
+        /// 在数组末尾追加元素
+        void push_back(basic_shared_json value);
+        /// 删除对象的成员，返回是否存在
+        bool erase(string_view key);
+
+        /// 是否与 other 共享同一个节点（拷贝之后、修改之前）
+        bool same_node(const basic_shared_json &other) const { return _node == other._node; }
+
+        bool operator==(const basic_shared_json &rhs) const;
+        bool operator!=(const basic_shared_json &rhs) const { return !(*this == rhs); }
+
+        /// 转换为普通的 json（深拷贝）
+        json_type to_json() const;
+
+        /// 序列化，格式与 basic_json::dump 相同
+        template <class Sink>
+        void dump(Sink &sink) const;
+        std::string to_string() const;
+
+    private:
+        struct node;
+
+        static std::shared_ptr<const node> build(const json_type &j);
+
+        // 返回可以修改的节点：节点被共享时先复制一份（子节点仍然共享）
+        node &detach();
+
+        // 在对象节点中查找键名，返回在 members 中的下标；找不到时返回 npos，并把应插入到 index 中的位置写入 pos
+        static size_t lookup(const node &n, string_view key, size_t &pos);
+
+        // 从第 depth 步开始替换路径指向的值
+        void set_path(const std::vector<path_step> &steps, size_t depth, basic_shared_json value);
+
+        std::shared_ptr<const node> _node; ///< 为空时表示 null
+    };
+
+    // 不可变的节点，只在创建它的值独占时才会被修改
+    template <class BasicJson>
+    struct basic_shared_json<BasicJson>::node
+    {
+        json_t type;
+        json_type scalar;                      ///< 布尔值、数值和字符串
+        std::vector<basic_shared_json> elems;  ///< 数组的元素
+        std::vector<member> members;           ///< 对象的成员，保持原来的顺序
+        std::vector<uint32_t> index;           ///< members 按键名排序的下标，用于二分查找
+    };
+
+    using shared_json = basic_shared_json<json>;
+
+    template <class BasicJson>
+    inline std::shared_ptr<const typename basic_shared_json<BasicJson>::node> basic_shared_json<BasicJson>::build(const json_type &j)
+    {
+        if (j.type() == json_t::null)
+        {
+            return nullptr;
+        }
+
+        std::shared_ptr<node> n = std::make_shared<node>();
+        n->type = j.type();
+        switch (j.type())
+        {
+        case json_t::array:
+            n->elems.reserve(j.size());
+            for (const auto &elem : j.get_array())
+            {
+                basic_shared_json child;
+                child._node = build(elem);
+                n->elems.push_back(std::move(child));
+            }
+            break;
+
+        case json_t::object:
+            n->members.reserve(j.size());
+            for (const auto &m : j.get_object())
+            {
+                basic_shared_json child;
+                child._node = build(m.second);
+                n->members.emplace_back(std::string(m.first.data(), m.first.size()), std::move(child));
+            }
+            n->index.resize(n->members.size());
+            for (size_t i = 0; i < n->index.size(); i++)
+            {
+                n->index[i] = static_cast<uint32_t>(i);
+            }
+            std::sort(n->index.begin(), n->index.end(), [&](uint32_t a, uint32_t b) { return n->members[a].first < n->members[b].first; });
+            break;
+
+        case json_t::string:
+            n->scalar = json_type(j.get_string_view());
+            break;
+
+        default:
+            n->scalar = j;
+            break;
+        }
+        return n;
+    }
+
+    template <class BasicJson>
+    inline typename basic_shared_json<BasicJson>::node &basic_shared_json<BasicJson>::detach()
+    {
+        if (_node.use_count() != 1)
+        {
+            _node = std::make_shared<node>(*_node);
+        }
+#if !defined(TINYJSON_NO_THREADS)
+        else
         {
-        case json_t::number_integer:
-            return (long long)(*static_cast<long long *>(_value));
-        default:
-            throw std::runtime_error("cannot cast " + type_name() + " to json number");
+            // use_count() 是宽松的读取：另一个线程可能刚刚释放了最后一个引用，
+            // 需要获取屏障保证它释放之前对节点的读取都发生在下面的修改之前
+            std::atomic_thread_fence(std::memory_order_acquire);
         }
+#endif
+        // 只有当前值引用这个节点，其他线程不可能正在读取它；节点都是作为非 const 对象创建的
+        return const_cast<node &>(*_node);
     }
 
-    // 类型转换运算符，将 json 对象转换为 const bool 类型
-    inline json::operator const bool() const
+    template <class BasicJson>
+    inline size_t basic_shared_json<BasicJson>::lookup(const node &n, string_view key, size_t &pos)
     {
-        switch (_type)
+        auto it = std::lower_bound(n.index.begin(), n.index.end(), key, [&](uint32_t i, string_view k) {
+            const std::string &name = n.members[i].first;
+            return string_view(name.data(), name.size()).compare(k) < 0;
+        });
+        pos = static_cast<size_t>(it - n.index.begin());
+        if (it != n.index.end())
         {
-        case json_t::boolean:
-            return *static_cast<bool *>(_value);
-        default:
-            throw std::runtime_error("cannot cast " + type_name() + " to json boolean");
+            const std::string &name = n.members[*it].first;
+            if (string_view(name.data(), name.size()).compare(key) == 0)
+            {
+                return *it;
+            }
         }
+        return std::string::npos;
     }
-    // 将当前 JSON 对象转换为字符串表示
-    inline const std::string json::to_string() const
+
+    template <class BasicJson>
+    inline size_t basic_shared_json<BasicJson>::size() const
     {
-        switch (type())
+        if (type() == json_t::array)
         {
-        case json_t::object:
-            // 如果是对象类型，调用 object_to_string 进行序列化
-            return object_to_string();
+            return _node->elems.size();
+        }
+        if (type() == json_t::object)
+        {
+            return _node->members.size();
+        }
+        std::string name = _node ? _node->scalar.type_name() : std::string("null"); // 不是容器时 scalar 就是值本身
+        TINYJSON_THROW(std::runtime_error("Unexpected json type " + name + ", expected array or object"));
+    }
 
-        case json_t::array:
-            // 如果是数组类型，调用 array_to_string 进行序列化
-            return array_to_string();
+    template <class BasicJson>
+    inline bool basic_shared_json<BasicJson>::get_bool() const
+    {
+        CHECK_TYPE_MISMATCH(type(), json_t::boolean);
+        return _node->scalar.get_bool();
+    }
 
-        case json_t::string:
-            // 如果是字符串类型，获取字符串值并在两侧添加双引号
-            return "\"" + get_string() + "\"";
+    template <class BasicJson>
+    inline long long basic_shared_json<BasicJson>::get_integer() const
+    {
+        CHECK_TYPE_MISMATCH(type(), json_t::number_integer);
+        return _node->scalar.get_integer();
+    }
 
-        case json_t::number_integer:
-            // 如果是整数类型，将整数值转换为字符串
-            return std::to_string(get_integer());
+    template <class BasicJson>
+    inline double basic_shared_json<BasicJson>::get_double() const
+    {
+        CHECK_TYPE_MISMATCH(type(), json_t::number_double);
+        return _node->scalar.get_double();
+    }
 
-        case json_t::number_double:
-            // 如果是浮点数类型，将浮点数值转换为字符串
-            return std::to_string(get_double());
+    template <class BasicJson>
+    inline string_view basic_shared_json<BasicJson>::get_string_view() const
+    {
+        CHECK_TYPE_MISMATCH(type(), json_t::string);
+        return _node->scalar.get_string_view();
+    }
 
-        case json_t::boolean:
-            // 如果是布尔类型，根据布尔值返回 "true" 或 "false"
-            return get_bool() ? "true" : "false";
+    template <class BasicJson>
+    inline const std::vector<basic_shared_json<BasicJson>> &basic_shared_json<BasicJson>::get_array() const
+    {
+        CHECK_TYPE_MISMATCH(type(), json_t::array);
+        return _node->elems;
+    }
 
-        case json_t::null:
-            // 如果是 null 类型，返回 "null" 字符串
-            return "null";
+    template <class BasicJson>
+    inline const std::vector<typename basic_shared_json<BasicJson>::member> &basic_shared_json<BasicJson>::get_object() const
+    {
+        CHECK_TYPE_MISMATCH(type(), json_t::object);
+        return _node->members;
+    }
 
-        default:
-            // 如果遇到无效的 JSON 类型，抛出异常
-            throw std::runtime_error("invalid json type");
+    template <class BasicJson>
+    inline const basic_shared_json<BasicJson> *basic_shared_json<BasicJson>::find(string_view key) const
+    {
+        if (type() != json_t::object)
+        {
+            return nullptr;
         }
+        size_t pos;
+        size_t i = lookup(*_node, key, pos);
+        return i != std::string::npos ? &_node->members[i].second : nullptr;
     }
 
-    // 将当前 JSON 对象（对象类型）转换为字符串表示
-    // 存在递归调用
-    inline const std::string json::object_to_string() const
+    template <class BasicJson>
+    inline const basic_shared_json<BasicJson> *basic_shared_json<BasicJson>::find(size_t index) const
     {
-        std::stringstream ss;
-        ss << "{"; // 输出对象开始标志 {
+        return type() == json_t::array && index < _node->elems.size() ? &_node->elems[index] : nullptr;
+    }
 
-        json_object jobj = get_object(); // 获取对象数据
-        for (auto it = jobj.begin(); it != jobj.end(); it++)
+    template <class BasicJson>
+    inline const basic_shared_json<BasicJson> *basic_shared_json<BasicJson>::find(const json_pointer &ptr) const
+    {
+        const basic_shared_json *cur = this;
+        for (const path_step &step : ptr._steps)
         {
-            ss << "\"" << it->first.c_str() << "\""; // 输出键名，并加双引号
-            ss << " : ";                             // 输出键值对分隔符 :
-
-            ss << it->second.to_string().c_str(); // 输出值的字符串表示
-
-            if (std::next(it) != jobj.end())
+            cur = cur->type() == json_t::array ? cur->find(step.index) : cur->find(string_view(step.name));
+            if (cur == nullptr)
             {
-                ss << ","; // 如果不是最后一个成员，输出分隔符 ,
+                return nullptr;
             }
         }
+        return cur;
+    }
 
-        ss << "}";       // 输出对象结束标志 }
-        return ss.str(); // 返回序列化后的字符串
+    template <class BasicJson>
+    inline const basic_shared_json<BasicJson> &basic_shared_json<BasicJson>::operator[](string_view key) const
+    {
+        CHECK_TYPE_MISMATCH(type(), json_t::object);
+        const basic_shared_json *found = find(key);
+        if (found == nullptr)
+        {
+            TINYJSON_THROW(std::runtime_error("key " + std::string(key.data(), key.size()) + " not found."));
+        }
+        return *found;
     }
 
-    // 将当前 JSON 对象（数组类型）转换为字符串表示
-    inline const std::string json::array_to_string() const
+    template <class BasicJson>
+    inline const basic_shared_json<BasicJson> &basic_shared_json<BasicJson>::operator[](size_t index) const
     {
-        std::stringstream ss;
-        ss << "["; // 输出数组开始标志 [
+        CHECK_TYPE_MISMATCH(type(), json_t::array);
+        if (index >= _node->elems.size())
+        {
+            TINYJSON_THROW(std::runtime_error("index " + std::to_string(index) + " out of range."));
+        }
+        return _node->elems[index];
+    }
 
-        json_array jarray = get_array(); // 获取数组数据
-        for (auto it = jarray.begin(); it != jarray.end(); it++)
+    template <class BasicJson>
+    inline void basic_shared_json<BasicJson>::set(string_view key, basic_shared_json value)
+    {
+        CHECK_TYPE_MISMATCH(type(), json_t::object);
+        node &n = detach();
+        size_t pos;
+        size_t i = lookup(n, key, pos);
+        if (i != std::string::npos)
         {
-            ss << it->to_string().c_str(); // 输出当前元素的字符串表示
+            n.members[i].second = std::move(value);
+            return;
+        }
+        n.index.insert(n.index.begin() + static_cast<std::ptrdiff_t>(pos), static_cast<uint32_t>(n.members.size()));
+        n.members.emplace_back(std::string(key.data(), key.size()), std::move(value));
+    }
 
-            if (std::next(it) != jarray.end())
-            {
-                ss << ","; // 如果不是最后一个元素，输出分隔符 ,
-            }
+    template <class BasicJson>
+    inline void basic_shared_json<BasicJson>::set(size_t index, basic_shared_json value)
+    {
+        CHECK_TYPE_MISMATCH(type(), json_t::array);
+        if (index >= _node->elems.size())
+        {
+            TINYJSON_THROW(std::runtime_error("index " + std::to_string(index) + " out of range."));
         }
+        detach().elems[index] = std::move(value);
+    }
 
-        ss << "]";       // 输出数组结束标志 ]
-        return ss.str(); // 返回序列化后的字符串
+    template <class BasicJson>
+    inline void basic_shared_json<BasicJson>::set(const json_pointer &ptr, basic_shared_json value)
+    {
+        set_path(ptr._steps, 0, std::move(value));
     }
 
-    // JSON 解析器
-    class parser
+    template <class BasicJson>
+    inline void basic_shared_json<BasicJson>::set_path(const std::vector<path_step> &steps, size_t depth, basic_shared_json value)
     {
-    public:
-        // 从 UTF-8 编码的字符串解析 JSON 对象
-        static json parse(const char *s)
+        if (depth == steps.size())
         {
-            // 将输入字符串转换为 UTF-32，以便逐字符解析
-            std::stringstream sstrm(s);
-            std::wbuffer_convert<std::codecvt_utf8<char32_t>, char32_t> conv(sstrm.rdbuf());
-            u32_istream u32strm(&conv);
-
-            json ret_val;                                       // 用于存储解析后的 JSON 值
-            char32_t first_char = peek_next_non_space(u32strm); // 查看第一个非空白字符
+            *this = std::move(value);
+            return;
+        }
 
-            // 根据第一个非空白字符判断 JSON 的类型
-            if (first_char == U'{')
+        const path_step &step = steps[depth];
+        bool last = depth + 1 == steps.size();
+        if (type() == json_t::object)
+        {
+            size_t pos;
+            size_t i = lookup(*_node, string_view(step.name), pos);
+            if (i != std::string::npos)
             {
-                ret_val = parse_object(u32strm); // 解析对象
+                detach().members[i].second.set_path(steps, depth + 1, std::move(value));
+                return;
             }
-            else if (first_char == U'[')
+            if (last)
             {
-                ret_val = parse_array(u32strm); // 解析数组
+                set(string_view(step.name), std::move(value));
+                return;
             }
-            else
+        }
+        else if (type() == json_t::array)
+        {
+            if (step.index < _node->elems.size())
             {
-                throw std::runtime_error("invalid json format"); // 格式错误
+                detach().elems[step.index].set_path(steps, depth + 1, std::move(value));
+                return;
             }
-
-            // 预期解析结束后应到达文件末尾
-            if (peek_next_non_space(u32strm) != (char32_t)EOF)
+            if (last && step.name == "-")
             {
-                throw std::runtime_error("invalid json format"); // 格式错误
+                push_back(std::move(value));
+                return;
             }
-
-            return ret_val; // 返回解析后的 JSON 对象
         }
+        TINYJSON_THROW(std::runtime_error("json pointer target not found: /" + step.name));
+    }
 
-        // 解析 JSON 值
-        static json parse_value(u32_istream &strm)
+    template <class BasicJson>
+    inline void basic_shared_json<BasicJson>::push_back(basic_shared_json value)
+    {
+        CHECK_TYPE_MISMATCH(type(), json_t::array);
+        detach().elems.push_back(std::move(value));
+    }
+
+    template <class BasicJson>
+    inline bool basic_shared_json<BasicJson>::erase(string_view key)
+    {
+        CHECK_TYPE_MISMATCH(type(), json_t::object);
+        size_t pos;
+        size_t i = lookup(*_node, key, pos);
+        if (i == std::string::npos)
         {
-            // 查看下一个非空白字符以确定要解析的值类型
-            switch (peek_next_non_space(strm))
+            return false;
+        }
+        node &n = detach();
+        n.members.erase(n.members.begin() + static_cast<std::ptrdiff_t>(i));
+        n.index.erase(n.index.begin() + static_cast<std::ptrdiff_t>(pos));
+        for (uint32_t &k : n.index)
+        {
+            if (k > i)
             {
-            case U'"': // 字符串
-                return parse_string(strm);
-
-            case U'[': // 数组
-                return parse_array(strm);
-
-            // 数字，包括整数和浮点数
-            case U'0':
-            case U'1':
-            case U'2':
-            case U'3':
-            case U'4':
-            case U'5':
-            case U'6':
-            case U'7':
-            case U'8':
-            case U'9':
-            case U'-':
-            case U'.':
-                return parse_number(strm);
-
-            case U'{': // 对象
-                return parse_object(strm);
-
-            // 布尔值
-            case U'T':
-            case U't':
-            case U'F':
-            case U'f':
-                return parse_bool(strm);
-
-            // null
-            case U'n':
-            case U'N':
-                return parse_null(strm);
-
-            default: // 遇到意外的字符
-                throw std::runtime_error("unexpected character");
+                --k; // 后面的成员前移了一位
             }
         }
+        return true;
+    }
 
-        // 解析 JSON 对象
-        static json parse_object(u32_istream &strm)
+    template <class BasicJson>
+    inline bool basic_shared_json<BasicJson>::operator==(const basic_shared_json &rhs) const
+    {
+        if (_node == rhs._node)
         {
-            json return_val(json_object{}); // 创建一个空对象
-
-            // 跳过开头的 '{' 字符
-            skip_char(strm, U'{');
+            return true; // 共享的子树不必逐个比较
+        }
+        if (type() != rhs.type())
+        {
+            return false;
+        }
+        switch (type())
+        {
+        case json_t::array:
+            return _node->elems == rhs._node->elems;
 
-            int c = peek_next_non_space(strm);
-            // 循环直到遇到 '}'
-            while (c != EOF)
+        case json_t::object:
+            if (size() != rhs.size())
             {
-                if (c == U'"')
-                {                                            // 键名是字符串
-                    std::string member = parse_member(strm); // 解析成员键名
-
-                    skip_char(strm, U':'); // 跳过冒号
-
-                    return_val.add_member(member, parse_value(strm)); // 解析并添加成员值
-                }
-                else if (c == U'}')
-                {
-                    break; // 遇到 '}', 结束对象解析
-                }
-                else if (c == U',')
-                {
-                    // 跳过逗号，继续解析下一个成员
-                    c = get_next_non_space(strm);
-                }
-                else
+                return false;
+            }
+            for (const member &m : _node->members)
+            {
+                const basic_shared_json *other = rhs.find(string_view(m.first));
+                if (other == nullptr || !(m.second == *other))
                 {
-                    throw std::runtime_error("invalid object format"); // 对象格式错误
+                    return false;
                 }
-
-                c = peek_next_non_space(strm); // 查看下一个非空白字符
             }
+            return true;
 
-            skip_char(strm, U'}'); // 跳过结尾的 '}' 字符
-
-            return return_val; // 返回解析后的对象
+        default:
+            return _node->scalar == rhs._node->scalar;
         }
+    }
 
-        // 解析 JSON 成员（键）
-        static std::string parse_member(u32_istream &strm)
+    template <class BasicJson>
+    inline BasicJson basic_shared_json<BasicJson>::to_json() const
+    {
+        switch (type())
         {
-            std::u32string returnVal;
-
-            // 跳过开头的双引号
-            skip_char(strm, U'"');
-
-            unsigned int c = strm.peek(); // 查看当前字符
-            while (c != (unsigned int)EOF && c != U'"')
-            { // 当不是文件结束且不是双引号时循环
-                if (c == U'\\')
-                {
-                    // 转义字符
-                    returnVal.push_back(escape_char(strm));
-                }
-                else
-                {
-                    c = strm.get(); // 获取当前字符
-                    returnVal.push_back(c);
-                }
+        case json_t::null:
+            return json_type();
 
-                c = strm.peek(); // 再次查看当前字符
+        case json_t::array:
+        {
+            json_type out{typename json_type::array_t()};
+            out.get_array().reserve(_node->elems.size());
+            for (const basic_shared_json &elem : _node->elems)
+            {
+                out.add_element(elem.to_json());
             }
+            return out;
+        }
 
-            // 跳过结尾的双引号
-            skip_char(strm, U'"');
+        case json_t::object:
+        {
+            json_type out{typename json_type::object_t()};
+            for (const member &m : _node->members)
+            {
+                out.add_member(typename json_type::string_t(m.first.data(), m.first.size()), m.second.to_json());
+            }
+            return out;
+        }
 
-            return U32ToU8(returnVal); // 将 UTF-32 字符串转换为 UTF-8 字符串
+        default:
+            return _node->scalar;
         }
+    }
 
-        // 解析 JSON 数组
-        static json parse_array(u32_istream &strm)
+    template <class BasicJson>
+    template <class Sink>
+    inline void basic_shared_json<BasicJson>::dump(Sink &sink) const
+    {
+        switch (type())
         {
-            json_array vector_val;
-
-            // 跳过开头的 '[' 字符
-            skip_char(strm, U'[');
-            int c = peek_next_non_space(strm); // 查看下一个非空白字符
+        case json_t::null:
+            sink.write("null", 4);
+            break;
 
-            // 空数组
-            if (c == U']')
+        case json_t::array:
+            sink.put('[');
+            for (size_t i = 0; i < _node->elems.size(); i++)
             {
-                skip_char(strm, U']');   // 跳过结尾的 ']' 字符
-                return json(vector_val); // 返回空数组
+                if (i != 0)
+                    sink.put(',');
+                _node->elems[i].dump(sink);
             }
+            sink.put(']');
+            break;
 
-            do
+        case json_t::object:
+            sink.put('{');
+            for (size_t i = 0; i < _node->members.size(); i++)
             {
-                vector_val.push_back(parse_value(strm)); // 解析值并添加到数组
-                c = peek_next_non_space(strm);           // 查看下一个非空白字符
-
-                if (c == U',')
-                {
-                    skip_char(strm, U','); // 跳过逗号
-                }
-                else if (c == U']')
-                {
-                    break; // 遇到结尾的 ']' 字符时结束循环
-                }
-            } while (c != EOF); // 直到文件结束
-
-            // 跳过结尾的 ']' 字符
-            skip_char(strm, U']');
+                if (i != 0)
+                    sink.put(',');
+                write_string(sink, string_view(_node->members[i].first));
+                sink.write(" : ", 3);
+                _node->members[i].second.dump(sink);
+            }
+            sink.put('}');
+            break;
 
-            json array_val(vector_val); // 创建 JSON 数组对象
-            return array_val;           // 返回 JSON 数组对象
+        default:
+            _node->scalar.dump(sink);
+            break;
         }
+    }
 
-        // 解析 JSON 布尔值
-        static json parse_bool(u32_istream &strm)
-        {
-            std::u32string val_str;
+    template <class BasicJson>
+    inline std::string basic_shared_json<BasicJson>::to_string() const
+    {
+        std::string out;
+        string_sink<std::string> sink(out);
+        dump(sink);
+        return out;
+    }
 
-            int c = strm.peek(); // 查看当前字符
-            while (c != EOF && c != U',' && c != U'}' && c != U']')
-            {                                                              // 当不是文件结束且不是逗号、} 或 ] 时循环
-                c = strm.get();                                            // 获取当前字符
-                val_str.push_back(static_cast<char32_t>(std::tolower(c))); // 转换为小写并添加到字符串
-                c = strm.peek();                                           // 再次查看当前字符
+#if !defined(TINYJSON_NO_THREADS)
+    // 解析缓存的统计
+    struct cache_stats
+    {
+        uint64_t hits = 0;      ///< 命中次数
+        uint64_t misses = 0;    ///< 未命中（需要解析）的次数
+        uint64_t evictions = 0; ///< 因容量不足被淘汰的文档个数
+        size_t entries = 0;     ///< 当前缓存的文档个数
+        size_t bytes = 0;       ///< 当前缓存的输入字节数
+    };
+
+    // 按输入字节缓存解析结果的并发缓存：内容相同的输入只解析一次，之后直接返回共享的不可变文档（basic_shared_json）
+    // 缓存按哈希值分片，每个分片有自己的锁和 LRU 链表，锁内只有查找和链表操作，解析在锁外进行；
+    // 命中时还会比较输入的字节，哈希冲突不会返回错误的文档。容量按缓存的输入字节数计算，平均分给各分片，
+    // 超过分片容量的输入照常解析但不缓存。格式错误的输入不会被缓存
+    //     parse_cache cache(64 << 20);
+    //     shared_json doc = cache.parse(body); // 相同的 body 第二次起不再解析
+    template <class BasicJson>
+    class basic_parse_cache
+    {
+    public:
+        using json_type = BasicJson;
+        using document_type = basic_shared_json<BasicJson>;
+
+        /// capacity 为缓存的输入总字节数，shards 向上取整为 2 的幂
+        explicit basic_parse_cache(size_t capacity = size_t(64) << 20, size_t shards = 16)
+        {
+            size_t n = 1;
+            while (n < shards)
+            {
+                n <<= 1;
             }
+            _shards = std::vector<shard>(n);
+            _mask = n - 1;
+            _shard_capacity = capacity / n;
+        }
 
-            std::string bool_str = trim(U32ToU8(val_str)); // 转换为 UTF-8 字符串并去除空白字符
+        basic_parse_cache(const basic_parse_cache &) = delete;
+        basic_parse_cache &operator=(const basic_parse_cache &) = delete;
 
-            bool val_bool = to_bool(bool_str); // 转换为布尔值
-            json return_val(val_bool);         // 创建 JSON 布尔值对象
-            return return_val;                 // 返回 JSON 布尔值对象
+        /// 返回输入对应的文档，未命中时解析并放入缓存，格式错误时抛出 parse_exception
+        document_type parse(const char *s, size_t length)
+        {
+            uint64_t hash = hash_bytes64(string_view(s, length));
+            document_type doc;
+            if (lookup(hash, s, length, doc))
+            {
+                return doc;
+            }
+            doc = document_type(basic_parser<json_type>::parse(s, length));
+            return insert(hash, s, length, std::move(doc));
         }
 
-        // 解析 JSON null 值
-        static json parse_null(u32_istream &strm)
-        {
-            std::u32string val_str;
+        document_type parse(const std::string &s) { return parse(s.data(), s.size()); }
 
-            int c = strm.peek(); // 查看当前字符
-            while (c != EOF && c != U',' && c != U'}' && c != U']')
-            {                                                              // 当不是文件结束且不是逗号、} 或 ] 时循环
-                c = strm.get();                                            // 获取当前字符
-                val_str.push_back(static_cast<char32_t>(std::tolower(c))); // 转换为小写并添加到字符串
-                c = strm.peek();                                           // 再次查看当前字符
+        /// 不抛出异常的版本：格式错误时返回 null 并写入 error
+        document_type parse(const char *s, size_t length, parse_error &error)
+        {
+            error = parse_error();
+            uint64_t hash = hash_bytes64(string_view(s, length));
+            document_type doc;
+            if (lookup(hash, s, length, doc))
+            {
+                return doc;
             }
+            json_type parsed = basic_parser<json_type>::parse(s, length, error);
+            if (error)
+            {
+                return document_type();
+            }
+            return insert(hash, s, length, document_type(parsed));
+        }
 
-            std::string null_str = trim(U32ToU8(val_str)); // 转换为 UTF-8 字符串并去除空白字符
-
-            if (null_str == "null")
-            {                  // 如果字符串是 "null"
-                return json(); // 返回 JSON null 对象
+        cache_stats stats() const
+        {
+            cache_stats s;
+            s.hits = _hits.load(std::memory_order_relaxed);
+            s.misses = _misses.load(std::memory_order_relaxed);
+            s.evictions = _evictions.load(std::memory_order_relaxed);
+            for (const shard &sh : _shards)
+            {
+                std::lock_guard<std::mutex> lock(sh.mutex);
+                s.entries += sh.map.size();
+                s.bytes += sh.bytes;
             }
-            else
+            return s;
+        }
+
+        /// 清空缓存，统计的命中次数等保留
+        void clear()
+        {
+            for (shard &sh : _shards)
             {
-                throw std::runtime_error("unexpected null string"); // 抛出异常，null 字符串不符合预期
+                std::lock_guard<std::mutex> lock(sh.mutex);
+                sh.map.clear();
+                sh.lru.clear();
+                sh.bytes = 0;
             }
         }
 
-        // 解析 JSON 字符串值
-        static json parse_string(u32_istream &strm)
+    private:
+        struct entry
         {
-            std::u32string string_val;
+            uint64_t hash;      ///< 输入的哈希值
+            std::string input;  ///< 输入的字节，命中时用于确认内容相同
+            document_type doc;  ///< 解析结果
+        };
 
-            // 跳过字符串开头的双引号
-            skip_char(strm, U'"');
+        using lru_list = std::list<entry>;
 
-            char32_t c = strm.peek(); // 查看当前字符
+        struct shard
+        {
+            mutable std::mutex mutex;
+            lru_list lru;                                                      ///< 最近使用的在前
+            std::unordered_map<uint64_t, typename lru_list::iterator> map; ///< 哈希值到链表节点
+            size_t bytes = 0;                                                  ///< 分片中缓存的输入字节数
+        };
 
-            // 当字符不是文件结束标志且不是双引号时循环
-            while (c != EOF && c != U'"')
+        shard &shard_for(uint64_t hash) { return _shards[(hash >> 32) & _mask]; }
+
+        bool lookup(uint64_t hash, const char *s, size_t length, document_type &doc)
+        {
+            shard &sh = shard_for(hash);
             {
-                if (c == U'\\')
-                {
-                    // 处理转义字符
-                    string_val.push_back(escape_char(strm));
-                }
-                else
+                std::lock_guard<std::mutex> lock(sh.mutex);
+                auto it = sh.map.find(hash);
+                if (it != sh.map.end() && it->second->input.size() == length &&
+                    std::memcmp(it->second->input.data(), s, length) == 0)
                 {
-                    strm.get(c);             // 获取当前字符
-                    string_val.push_back(c); // 添加到字符串
+                    sh.lru.splice(sh.lru.begin(), sh.lru, it->second);
+                    doc = it->second->doc;
+                    _hits.fetch_add(1, std::memory_order_relaxed);
+                    return true;
                 }
-
-                c = strm.peek(); // 查看下一个字符
             }
-
-            // 跳过字符串结尾的双引号
-            skip_char(strm, U'"');
-
-            // 将 UTF-32 编码的字符串转换为 UTF-8 编码，并创建 JSON 字符串对象
-            json return_val(U32ToU8(string_val));
-            return return_val; // 返回 JSON 字符串对象
+            _misses.fetch_add(1, std::memory_order_relaxed);
+            return false;
         }
 
-        // 解析 JSON 数值
-        static json parse_number(u32_istream &strm)
+        // 放入缓存并返回缓存中的文档；其他线程已经放入了相同的输入时返回已有的文档
+        document_type insert(uint64_t hash, const char *s, size_t length, document_type doc)
         {
-            std::u32string num_str;
-
-            int c = strm.peek(); // 查看当前字符
-            while (c != EOF && c != U',' && c != U']' && c != U'}')
-            {                         // 当不是文件结束且不是逗号、] 或 } 时循环
-                c = strm.get();       // 获取当前字符
-                num_str.push_back(c); // 添加到字符串
-                c = strm.peek();      // 查看下一个字符
+            if (length > _shard_capacity)
+            {
+                return doc;
             }
-
-            std::string nums = trim(U32ToU8(num_str)); // 转换为 UTF-8 字符串并去除空白字符
-
-            // 尝试将字符串转换为整数，如果包含非数字字符，则转换为双精度浮点数
-            if (nums.find_first_not_of("0123456789-") == std::string::npos)
+            shard &sh = shard_for(hash);
+            std::lock_guard<std::mutex> lock(sh.mutex);
+            auto it = sh.map.find(hash);
+            if (it != sh.map.end())
             {
-                return json(to_integer(nums)); // 转换为整数
+                entry &e = *it->second;
+                if (e.input.size() == length && std::memcmp(e.input.data(), s, length) == 0)
+                {
+                    return e.doc;
+                }
+                // 哈希冲突：新的输入替换旧的
+                sh.bytes -= e.input.size();
+                sh.lru.erase(it->second);
+                sh.map.erase(it);
             }
-            else
+            while (sh.bytes + length > _shard_capacity && !sh.lru.empty())
             {
-                return json(to_double(nums)); // 转换为双精度浮点数
+                entry &victim = sh.lru.back();
+                sh.bytes -= victim.input.size();
+                sh.map.erase(victim.hash);
+                sh.lru.pop_back();
+                _evictions.fetch_add(1, std::memory_order_relaxed);
             }
+            sh.lru.push_front(entry{hash, std::string(s, length), doc});
+            sh.map[hash] = sh.lru.begin();
+            sh.bytes += length;
+            return doc;
         }
 
-        // 将字符串转换为布尔值
-        static bool to_bool(std::string str)
+        std::vector<shard> _shards;
+        size_t _mask;           ///< 分片个数减一
+        size_t _shard_capacity; ///< 每个分片可以缓存的输入字节数
+        std::atomic<uint64_t> _hits{0};
+        std::atomic<uint64_t> _misses{0};
+        std::atomic<uint64_t> _evictions{0};
+    };
+
+    using parse_cache = basic_parse_cache<json>;
+#endif
+
+    //
+    // 结构体绑定：用 TINYJSON_FIELDS 声明结构体的字段后，serialize/deserialize 直接在字节输入和 sink 上工作，
+    // 不构建中间的 json 树；字段名在编译期确定，匹配键名时先比较长度再比较内容
+    // 支持的字段类型：bool、整数、浮点数、std::string、std::vector、以 std::string 为键的 std::map、
+    // basic_json（按原样解析或输出）以及同样声明了字段的结构体
+    //
+
+    // 判断 T 是否通过 TINYJSON_FIELDS 声明了字段（由 ADL 找到宏生成的 tinyjson_visit_fields）
+    template <class T>
+    struct has_json_fields
+    {
+    private:
+        struct probe
         {
-            std::transform(str.begin(), str.end(), str.begin(), // 转换字符串中所有字符为小写
-                           [](unsigned char c)
-                           {
-                               return static_cast<unsigned char>(std::tolower(c));
-                           });
+            template <size_t N, class F>
+            void operator()(const char (&)[N], F &) const {}
+        };
 
-            if (str == "true") // 如果字符串是 "true"
-                return true;   // 返回 true
+        template <class U>
+        static auto test(int) -> decltype(tinyjson_visit_fields(std::declval<U &>(), std::declval<probe &>()),
+                                          std::true_type());
+        template <class>
+        static std::false_type test(...);
 
-            if (str == "false") // 如果字符串是 "false"
-                return false;   // 返回 false
+    public:
+        static const bool value = decltype(test<T>(0))::value;
+    };
 
-            throw std::runtime_error("invalid boolean string"); // 抛出异常，布尔字符串不符合预期
-        }
+    // 把值直接写入 sink，格式与 basic_json::dump 相同
+    template <class Sink>
+    class struct_writer
+    {
+    public:
+        explicit struct_writer(Sink &sink) : _sink(sink) {}
 
-        // 将字符串转换为长整型数
-        static long long to_integer(std::string str)
+        void write(bool v)
         {
-            size_t pos = 0;
-            long long num = std::stoll(str, &pos); // 尝试将字符串转换为长整型数
+            if (v)
+                _sink.write("true", 4);
+            else
+                _sink.write("false", 5);
+        }
 
-            if (pos != str.size())
+        template <class T>
+        typename std::enable_if<std::is_integral<T>::value>::type write(T v)
+        {
+            if (std::is_unsigned<T>::value && static_cast<unsigned long long>(v) > static_cast<unsigned long long>(std::numeric_limits<long long>::max()))
             {
-                // 如果转换后的字符串位置不等于字符串的长度，则格式不正确
-                throw std::runtime_error("Unexpected number(integer) format.");
+                TINYJSON_THROW(std::runtime_error("number out of range"));
             }
+            char buf[24];
+            char *end = buf + sizeof(buf);
+            char *begin = format_integer(static_cast<long long>(v), end);
+            _sink.write(begin, static_cast<size_t>(end - begin));
+        }
 
-            return num; // 返回转换后的长整型数
+        template <class T>
+        typename std::enable_if<std::is_floating_point<T>::value>::type write(T v)
+        {
+            char buf[double_buffer_size];
+            _sink.write(buf, format_double(static_cast<double>(v), buf));
         }
 
-        // 将字符串转换为双精度浮点数
-        static double to_double(std::string str)
+        void write(const std::string &v) { write_string(_sink, string_view(v)); }
+        void write(const char *v) { write_string(_sink, string_view(v)); }
+
+        template <class T, class A>
+        void write(const std::vector<T, A> &v)
         {
-            size_t pos = 0;
-            double num = std::stod(str, &pos); // 尝试将字符串转换为双精度浮点数
+            _sink.put('[');
+            for (size_t i = 0; i < v.size(); i++)
+            {
+                if (i != 0)
+                    _sink.put(',');
+                write(static_cast<T>(v[i])); // vector<bool> 的元素是代理对象
+            }
+            _sink.put(']');
+        }
 
-            if (pos != str.size())
+        template <class T, class C, class A>
+        void write(const std::map<std::string, T, C, A> &v)
+        {
+            _sink.put('{');
+            for (auto it = v.begin(); it != v.end(); ++it)
             {
-                // 如果转换后的字符串位置不等于字符串的长度，则格式不正确
-                throw std::runtime_error("Unexpected number(double) format.");
+                if (it != v.begin())
+                    _sink.put(',');
+                write_member(it->first.data(), it->first.size(), it->second);
             }
+            _sink.put('}');
+        }
 
-            return num; // 返回转换后的双精度浮点数
+        template <class A, template <class, class, class, class> class M>
+        void write(const basic_json<A, M> &v) { v.dump(_sink); }
+
+        template <class T>
+        typename std::enable_if<has_json_fields<T>::value>::type write(const T &v)
+        {
+            _sink.put('{');
+            member_writer members{*this, true};
+            tinyjson_visit_fields(v, members);
+            _sink.put('}');
         }
 
-        // 解析转义字符
-        static char32_t escape_char(u32_istream &strm)
+    private:
+        template <class T>
+        void write_member(const char *name, size_t length, const T &v)
         {
-            skip_char(strm, U'\\'); // 跳过反斜杠
+            write_string(_sink, string_view(name, length));
+            _sink.write(" : ", 3);
+            write(v);
+        }
 
-            char32_t c = strm.get(); // 获取下一个字符
+        /// 依次写出结构体的每个字段
+        struct member_writer
+        {
+            struct_writer &writer;
+            bool first;
 
-            switch (c)
+            template <size_t N, class F>
+            void operator()(const char (&name)[N], const F &field)
             {
-            case U'"':
-                c = U'"'; // 双引号
-                break;
-
-            case U'\\':
-                c = U'\\'; // 反斜杠
-                break;
+                if (!first)
+                    writer._sink.put(',');
+                first = false;
+                writer.write_member(name, N - 1, field);
+            }
+        };
 
-            case U'/':
-                c = U'/'; // 斜杠
-                break;
+        Sink &_sink; ///< 输出目标
+    };
 
-            case U'b':
-                c = U'\b'; // 退格符
-                break;
+    // 从字节输入直接解析到值中，格式错误或类型不符时抛出异常
+    // 结构体中未声明的成员被跳过，输入中缺少的字段保持原值
+    class struct_reader
+    {
+    public:
+        struct_reader(const char *s, size_t length) : _cursor(s, length) {}
 
-            case U'f':
-                c = U'\f'; // 换页符
-                break;
+        /// 读取整个输入，值之后只能有空白
+        template <class T>
+        void read_document(T &v)
+        {
+            read(v);
+            if (parser::peek_next_non_space(_cursor) != EOF)
+            {
+                TINYJSON_THROW(std::runtime_error("invalid json format"));
+            }
+        }
 
-            case U'n':
-                c = U'\n'; // 换行符
-                break;
+        void read(bool &v)
+        {
+            expect(json_t::boolean);
+            bool_handler h;
+            parser::sax_value(_cursor, h, _scratch);
+            v = h.value;
+        }
 
-            case U'r':
-                c = U'\r'; // 回车符
-                break;
+        template <class T>
+        typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value>::type read(T &v)
+        {
+            parsed_number num = read_number();
+            if (num.type != json_t::number_integer)
+            {
+                CHECK_TYPE_MISMATCH(num.type, json_t::number_integer);
+            }
+            bool fits = num.integer < 0
+                            ? std::is_signed<T>::value && num.integer >= static_cast<long long>(std::numeric_limits<T>::min())
+                            : static_cast<unsigned long long>(num.integer) <= static_cast<unsigned long long>(std::numeric_limits<T>::max());
+            if (!fits)
+            {
+                TINYJSON_THROW(std::runtime_error("number out of range"));
+            }
+            v = static_cast<T>(num.integer);
+        }
 
-            case U't':
-                c = U'\t'; // 制表符
-                break;
+        template <class T>
+        typename std::enable_if<std::is_floating_point<T>::value>::type read(T &v)
+        {
+            parsed_number num = read_number();
+            v = static_cast<T>(num.type == json_t::number_integer ? static_cast<double>(num.integer) : num.number);
+        }
 
-            case U'u':
-                c = parse_hex(strm); // 解析 Unicode 转义序列
-                break;
+        void read(std::string &v)
+        {
+            expect(json_t::string);
+            string_view s = parser::scan_string(_cursor, _scratch);
+            v.assign(s.data(), s.size());
+        }
 
-            default:
-                // 如果反斜杠后不是有效的转义字符，则抛出异常
-                throw std::runtime_error("backslash is followed by invalid character");
+        template <class T, class A>
+        void read(std::vector<T, A> &v)
+        {
+            expect(json_t::array);
+            v.clear();
+            parser::skip_char(_cursor, '[');
+            if (parser::peek_next_non_space(_cursor) == ']')
+            {
+                _cursor.get();
+                return;
+            }
+            while (true)
+            {
+                T elem = T();
+                read(elem);
+                v.push_back(std::move(elem));
+                int c = parser::get_next_non_space(_cursor);
+                if (c == ']')
+                    return;
+                if (c != ',')
+                    TINYJSON_THROW(std::runtime_error("expected char ']' not found"));
             }
+        }
 
-            return c; // 返回转义后的字符
+        template <class T, class C, class A>
+        void read(std::map<std::string, T, C, A> &v)
+        {
+            v.clear();
+            read_members([&](string_view key) {
+                read(v[std::string(key.data(), key.size())]);
+                return true;
+            });
         }
 
-        // 获取下一个非空白字符
-        static char32_t get_next_non_space(u32_istream &strm)
+        template <class A, template <class, class, class, class> class M>
+        void read(basic_json<A, M> &v)
         {
-            skip_space(strm);  // 跳过所有空白字符
-            return strm.get(); // 获取下一个字符
+            parser::skip_space(_cursor);
+            v = basic_parser<basic_json<A, M>>::parse_value(_cursor);
         }
 
-        // 查看下一个非空白字符，但不从流中移除它
-        static int peek_next_non_space(u32_istream &strm)
+        template <class T>
+        typename std::enable_if<has_json_fields<T>::value>::type read(T &v)
         {
-            skip_space(strm);   // 跳过所有空白字符
-            return strm.peek(); // 查看下一个字符，但不移除
+            read_members([&](string_view key) {
+                member_reader members{*this, key, false};
+                tinyjson_visit_fields(v, members);
+                return members.found;
+            });
         }
 
-        // 跳过字符直到遇到预期的字符，如果遇到不同的字符则抛出异常
-        static void skip_char(u32_istream &strm, char32_t expected)
+    private:
+        /// 接收一个布尔值的 SAX 处理器
+        struct bool_handler : json_sax
         {
-            skip_space(strm);                      // 跳过所有空白字符
-            char32_t next = (char32_t)strm.peek(); // 查看下一个字符
+            bool value = false;
+            bool boolean(bool v) override
+            {
+                value = v;
+                return true;
+            }
+        };
 
-            if (next != expected || next == (char32_t)EOF)
-            {                                                            // 如果下一个字符不是预期的字符或文件结束
-                std::basic_ostringstream<char32_t> oss;                  // 创建字符串流以构建错误信息
-                oss << U"expected char '" << expected << U"' not found"; // 构建错误信息
-                auto err_str = oss.str();                                // 获取错误信息字符串
-                throw std::runtime_error(U32ToU8(err_str));              // 抛出异常，将 UTF-32 错误信息转换为 UTF-8
+        /// 在结构体的字段中查找与键名匹配的字段并读取
+        struct member_reader
+        {
+            struct_reader &reader;
+            string_view key;
+            bool found;
+
+            template <size_t N, class F>
+            void operator()(const char (&name)[N], F &field)
+            {
+                if (!found && key.size() == N - 1 && std::memcmp(key.data(), name, N - 1) == 0)
+                {
+                    found = true;
+                    reader.read(field);
+                }
             }
+        };
 
-            strm.get(); // 移除预期的字符
+        // 确认下一个值的类型与预期一致
+        void expect(json_t expected)
+        {
+            json_t found;
+            switch (parser::peek_next_non_space(_cursor))
+            {
+            case '"':
+                found = json_t::string;
+                break;
+            case '{':
+                found = json_t::object;
+                break;
+            case '[':
+                found = json_t::array;
+                break;
+            case 't':
+            case 'T':
+            case 'f':
+            case 'F':
+                found = json_t::boolean;
+                break;
+            case 'n':
+            case 'N':
+                found = json_t::null;
+                break;
+            case EOF:
+                TINYJSON_THROW(std::runtime_error("unexpected end of input"));
+            default:
+                found = json_t::number_integer;
+                break;
+            }
+            if (found != expected && !(expected == json_t::number_double && found == json_t::number_integer))
+            {
+                CHECK_TYPE_MISMATCH(found, expected);
+            }
         }
 
-        // 跳过所有空白字符
-        static void skip_space(u32_istream &strm)
+        parsed_number read_number()
         {
-            unsigned int next = strm.peek(); // 查看下一个字符
-            while (next != (char32_t)EOF && std::isspace(next))
-            {                       // 如果下一个字符是空白字符
-                strm.get();         // 移除空白字符
-                next = strm.peek(); // 查看下一个字符
+            expect(json_t::number_double);
+            const char *begin = _cursor.cur;
+            while (_cursor.cur < _cursor.end && is_number_byte(*_cursor.cur))
+            {
+                ++_cursor.cur;
             }
+            return parser::to_number(begin, _cursor.cur);
         }
 
-        // 解析 Unicode 转义序列（例如 \uXXXX）
-        static char32_t parse_hex(u32_istream &strm)
+        // 逐个读取对象的键名并交给 on_key；on_key 返回 false 时跳过该成员的值
+        template <class OnKey>
+        void read_members(OnKey on_key)
         {
-            std::u32string cs; // 用于存储四位十六进制数
-
-            // 读取四位十六进制数
-            for (int i = 0; i < 4; i++)
+            expect(json_t::object);
+            parser::skip_char(_cursor, '{');
+            if (parser::peek_next_non_space(_cursor) == '}')
             {
-                char32_t c = strm.get(); // 获取下一个字符
-                if (c != std::char_traits<char32_t>::eof() && isxdigit(c))
-                {                    // 如果字符不是文件结束且是十六进制数字
-                    cs.push_back(c); // 添加到字符串
+                _cursor.get();
+                return;
+            }
+            std::string key;
+            while (true)
+            {
+                if (parser::peek_next_non_space(_cursor) != '"')
+                {
+                    TINYJSON_THROW(std::runtime_error("invalid object format"));
                 }
-                else
+                string_view name = parser::scan_string(_cursor, _scratch);
+                key.assign(name.data(), name.size()); // 读取值时 _scratch 会被复用
+                parser::skip_char(_cursor, ':');
+                if (!on_key(string_view(key)))
                 {
-                    throw std::runtime_error("not hex number"); // 抛出异常，输入不是有效的十六进制数
+                    json_sax ignore; // 未声明的成员：校验并丢弃
+                    parser::sax_value(_cursor, ignore, _scratch);
                 }
+                int c = parser::get_next_non_space(_cursor);
+                if (c == '}')
+                    return;
+                if (c != ',')
+                    TINYJSON_THROW(std::runtime_error("invalid object format"));
             }
-
-            std::basic_stringstream<char32_t> is(cs); // 创建字符串流以解析十六进制数
-            unsigned int uc;
-            is >> std::hex >> uc; // 解析十六进制数
-
-            return char32_t(uc); // 返回转换后的字符
         }
+
+        byte_cursor _cursor;  ///< 输入
+        std::string _scratch; ///< 解码转义字符串的缓冲区
     };
 
+    // 把值直接序列化到 sink
+    template <class T, class Sink>
+    inline void serialize(const T &value, Sink &sink)
+    {
+        struct_writer<Sink> writer(sink);
+        writer.write(value);
+    }
+
+    // 把值序列化为字符串
+    template <class T>
+    inline std::string serialize(const T &value)
+    {
+        std::string out;
+        string_sink<std::string> sink(out);
+        serialize(value, sink);
+        return out;
+    }
+
+    // 从 UTF-8 字节序列直接解析到 value
+    template <class T>
+    inline void deserialize(const char *s, size_t length, T &value)
+    {
+        struct_reader reader(s, length);
+        reader.read_document(value);
+    }
+
+    template <class T>
+    inline void deserialize(const std::string &s, T &value)
+    {
+        deserialize(s.data(), s.size(), value);
+    }
+
+    template <class T>
+    inline T deserialize(const std::string &s)
+    {
+        T value = T();
+        deserialize(s, value);
+        return value;
+    }
+
 } // namespace TinyJson
+
+// 声明结构体中参与 JSON 绑定的字段，需放在结构体所在的命名空间中（结构体定义之后），最多 32 个字段：
+//     struct point { int x; int y; };
+//     TINYJSON_FIELDS(point, x, y)
+// 生成的 tinyjson_visit_fields 通过 ADL 被 serialize/deserialize 找到，字段名即 JSON 键名
+#define TINYJSON_EXPAND(x) x
+#define TINYJSON_FOR_EACH_1(m, a) m(a)
+#define TINYJSON_FOR_EACH_2(m, a, ...) m(a) TINYJSON_EXPAND(TINYJSON_FOR_EACH_1(m, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_3(m, a, ...) m(a) TINYJSON_EXPAND(TINYJSON_FOR_EACH_2(m, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_4(m, a, ...) m(a) TINYJSON_EXPAND(TINYJSON_FOR_EACH_3(m, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_5(m, a, ...) m(a) TINYJSON_EXPAND(TINYJSON_FOR_EACH_4(m, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_6(m, a, ...) m(a) TINYJSON_EXPAND(TINYJSON_FOR_EACH_5(m, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_7(m, a, ...) m(a) TINYJSON_EXPAND(TINYJSON_FOR_EACH_6(m, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_8(m, a, ...) m(a) TINYJSON_EXPAND(TINYJSON_FOR_EACH_7(m, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_9(m, a, ...) m(a) TINYJSON_EXPAND(TINYJSON_FOR_EACH_8(m, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_10(m, a, ...) m(a) TINYJSON_EXPAND(TINYJSON_FOR_EACH_9(m, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_11(m, a, ...) m(a) TINYJSON_EXPAND(TINYJSON_FOR_EACH_10(m, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_12(m, a, ...) m(a) TINYJSON_EXPAND(TINYJSON_FOR_EACH_11(m, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_13(m, a, ...) m(a) TINYJSON_EXPAND(TINYJSON_FOR_EACH_12(m, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_14(m, a, ...) m(a) TINYJSON_EXPAND(TINYJSON_FOR_EACH_13(m, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_15(m, a, ...) m(a) TINYJSON_EXPAND(TINYJSON_FOR_EACH_14(m, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_16(m, a, ...) m(a) TINYJSON_EXPAND(TINYJSON_FOR_EACH_15(m, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_17(m, a, ...) m(a) TINYJSON_EXPAND(TINYJSON_FOR_EACH_16(m, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_18(m, a, ...) m(a) TINYJSON_EXPAND(TINYJSON_FOR_EACH_17(m, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_19(m, a, ...) m(a) TINYJSON_EXPAND(TINYJSON_FOR_EACH_18(m, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_20(m, a, ...) m(a) TINYJSON_EXPAND(TINYJSON_FOR_EACH_19(m, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_21(m, a, ...) m(a) TINYJSON_EXPAND(TINYJSON_FOR_EACH_20(m, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_22(m, a, ...) m(a) TINYJSON_EXPAND(TINYJSON_FOR_EACH_21(m, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_23(m, a, ...) m(a) TINYJSON_EXPAND(TINYJSON_FOR_EACH_22(m, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_24(m, a, ...) m(a) TINYJSON_EXPAND(TINYJSON_FOR_EACH_23(m, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_25(m, a, ...) m(a) TINYJSON_EXPAND(TINYJSON_FOR_EACH_24(m, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_26(m, a, ...) m(a) TINYJSON_EXPAND(TINYJSON_FOR_EACH_25(m, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_27(m, a, ...) m(a) TINYJSON_EXPAND(TINYJSON_FOR_EACH_26(m, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_28(m, a, ...) m(a) TINYJSON_EXPAND(TINYJSON_FOR_EACH_27(m, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_29(m, a, ...) m(a) TINYJSON_EXPAND(TINYJSON_FOR_EACH_28(m, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_30(m, a, ...) m(a) TINYJSON_EXPAND(TINYJSON_FOR_EACH_29(m, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_31(m, a, ...) m(a) TINYJSON_EXPAND(TINYJSON_FOR_EACH_30(m, __VA_ARGS__))
+#define TINYJSON_FOR_EACH_32(m, a, ...) m(a) TINYJSON_EXPAND(TINYJSON_FOR_EACH_31(m, __VA_ARGS__))
+#define TINYJSON_SELECT(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, NAME, ...) NAME
+#define TINYJSON_FOR_EACH(m, ...) \
+    TINYJSON_EXPAND(TINYJSON_SELECT(__VA_ARGS__, TINYJSON_FOR_EACH_32, TINYJSON_FOR_EACH_31, TINYJSON_FOR_EACH_30, TINYJSON_FOR_EACH_29, TINYJSON_FOR_EACH_28, TINYJSON_FOR_EACH_27, TINYJSON_FOR_EACH_26, TINYJSON_FOR_EACH_25, TINYJSON_FOR_EACH_24, TINYJSON_FOR_EACH_23, TINYJSON_FOR_EACH_22, TINYJSON_FOR_EACH_21, TINYJSON_FOR_EACH_20, TINYJSON_FOR_EACH_19, TINYJSON_FOR_EACH_18, TINYJSON_FOR_EACH_17, TINYJSON_FOR_EACH_16, TINYJSON_FOR_EACH_15, TINYJSON_FOR_EACH_14, TINYJSON_FOR_EACH_13, TINYJSON_FOR_EACH_12, TINYJSON_FOR_EACH_11, TINYJSON_FOR_EACH_10, TINYJSON_FOR_EACH_9, TINYJSON_FOR_EACH_8, TINYJSON_FOR_EACH_7, TINYJSON_FOR_EACH_6, TINYJSON_FOR_EACH_5, TINYJSON_FOR_EACH_4, TINYJSON_FOR_EACH_3, TINYJSON_FOR_EACH_2, TINYJSON_FOR_EACH_1)(m, __VA_ARGS__))
+#define TINYJSON_VISIT_FIELD(f) v(#f, obj.f);
+#define TINYJSON_FIELDS(Type, ...)                                                \
+    template <class Visitor>                                                      \
+    inline void tinyjson_visit_fields(Type &obj, Visitor &&v)                     \
+    {                                                                             \
+        TINYJSON_EXPAND(TINYJSON_FOR_EACH(TINYJSON_VISIT_FIELD, __VA_ARGS__))     \
+    }                                                                             \
+    template <class Visitor>                                                      \
+    inline void tinyjson_visit_fields(const Type &obj, Visitor &&v)               \
+    {                                                                             \
+        TINYJSON_EXPAND(TINYJSON_FOR_EACH(TINYJSON_VISIT_FIELD, __VA_ARGS__))     \
+    }
@@ -1,5 +1,9 @@
 #include <gtest/gtest.h>
-#include "..\include\TinyJson.h"
+#include <atomic>
+#include <fstream>
+#include <limits>
+#include <thread>
+#include "../include/TinyJson.h"
 
 using namespace TinyJson;
 
@@ -231,7 +235,7 @@ TEST(TinyJsonHexCharParsing, Basic)
 
 TEST(TinyJsonArrayParsing, Basic)
 {
-    u32_sstream as1(U" [124, -2.534, " hello world ", null, false ]");
+    u32_sstream as1(U" [124, -2.534, \"hello world  \", null, false ]");
     auto a1 = parser::parse_array(as1);
 
     EXPECT_EQ(5, a1.size());
@@ -325,7 +329,7 @@ TEST(TinyJsonObjectParsing, Basic)
 
 TEST(TinyJsonMemberParsing, Basic)
 {
-    u32_sstream ss1(U""\x4F60\x202F2 hello "");
+    u32_sstream ss1(U"\"\x4F60\x202F2 hello\"");
     auto member_name = parser::parse_member(ss1);
     EXPECT_EQ("你𠋲 hello", member_name);
 
@@ -386,8 +390,9 @@ TEST(SimpleJsonSerialization, Basic)
     EXPECT_EQ(false, b["_______p5"][2].get_bool());
 
     EXPECT_EQ(false, b["示例一"].get_bool());
-    EXPECT_EQ("world9", b["你好 hello"].get_string());
-    EXPECT_EQ("你好", b["世界__i_^"].get_string());
+    // 序列化时转义反斜杠，字面的 \u 序列原样往返
+    EXPECT_EQ("world\\u0039", b["你好 hello"].get_string());
+    EXPECT_EQ("你好", b["世界__\\u0069_\\u005E"].get_string());
 
     json c(json_object{});
     EXPECT_EQ("{}", c.to_string());
@@ -495,7 +500,7 @@ TEST(SimpleJsonBoolParsingFailure, Basic)
 
 TEST(SimpleJsonStringParsingFailure, Basic)
 {
-    u32_sstream ss1(U"" hello world \"");
+    u32_sstream ss1(U"\" hello world ");
     EXPECT_THROW(parser::parse_string(ss1), std::exception);
 
     u32_sstream ss2(U"\"hello world \\u00A");
@@ -548,4 +553,1813 @@ TEST(SimpleJsonObjectParsingFailure, Basic)
 
     u32_sstream os6(U"{\"hello: 124 }");
     EXPECT_THROW(parser::parse_object(os6), std::exception);
-}
\ No newline at end of file
+}
+TEST(TinyJsonByteParsing, Basic)
+{
+    const char *doc = R"( {"p1" : [124, -2.534, "hello world", null, TRUE, {}],
+                          "p2" : {"_53245": -235235, "e": 1.5e3},
+                          "\u4E16\u754C" : "\ud83d\ude00 \"\\ \t",
+                          "你好" : "世界" } )";
+
+    json a = parser::parse(doc);
+    EXPECT_EQ(4, a.size());
+    EXPECT_EQ(6, a["p1"].size());
+    EXPECT_EQ(124, a["p1"][0].get_integer());
+    EXPECT_DOUBLE_EQ(-2.534, a["p1"][1].get_double());
+    EXPECT_EQ("hello world", a["p1"][2].get_string());
+    EXPECT_EQ(nullptr, a["p1"][3].get_null());
+    EXPECT_EQ(true, a["p1"][4].get_bool());
+    EXPECT_EQ(json_t::object, a["p1"][5].type());
+    EXPECT_EQ(-235235, a["p2"]["_53245"].get_integer());
+    EXPECT_DOUBLE_EQ(1500, a["p2"]["e"].get_double());
+    EXPECT_EQ("\xF0\x9F\x98\x80 \"\\ \t", a["世界"].get_string());
+    EXPECT_EQ("世界", a["你好"].get_string());
+
+    // 字节级解析与流式后备路径得到相同的结果
+    const char *doc2 = R"({"p1" : [1984, "\u4E16\u754C", false, null], "p2" : {"a" : -0.5}, "p3" : "你好"})";
+    std::stringstream sstrm(doc2);
+    EXPECT_TRUE(parser::parse(doc2) == parser::parse(sstrm));
+
+    // 输入不需要以 NUL 结尾
+    std::string padded = "[1, 2, 3]garbage";
+    json b = parser::parse(padded.data(), 9);
+    EXPECT_EQ(3, b.size());
+    EXPECT_EQ(3, b[2].get_integer());
+}
+
+TEST(TinyJsonByteParsingFailure, Basic)
+{
+    EXPECT_THROW(parser::parse("[\"\xC0\xAF\"]"), std::exception);     // 过长编码
+    EXPECT_THROW(parser::parse("[\"\xED\xA0\x80\"]"), std::exception); // 代理区码点
+    EXPECT_THROW(parser::parse("[\"\xE4\xB8\"]"), std::exception);     // 截断的多字节序列
+    EXPECT_THROW(parser::parse("[\"\\ud83d\"]"), std::exception);      // 不成对的代理
+    EXPECT_THROW(parser::parse("[1 2]"), std::exception);
+    EXPECT_THROW(parser::parse("[1,]"), std::exception);
+    EXPECT_THROW(parser::parse("{\"a\" 1}"), std::exception);
+    EXPECT_THROW(parser::parse("{\"a\":1,}"), std::exception);
+    EXPECT_THROW(parser::parse("[\"abc"), std::exception);
+    EXPECT_THROW(parser::parse("[tru]"), std::exception);
+    EXPECT_THROW(parser::parse("[124abc]"), std::exception);
+    EXPECT_THROW(parser::parse("[] []"), std::exception);
+    EXPECT_THROW(parser::parse("12"), std::exception);
+}
+
+TEST(SimpleJsonInlineStorage, Basic)
+{
+    // 标量内联存储，节点只比一个指针加类型标签大
+    EXPECT_LE(sizeof(json), 2 * sizeof(void *));
+
+    json a(1984);
+    a = json("1984");
+    EXPECT_EQ("1984", a.get_string());
+    a = json(json_array{1, 2.5, true});
+    EXPECT_EQ(3, a.size());
+    a = a;
+    EXPECT_EQ(3, a.size());
+    a = json(-7);
+    EXPECT_EQ(-7, a.get_integer());
+
+    json_array ints;
+    for (int i = 0; i < 1000; i++)
+    {
+        ints.push_back(i);
+    }
+    json b(ints);
+    json c(b);
+    EXPECT_EQ(b, c);
+    EXPECT_EQ(999, c[999].get_integer());
+}
+
+TEST(SimpleJsonMoveSemantics, Basic)
+{
+    json a(json_array{1, "two", 3.0});
+    json b(std::move(a));
+    EXPECT_EQ(json_t::null, a.type());
+    EXPECT_EQ(3, b.size());
+
+    json c;
+    c = std::move(b);
+    EXPECT_EQ(json_t::null, b.type());
+    EXPECT_EQ("two", c[1].get_string());
+
+    json_object members;
+    members["p1"] = json("hello");
+    json o(std::move(members));
+    EXPECT_EQ(0, members.size());
+    EXPECT_EQ("hello", o["p1"].get_string());
+
+    o.add_member("p2", std::move(c));
+    EXPECT_EQ(json_t::null, c.type());
+    EXPECT_EQ(3, o["p2"].size());
+}
+
+TEST(SimpleJsonReferenceAccessors, Basic)
+{
+    json a = parser::parse(R"({"p1" : [1, 2, 3], "p2" : {"q" : "hello"}})");
+    const json &ca = a;
+
+    // 只读访问返回的是同一份数据，而不是副本
+    EXPECT_EQ(&ca.get_object(), &ca.get_object());
+    EXPECT_EQ(&ca["p1"].get_array(), &ca["p1"].get_array());
+    EXPECT_EQ(&ca["p2"]["q"].get_string(), &ca["p2"]["q"].get_string());
+    EXPECT_EQ(ca["p2"]["q"].get_string().data(), ca["p2"]["q"].get_string_view().data());
+    EXPECT_EQ(string_view("hello"), ca["p2"]["q"].get_string_view());
+    EXPECT_EQ(3, ca["p1"][2].get_integer());
+    EXPECT_TRUE(ca.has_member("p2"));
+    EXPECT_THROW(ca["p3"], std::exception);
+
+    // 可修改的引用直接作用于文档
+    a["p1"].get_array().push_back(4);
+    a["p2"]["q"].get_string() += " world";
+    a.get_object().erase("p2");
+    EXPECT_EQ(4, a["p1"].size());
+    EXPECT_FALSE(a.has_member("p2"));
+}
+
+TEST(SimpleJsonStringView, Basic)
+{
+    std::string s = "hello world";
+    string_view v(s);
+    EXPECT_EQ(11, v.size());
+    EXPECT_EQ(s.data(), v.data());
+    EXPECT_EQ("hello world", v);
+    EXPECT_NE("hello", v);
+    EXPECT_TRUE(string_view("abc") < string_view("abd"));
+    EXPECT_TRUE(string_view("ab") < string_view("abc"));
+    EXPECT_EQ(0, string_view("").compare(string_view()));
+    EXPECT_EQ("world", string_view(s.data() + 6, 5).to_string());
+}
+
+TEST(TinyJsonDocument, Basic)
+{
+    document doc;
+    const char *text = R"({"p1" : [1, 2.5, "a long string value that does not fit in SSO"],
+                           "p2" : {"nested key that is also quite long" : true}})";
+
+    arena_json &root = parser::parse(text, doc);
+    EXPECT_EQ(&root, &doc.root());
+    EXPECT_EQ(2, root.size());
+    EXPECT_EQ(1, root["p1"][0].get_integer());
+    EXPECT_DOUBLE_EQ(2.5, root["p1"][1].get_double());
+    EXPECT_EQ("a long string value that does not fit in SSO", root["p1"][2].get_string_view());
+    EXPECT_TRUE(root["p2"]["nested key that is also quite long"].get_bool());
+    EXPECT_GT(doc.memory_usage(), 0);
+
+    // 所有容器和字符串都从文档的 arena 分配
+    arena *a = doc.get_allocator().get_arena();
+    EXPECT_EQ(a, root.get_allocator().get_arena());
+    EXPECT_EQ(a, root["p1"].get_allocator().get_arena());
+    EXPECT_EQ(a, root["p1"][2].get_allocator().get_arena());
+    EXPECT_EQ(a, root["p2"].get_allocator().get_arena());
+
+    // 新增的成员也会转移到文档的 arena 上
+    root.add_member("p3 with a key longer than fifteen bytes", "and a value longer than fifteen bytes");
+    root["p1"].add_element(arena_json::array_t{1, 2, 3});
+    EXPECT_EQ(a, root["p3 with a key longer than fifteen bytes"].get_allocator().get_arena());
+    EXPECT_EQ(a, root["p1"][3].get_allocator().get_arena());
+    EXPECT_EQ(3, root["p1"][3].size());
+
+    // 拷贝仍在同一个 arena 中，只能在文档存活期间使用
+    {
+        arena_json copy(root["p2"]);
+        EXPECT_EQ(a, copy.get_allocator().get_arena());
+        EXPECT_TRUE(copy == root["p2"]);
+    }
+
+    // 清空后可以复用同一个文档
+    doc.clear();
+    EXPECT_EQ(json_t::null, doc.root().type());
+    parser::parse("[1, [2, [3]]]", doc);
+    EXPECT_EQ(3, doc.root()[1][1][0].get_integer());
+
+    document moved(std::move(doc));
+    EXPECT_EQ(2, moved.root()[1][0].get_integer());
+
+    // 自身移动赋值不释放文档
+    document &self = moved;
+    moved = std::move(self);
+    EXPECT_EQ(2, moved.root()[1][0].get_integer());
+    EXPECT_THROW(parser::parse("[1, ", moved), std::exception);
+
+    // 被移动后的文档没有根节点，但可以安全地查询、清空并重新使用
+    EXPECT_THROW(doc.root(), std::logic_error);
+    EXPECT_EQ(0u, doc.memory_usage());
+    doc.clear();
+    EXPECT_EQ(json_t::null, doc.root().type());
+    parser::parse("[7]", doc);
+    EXPECT_EQ(7, doc.root()[0].get_integer());
+
+    // 直接赋值进来的堆上的值在文档销毁时释放；set_root() 把值转移到 arena 上
+    std::string longstr(64, 'x');
+    {
+        document assigned;
+        assigned.root() = arena_json(longstr);
+        assigned.root() = arena_json(arena_json::object_t{});
+        assigned.root().add_member("a", 1);
+        assigned.root()["a"] = arena_json(longstr);
+        EXPECT_EQ(longstr, assigned.root()["a"].get_string_view());
+
+        arena_json &r = assigned.set_root(arena_json(longstr));
+        EXPECT_EQ(assigned.get_allocator().get_arena(), r.get_allocator().get_arena());
+        EXPECT_EQ(longstr, assigned.root().get_string_view());
+        assigned.root() = arena_json(longstr);
+        assigned.clear();
+    }
+}
+
+TEST(SimpleJsonDump, Basic)
+{
+    json a = parser::parse(R"({"p1" : [1, -23, 4.5, true, null], "p2" : "abc", "p3" : {}})");
+    std::string expected = a.to_string();
+    EXPECT_EQ("{\"p1\" : [1,-23,4.5,true,null],\"p2\" : \"abc\",\"p3\" : {}}", expected);
+
+    // 精确的长度预估
+    EXPECT_EQ(expected.size(), a.dump_size());
+
+    // 追加到已有的缓冲区
+    std::string buf = "prefix:";
+    a.dump(buf);
+    EXPECT_EQ("prefix:" + expected, buf);
+
+    // 复用同一个缓冲区
+    buf.clear();
+    a["p1"].dump(buf);
+    EXPECT_EQ("[1,-23,4.5,true,null]", buf);
+
+    // 写入输出流
+    std::ostringstream os;
+    a.dump(os);
+    EXPECT_EQ(expected, os.str());
+
+    // 大于内部缓冲区的输出
+    json big(json_array{});
+    for (int i = 0; i < 1000; i++)
+        big.add_element("0123456789");
+    std::ostringstream os2;
+    big.dump(os2);
+    EXPECT_EQ(big.to_string(), os2.str());
+    EXPECT_EQ(big.dump_size(), os2.str().size());
+
+    // 整数边界值
+    EXPECT_EQ("-9223372036854775808", json(-9223372036854775807LL - 1).to_string());
+    EXPECT_EQ("0", json(0).to_string());
+    EXPECT_EQ("1e+300", json(1e300).to_string());
+
+    // 自定义 sink
+    counting_sink counter;
+    a.dump(counter);
+    EXPECT_EQ(expected.size(), counter.count());
+}
+
+// 记录所有事件的 SAX 处理器
+struct recording_sax : public json_sax
+{
+    std::vector<std::string> events;
+    size_t stop_after = static_cast<size_t>(-1);
+
+    bool record(const std::string &e)
+    {
+        events.push_back(e);
+        return events.size() < stop_after;
+    }
+
+    bool null() override { return record("null"); }
+    bool boolean(bool val) override { return record(val ? "true" : "false"); }
+    bool number_integer(long long val) override { return record("int:" + std::to_string(val)); }
+    bool number_double(double val) override { return record("double:" + std::to_string(val)); }
+    bool string(string_view val) override { return record("string:" + val.to_string()); }
+    bool start_object() override { return record("{"); }
+    bool key(string_view val) override { return record("key:" + val.to_string()); }
+    bool end_object() override { return record("}"); }
+    bool start_array() override { return record("["); }
+    bool end_array() override { return record("]"); }
+};
+
+TEST(TinyJsonSaxParsing, Basic)
+{
+    const char *doc = R"({"a" : [1, 2.5, "x\ty"], "bA" : {"c" : true, "d" : null}, "e" : []})";
+
+    recording_sax h;
+    EXPECT_TRUE(parser::sax_parse(doc, h));
+    std::vector<std::string> expected = {
+        "{", "key:a", "[", "int:1", "double:2.500000", "string:x\ty", "]",
+        "key:bA", "{", "key:c", "true", "key:d", "null", "}",
+        "key:e", "[", "]", "}"};
+    EXPECT_EQ(expected, h.events);
+
+    // 处理器返回 false 时立即停止
+    recording_sax h2;
+    h2.stop_after = 4;
+    EXPECT_FALSE(parser::sax_parse(std::string(doc), h2));
+    EXPECT_EQ(4, h2.events.size());
+    EXPECT_EQ("int:1", h2.events.back());
+
+    // 格式错误仍然抛出异常
+    recording_sax h3;
+    EXPECT_THROW(parser::sax_parse("{\"a\" : 1,}", h3), std::runtime_error);
+    EXPECT_THROW(parser::sax_parse("\"abc\"", h3), std::runtime_error);
+    EXPECT_THROW(parser::sax_parse("[1] 2", h3), std::runtime_error);
+
+    // 基础处理器忽略所有事件
+    json_sax ignore;
+    EXPECT_TRUE(parser::sax_parse(doc, ignore));
+
+    // 基于 dom_handler 的解析结果与 parse 一致
+    dom_handler<json> dom;
+    EXPECT_TRUE(parser::sax_parse(doc, dom));
+    EXPECT_TRUE(dom.result() == parser::parse(doc));
+    EXPECT_EQ("x\ty", dom.result()["a"][2].get_string());
+    EXPECT_EQ(true, dom.result()["bA"]["c"].get_bool());
+
+    // 重复的键名，后出现的值覆盖前面的值
+    json dup = parser::parse(R"({"k" : 1, "k" : [2]})");
+    EXPECT_EQ(1, dup.size());
+    EXPECT_EQ(2, dup["k"][0].get_integer());
+}
+
+TEST(TinyJsonPushParsing, Basic)
+{
+    const std::string doc = R"( {"a\"b" : [12345, -0.5e3, TRUE, null, "你😀 你好"],
+        "c" : {"d" : false, "e" : []}, "f" : {}} )";
+    json expected = parser::parse(doc);
+
+    // 一次性输入
+    push_parser p;
+    p.feed(doc);
+    EXPECT_TRUE(p.done());
+    EXPECT_TRUE(expected == p.finish());
+
+    // 在每个位置切分为两块，覆盖字符串、转义、数值和多字节序列中间的情况
+    for (size_t i = 0; i <= doc.size(); i++)
+    {
+        p.reset();
+        p.feed(doc.data(), i);
+        p.feed(doc.data() + i, doc.size() - i);
+        EXPECT_TRUE(expected == p.finish()) << "split at " << i;
+    }
+
+    // 逐字节输入
+    p.reset();
+    for (size_t i = 0; i < doc.size(); i++)
+        p.feed(doc.data() + i, 1);
+    EXPECT_TRUE(expected == p.finish());
+
+    // 数值位于最后一块的末尾，直到 finish 才能确定结束
+    p.reset();
+    p.feed("[1, 23");
+    EXPECT_FALSE(p.done());
+    p.feed("4]");
+    EXPECT_EQ(234, p.finish()[1].get_integer());
+
+    // 不完整或格式错误的输入
+    p.reset();
+    p.feed("{\"a\" : [1, 2");
+    EXPECT_THROW(p.finish(), std::runtime_error);
+    p.reset();
+    p.feed("[\"abc");
+    EXPECT_THROW(p.finish(), std::runtime_error);
+    p.reset();
+    EXPECT_THROW(p.finish(), std::runtime_error);
+    p.reset();
+    EXPECT_THROW(p.feed("[1,]"), std::runtime_error);
+    p.reset();
+    EXPECT_THROW(p.feed("{\"a\" : 1]"), std::runtime_error);
+    p.reset();
+    EXPECT_THROW(p.feed("[1] 2"), std::runtime_error);
+    p.reset();
+    EXPECT_THROW(p.feed("[tru"); p.feed("x]"), std::runtime_error);
+    p.reset();
+    p.feed("[\"\xE4\xBD");
+    EXPECT_THROW(p.feed("\"]"), std::runtime_error);
+
+    // 错误的种类和位置与一次性解析相同，位置从第一块的开头算起，不受切分位置影响
+    const char *bad[] = {"[1,\n2,\n3 4]", "{\"a\" :\n  tru]", "[1,\n  \"ab\\x\"]", "[-e]", "{\"a\" 1}",
+                         "[1] 2", "[1, }", "{\"a\" : [1}", "[\"abc", " \n x", "[1,\n 2", ""};
+    for (const char *text : bad)
+    {
+        std::string input(text);
+        parse_error expected_error;
+        parser::parse(input, expected_error);
+        ASSERT_TRUE(expected_error) << text;
+        for (size_t i = 0; i <= input.size(); i++)
+        {
+            p.reset();
+            try
+            {
+                p.feed(input.data(), i);
+                p.feed(input.data() + i, input.size() - i);
+                p.finish();
+                ADD_FAILURE() << "expected parse_exception for " << text;
+            }
+            catch (const parse_exception &e)
+            {
+                EXPECT_EQ(expected_error.code, e.error().code) << text << " split at " << i;
+                EXPECT_EQ(expected_error.offset, e.error().offset) << text << " split at " << i;
+                EXPECT_EQ(expected_error.line, e.error().line) << text << " split at " << i;
+                EXPECT_EQ(expected_error.column, e.error().column) << text << " split at " << i;
+                EXPECT_EQ(expected_error.to_string(), e.what());
+            }
+        }
+    }
+
+    // SAX 处理器中止解析
+    recording_sax h;
+    h.stop_after = 3;
+    sax_push_parser<recording_sax> sp(h);
+    EXPECT_FALSE(sp.feed("[1, [2, 3]]"));
+    EXPECT_FALSE(sp.finish());
+    EXPECT_EQ(3, h.events.size());
+}
+
+TEST(TinyJsonOrderedObject, Basic)
+{
+    using ordered_parser = basic_parser<ordered_json>;
+
+    // 保持插入顺序
+    ordered_json a = ordered_parser::parse(R"({"z" : 1, "a" : [2, {"y" : 3, "b" : 4}], "m" : null})");
+    EXPECT_EQ("{\"z\" : 1,\"a\" : [2,{\"y\" : 3,\"b\" : 4}],\"m\" : null}", a.to_string());
+    EXPECT_EQ(4, a["a"][1]["b"].get_integer());
+    EXPECT_TRUE(a.has_member("m"));
+    EXPECT_FALSE(a.has_member("x"));
+    EXPECT_THROW(a["x"], std::runtime_error);
+
+    // 重复的键名覆盖原来的值，位置不变
+    ordered_json dup = ordered_parser::parse(R"({"k" : 1, "j" : 2, "k" : 3})");
+    EXPECT_EQ("{\"k\" : 3,\"j\" : 2}", dup.to_string());
+
+    // 成员数量超过线性查找的上限后使用哈希索引
+    ordered_json big(ordered_json::object_t{});
+    for (int i = 0; i < 1000; i++)
+        big.add_member("key" + std::to_string(999 - i), i);
+    EXPECT_EQ(1000, big.size());
+    for (int i = 0; i < 1000; i++)
+    {
+        std::string key = "key" + std::to_string(999 - i);
+        ASSERT_TRUE(big.has_member(key));
+        EXPECT_EQ(i, big[key.c_str()].get_integer());
+    }
+    EXPECT_FALSE(big.has_member("key1000"));
+    big.add_member("key0", -1);
+    EXPECT_EQ(1000, big.size());
+    EXPECT_EQ(-1, big["key0"].get_integer());
+    EXPECT_EQ("key999", big.get_object().begin()->first);
+
+    // 相等比较与成员顺序无关
+    ordered_json b = ordered_parser::parse(R"({"m" : null, "a" : [2, {"b" : 4, "y" : 3}], "z" : 1})");
+    EXPECT_TRUE(a == b);
+    b["a"][1].add_member("y", 5);
+    EXPECT_FALSE(a == b);
+
+    // 拷贝与移动
+    ordered_json c(big);
+    EXPECT_TRUE(c == big);
+    ordered_json d(std::move(c));
+    EXPECT_EQ(-1, d["key0"].get_integer());
+
+    // 与 arena 分配器组合使用
+    arena ar;
+    using arena_ordered_json = basic_json<arena_allocator<char>, ordered_map>;
+    arena_ordered_json e = basic_parser<arena_ordered_json>::parse(
+        "{\"b\" : 1, \"a\" : \"text that does not fit in a short string\"}", arena_allocator<char>(&ar));
+    EXPECT_EQ(&ar, e.get_allocator().get_arena());
+    EXPECT_EQ("{\"b\" : 1,\"a\" : \"text that does not fit in a short string\"}", e.to_string());
+}
+
+TEST(TinyJsonInternedKeys, Basic)
+{
+    using interned_parser = basic_parser<interned_json>;
+
+    // 同一次解析中重复出现的键名只保存一份
+    interned_json a = interned_parser::parse(
+        R"([{"identifier" : 1, "description" : "a"}, {"identifier" : 2, "description" : "b"}, {"description" : "c"}])");
+    EXPECT_EQ("[{\"identifier\" : 1,\"description\" : \"a\"},{\"identifier\" : 2,\"description\" : \"b\"},"
+              "{\"description\" : \"c\"}]",
+              a.to_string());
+    const interned_json::object_t &first = a[0].get_object();
+    const interned_json::object_t &second = a[1].get_object();
+    EXPECT_EQ(first.pool(), second.pool());
+    EXPECT_EQ(first.pool(), a[2].get_object().pool());
+    EXPECT_EQ(2u, first.pool()->size());
+    EXPECT_EQ(std::strlen("identifier") + std::strlen("description"), first.pool()->bytes_used());
+    EXPECT_EQ(first.begin()->first.data(), second.begin()->first.data());
+    EXPECT_EQ(2, a[1]["identifier"].get_integer());
+    EXPECT_FALSE(a[2].has_member("identifier"));
+
+    // 通过池内键名查找时只比较指针
+    string_view key = first.pool()->intern("description");
+    EXPECT_EQ("b", a[1].get_object().find(key)->second.get_string());
+
+    // 拷贝共享原来的池，新增的键名也进入同一个池
+    interned_json b(a);
+    EXPECT_TRUE(a == b);
+    EXPECT_EQ(first.pool(), b[0].get_object().pool());
+    b[2].add_member("extra", true);
+    EXPECT_EQ(3u, first.pool()->size());
+    EXPECT_FALSE(a == b);
+
+    // 池由对象共同持有，原始文档销毁后拷贝仍然可用
+    a = interned_json();
+    EXPECT_EQ("{\"description\" : \"c\",\"extra\" : true}", b[2].to_string());
+
+    // 单独构造的对象各自创建池，被移动过的对象可以继续使用
+    interned_json::object_t members;
+    members["x"] = interned_json(1);
+    interned_json c(std::move(members));
+    members["y"] = interned_json(2);
+    EXPECT_EQ(1u, members.size());
+    EXPECT_EQ(1, c["x"].get_integer());
+
+    // 池中的字符块也从 arena 分配
+    arena ar;
+    using arena_interned_json = basic_json<arena_allocator<char>, interned_map>;
+    size_t before = ar.bytes_allocated();
+    arena_interned_json d = basic_parser<arena_interned_json>::parse(R"({"k" : [{"k" : 1}, {"k" : 2}]})",
+                                                                     arena_allocator<char>(&ar));
+    EXPECT_LT(before, ar.bytes_allocated());
+    EXPECT_EQ(1u, d.get_object().pool()->size());
+    EXPECT_EQ(2, d["k"][1]["k"].get_integer());
+
+    // 增量解析器的多次结果共享同一个池
+    basic_push_parser<interned_json> push;
+    push.feed(R"({"name" : 1})");
+    interned_json e = push.finish();
+    push.reset();
+    push.feed(R"({"name" : 2})");
+    interned_json f = push.finish();
+    EXPECT_EQ(e.get_object().begin()->first.data(), f.get_object().begin()->first.data());
+}
+
+TEST(TinyJsonLazyDocument, Basic)
+{
+    std::string text = R"({"skip" : {"deep" : [1, 2, {"x" : "]}"}], "s" : "{["},
+                         "items" : [10, -2.5, "a\"b", true, null, {"key" : "v"}],
+                         "name" : "lazy"})";
+    lazy_document doc(text);
+    EXPECT_EQ(12u, doc.bracket_count()); // 字符串中的括号不计入索引
+
+    lazy_value root = doc.root();
+    EXPECT_EQ(json_t::object, root.type());
+    EXPECT_EQ(3u, root.size());
+    EXPECT_EQ("lazy", root["name"].get_string());
+    EXPECT_TRUE(root.has_member("items"));
+    EXPECT_FALSE(root.has_member("deep"));
+    EXPECT_THROW(root["missing"], std::runtime_error);
+
+    // 重复的键名与 json 一致，取最后一个
+    const std::string dup = R"({"k" : 1, "j" : {"k" : 5}, "k" : 3})";
+    lazy_document dup_doc(dup);
+    EXPECT_EQ(3, dup_doc.root()["k"].get_integer());
+    EXPECT_EQ(parser::parse(dup)["k"].get_integer(), dup_doc.root()["k"].get_integer());
+
+    lazy_value items = root["items"];
+    EXPECT_EQ(6u, items.size());
+    EXPECT_EQ(json_t::number_integer, items[0].type());
+    EXPECT_EQ(10, items[0].get_integer());
+    EXPECT_EQ(json_t::number_double, items[1].type());
+    EXPECT_DOUBLE_EQ(-2.5, items[1].get_double());
+    EXPECT_EQ("a\"b", items[2].get_string());
+    EXPECT_TRUE(items[3].get_bool());
+    EXPECT_EQ(json_t::null, items[4].type());
+    EXPECT_EQ("v", items[5]["key"].get_string()); // 键名中的转义在比较前解码
+    EXPECT_THROW(items[6], std::runtime_error);
+    EXPECT_THROW(items.get_integer(), std::runtime_error);
+    EXPECT_THROW(items[0]["k"], std::runtime_error);
+
+    // 子树可以按需完整解析，结果与直接解析相同
+    EXPECT_EQ(R"({"x" : "]}"})", root["skip"]["deep"][2].raw());
+    EXPECT_TRUE(root["skip"].parse() == parser::parse(R"({"deep" : [1, 2, {"x" : "]}"}], "s" : "{["})"));
+    EXPECT_EQ("{[", root["skip"].parse<ordered_json>()["s"].get_string());
+
+    // 标量根节点
+    lazy_document scalar(" 42 ");
+    EXPECT_EQ(42, scalar.root().get_integer());
+
+    // 括号不配对、字符串未结束或根节点之后有多余内容时，构造即失败
+    EXPECT_THROW(lazy_document("{\"a\" : [1}"), std::runtime_error);
+    EXPECT_THROW(lazy_document("[\"abc]"), std::runtime_error);
+    EXPECT_THROW(lazy_document("[1] [2]"), std::runtime_error);
+    EXPECT_THROW(lazy_document("   "), std::runtime_error);
+
+    // 其余语法错误在访问到相应的值时才报告
+    lazy_document bad(R"({"ok" : 1, "bad" : 1x, "after" : 2})");
+    EXPECT_EQ(1, bad.root()["ok"].get_integer());
+    EXPECT_THROW(bad.root()["bad"].get_integer(), std::runtime_error);
+    EXPECT_EQ(2, bad.root()["after"].get_integer());
+    lazy_document trailing("[1,]");
+    EXPECT_EQ(1, trailing.root()[0].get_integer());
+    EXPECT_THROW(trailing.root().size(), std::runtime_error);
+
+    // 数值之后紧跟字符串时不会越过双引号，位置不会与括号索引失去同步
+    lazy_document drift("[1\"x,{\"]");
+    EXPECT_EQ("1", drift.root()[0].raw());
+    EXPECT_THROW(drift.root()[1].raw(), std::runtime_error);
+    EXPECT_THROW(drift.root()[1].parse(), std::runtime_error);
+    EXPECT_THROW(drift.root().size(), std::runtime_error);
+}
+
+TEST(TinyJsonTapeDocument, Basic)
+{
+    tape_document doc(R"({"id" : 7, "ratio" : 0.5, "name" : "tape", "tags" : ["a", "b"],
+                          "nested" : {"ok" : true, "no" : false, "none" : null, "big" : -9223372036854775807},
+                          "empty" : []})");
+    tape_value root = doc.root();
+    EXPECT_EQ(json_t::object, root.type());
+    EXPECT_EQ(6u, root.size());
+    EXPECT_EQ(7, root["id"].get_integer());
+    EXPECT_DOUBLE_EQ(0.5, root["ratio"].get_double());
+    EXPECT_EQ("tape", root["name"].get_string());
+    EXPECT_EQ("b", root["tags"][1].get_string_view());
+    EXPECT_EQ(2u, root["tags"].size());
+    EXPECT_TRUE(root["nested"]["ok"].get_bool());
+    EXPECT_FALSE(root["nested"]["no"].get_bool());
+    EXPECT_EQ(json_t::null, root["nested"]["none"].type());
+    EXPECT_EQ(-9223372036854775807LL, root["nested"]["big"].get_integer());
+    EXPECT_EQ(0u, root["empty"].size());
+    EXPECT_TRUE(root.has_member("empty"));
+    EXPECT_FALSE(root.has_member("ok")); // 不会匹配到子对象中的键名
+
+    // 重复的键名与 json 一致，取最后一个
+    const std::string dup = R"({"k" : 1, "j" : {"k" : 5}, "k" : 3})";
+    tape_document dup_doc(dup);
+    EXPECT_EQ(3, dup_doc.root()["k"].get_integer());
+    EXPECT_EQ(parser::parse(dup)["k"].get_integer(), dup_doc.root()["k"].get_integer());
+
+    // 访问方式与 json 一致，错误同样抛出异常
+    EXPECT_THROW(root["missing"], std::runtime_error);
+    EXPECT_THROW(root["tags"][2], std::runtime_error);
+    EXPECT_THROW(root["id"].get_string(), std::runtime_error);
+    EXPECT_THROW(root["id"].size(), std::runtime_error);
+
+    // 按文档顺序遍历，子树整体跳过
+    std::string keys;
+    for (tape_iterator it = root.begin(); it != root.end(); ++it)
+        keys += std::string(it.key().data(), it.key().size()) + ",";
+    EXPECT_EQ("id,ratio,name,tags,nested,empty,", keys);
+    std::string tags;
+    for (tape_iterator it = root["tags"].begin(); it != root["tags"].end(); ++it)
+        tags += (*it).get_string();
+    EXPECT_EQ("ab", tags);
+    EXPECT_TRUE(root["empty"].begin() == root["empty"].end());
+
+    // 含转义的字符串在构建时解码；格式错误在构建时报告
+    tape_document escaped(R"(["a\"bé", 1e3])");
+    EXPECT_EQ("a\"b\xC3\xA9", escaped.root()[0].get_string());
+    EXPECT_DOUBLE_EQ(1000.0, escaped.root()[1].get_double());
+    EXPECT_THROW(tape_document("[1, 2"), std::runtime_error);
+}
+
+TEST(TinyJsonParallelParsing, Basic)
+{
+    // 足够大的输入才会切分给多个线程；字符串中的逗号、括号和转义的换行不影响切分
+    std::string lines, array = "[";
+    for (int i = 0; i < 40000; i++)
+    {
+        std::string record = "{\"id\" : " + std::to_string(i) + ", \"text\" : \"a, b ] } [ \\\" \\n " +
+                             std::to_string(i) + "\", \"list\" : [" + std::to_string(i) + ", {\"x\" : null}]}";
+        lines += record + (i % 100 == 0 ? "\r\n\n   \n" : "\n");
+        array += (i ? "," : "") + record;
+    }
+    array += "]";
+    ASSERT_LT(size_t(1) << 21, lines.size());
+
+    std::vector<json> records = parallel_parser::parse_ndjson(lines, 4);
+    ASSERT_EQ(40000u, records.size());
+    std::vector<json> elems = parallel_parser::parse_array(array, 4);
+    ASSERT_EQ(40000u, elems.size());
+    for (int i = 0; i < 40000; i += 997)
+    {
+        EXPECT_EQ(i, records[i]["id"].get_integer());
+        EXPECT_EQ("a, b ] } [ \" \n " + std::to_string(i), records[i]["text"].get_string());
+        EXPECT_TRUE(records[i] == elems[i]);
+    }
+    EXPECT_TRUE(json(json_array(elems.begin(), elems.end())) == parser::parse(array));
+
+    // 逐条交付时保持输入顺序
+    long long expected = 0;
+    bool ordered = true;
+    parallel_parser::for_each_ndjson(lines.data(), lines.size(), [&](json &&v) {
+        ordered = ordered && v["id"].get_integer() == expected++;
+    });
+    EXPECT_TRUE(ordered);
+    EXPECT_EQ(40000, expected);
+
+    // 任一段出错或回调抛出异常时，异常在调用线程中重新抛出
+    std::string bad = lines;
+    bad.replace(bad.size() / 2, 1, "#");
+    EXPECT_THROW(parallel_parser::parse_ndjson(bad, 4), std::runtime_error);
+    EXPECT_THROW(parallel_parser::for_each_ndjson(lines.data(), lines.size(), [](json &&v) {
+        if (v["id"].get_integer() == 20000)
+            throw std::logic_error("stop");
+    }, 4), std::logic_error);
+
+    // 小输入、空数组、标量元素以及格式错误的数组
+    EXPECT_EQ(3u, parallel_parser::parse_ndjson("1\n\"two\"\n[3]").size());
+    EXPECT_EQ(0u, parallel_parser::parse_array(" [ ] ").size());
+    EXPECT_EQ(2, parallel_parser::parse_array("[1, 2]")[1].get_integer());
+    EXPECT_THROW(parallel_parser::parse_array("[1, ]"), std::runtime_error);
+    EXPECT_THROW(parallel_parser::parse_array("[1, 2"), std::runtime_error);
+    EXPECT_THROW(parallel_parser::parse_array("[1] 2"), std::runtime_error);
+    EXPECT_THROW(parallel_parser::parse_array("{}"), std::runtime_error);
+}
+
+TEST(TinyJsonNdjson, Basic)
+{
+    // 每行可以有多个值，空行跳过；格式错误的记录单独报告，不影响后续记录
+    std::string input = "{\"a\" : 1}\r\n\n  [1, 2] \"s\" 3\n{\"b\" : }\n   \nnull\n{\"c\" : [true]}";
+    ndjson_reader reader(input);
+    std::vector<std::string> out;
+    std::vector<size_t> lines;
+    while (reader.next())
+    {
+        out.push_back(reader.ok() ? reader.value().to_string() : "error");
+        lines.push_back(reader.line());
+    }
+    std::vector<std::string> expected = {"{\"a\" : 1}", "[1,2]", "\"s\"", "3", "error", "null", "{\"c\" : [true]}"};
+    EXPECT_EQ(expected, out);
+    EXPECT_EQ((std::vector<size_t>{1, 3, 3, 3, 4, 6, 7}), lines);
+    EXPECT_FALSE(reader.next());
+
+    // 从输入流读取，错误信息与记录对应
+    std::istringstream in("[1]\n{\"x\" : tru}\n{\"y\" : 2}\n");
+    ndjson_reader stream_reader(in);
+    ASSERT_TRUE(stream_reader.next());
+    EXPECT_TRUE(stream_reader.ok());
+    ASSERT_TRUE(stream_reader.next());
+    EXPECT_FALSE(stream_reader.ok());
+    EXPECT_FALSE(stream_reader.error().empty());
+    EXPECT_EQ(json_t::null, stream_reader.value().type());
+    ASSERT_TRUE(stream_reader.next());
+    EXPECT_TRUE(stream_reader.ok());
+    EXPECT_TRUE(stream_reader.error().empty());
+    EXPECT_EQ(2, stream_reader.value()["y"].get_integer());
+    EXPECT_FALSE(stream_reader.next());
+
+    // 写入器每条记录一行，读回后内容相同
+    std::ostringstream os;
+    {
+        ndjson_writer writer(os);
+        writer.write(parser::parse("{\"k\" : [1, 2.5, null]}"));
+        writer.write(json("text"));
+        writer.write(json(7));
+        EXPECT_EQ(3u, writer.count());
+    }
+    EXPECT_EQ("{\"k\" : [1,2.5,null]}\n\"text\"\n7\n", os.str());
+
+    std::string buffer;
+    basic_ndjson_writer<string_sink<>> string_writer(buffer);
+    string_writer.write(parser::parse("[{}, []]"));
+    EXPECT_EQ("[{},[]]\n", buffer);
+    ndjson_reader round_trip(buffer);
+    ASSERT_TRUE(round_trip.next());
+    EXPECT_TRUE(round_trip.value() == parser::parse("[{}, []]"));
+}
+
+TEST(TinyJsonFileParsing, Basic)
+{
+    std::string path = testing::TempDir() + "tinyjson_parse_file.json";
+    std::string content = "{\"name\" : \"mapped\", \"values\" : [1, 2, 3]}\n";
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << content;
+    }
+
+    json doc = parser::parse_file(path);
+    EXPECT_EQ("mapped", doc["name"].get_string());
+    EXPECT_EQ(3, doc["values"][2].get_integer());
+
+    // 映射的数据可以直接交给按需解析的文档，字符串不会被复制
+    mapped_file file(path);
+    ASSERT_EQ(content.size(), file.size());
+    EXPECT_EQ(0, std::memcmp(content.data(), file.data(), file.size()));
+    lazy_document lazy(file.data(), file.size());
+    EXPECT_EQ("mapped", lazy.root()["name"].get_string());
+    mapped_file moved(std::move(file));
+    EXPECT_EQ(0u, file.size());
+    EXPECT_EQ('{', moved.data()[0]);
+
+    // 借用方式：直接在私有映射上原位解析，字符串值指向映射，文件本身不被修改
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << "{\"plain\" : \"in the mapping\", \"escaped\" : \"a\\nb\\u00e9\"}";
+    }
+    parser::mapped_json mapped = parser::parse_file(path, borrow);
+    const json &plain = mapped.root["plain"];
+    EXPECT_TRUE(plain.is_borrowed());
+    EXPECT_TRUE(plain.get_string_view().data() >= mapped.file.data() &&
+                plain.get_string_view().data() < mapped.file.data() + mapped.file.size());
+    EXPECT_EQ("a\nb\xC3\xA9", mapped.root["escaped"].get_string_view());
+    parser::mapped_json kept = std::move(mapped); // 整体移动后借用仍然有效
+    EXPECT_EQ("in the mapping", kept.root["plain"].get_string_view());
+    EXPECT_TRUE(kept.root == parser::parse_file(path)); // 与复制方式的解析结果相同
+    std::ifstream on_disk(path, std::ios::binary);
+    std::string disk((std::istreambuf_iterator<char>(on_disk)), std::istreambuf_iterator<char>());
+    EXPECT_NE(std::string::npos, disk.find("a\\nb\\u00e9")); // 原位解码只改写了进程内的副本
+
+    mapped_file writable(path);
+    json insitu = parser::parse_insitu(writable);
+    EXPECT_TRUE(insitu["plain"].is_borrowed());
+    EXPECT_EQ("in the mapping", insitu["plain"].get_string_view());
+
+    // 空文件、不存在的文件
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    }
+    EXPECT_EQ(0u, mapped_file(path).size());
+    EXPECT_THROW(parser::parse_file(path), std::runtime_error);
+    std::remove(path.c_str());
+    EXPECT_THROW(mapped_file{path}, std::runtime_error);
+}
+
+TEST(TinyJsonInsituParsing, Basic)
+{
+    std::string buffer = R"({"plain" : "value", "escaped" : "a\"b\\cé😀", "list" : ["x", "", "\n"]})";
+    json doc = parser::parse_insitu(buffer);
+
+    // 字符串值指向缓冲区，转义在原位解码
+    const json &plain = doc["plain"];
+    EXPECT_TRUE(plain.is_borrowed());
+    EXPECT_EQ("value", plain.get_string_view());
+    EXPECT_TRUE(plain.get_string_view().data() >= buffer.data() &&
+                plain.get_string_view().data() < buffer.data() + buffer.size());
+    EXPECT_TRUE(doc["escaped"].is_borrowed());
+    EXPECT_EQ("a\"b\\c\xC3\xA9\xF0\x9F\x98\x80", doc["escaped"].get_string_view());
+    EXPECT_EQ("", doc["list"][1].get_string_view());
+    EXPECT_EQ("\n", doc["list"][2].get_string_view());
+    EXPECT_EQ(sizeof(json), sizeof(long long) * 2);
+
+    // 只读访问不会修改借用的值：const 的 get_string() 对借用的字符串报告错误
+    EXPECT_THROW(plain.get_string(), std::logic_error);
+    EXPECT_TRUE(plain.is_borrowed());
+
+    // 与普通解析的结果相等，序列化结果相同
+    json copy_parsed = parser::parse(R"({"plain" : "value", "escaped" : "a\"b\\cé😀", "list" : ["x", "", "\n"]})");
+    EXPECT_TRUE(doc == copy_parsed);
+    EXPECT_EQ(copy_parsed.to_string(), doc.to_string());
+
+    // 拷贝仍然借用同一个缓冲区；需要可修改的字符串时才复制
+    json copied(doc);
+    EXPECT_EQ(plain.get_string_view().data(), copied["plain"].get_string_view().data());
+    copied["plain"].get_string() += "!";
+    EXPECT_FALSE(copied["plain"].is_borrowed());
+    EXPECT_EQ("value!", copied["plain"].get_string());
+    EXPECT_EQ("value", plain.get_string_view());
+
+    // 借用的值可以直接放入其他容器
+    json holder(json_object{});
+    holder.add_member("moved", std::move(doc["list"][0]));
+    EXPECT_TRUE(holder["moved"].is_borrowed());
+    EXPECT_EQ("x", static_cast<std::string>(holder["moved"]));
+
+    // 只有借用构造的值才不持有字符串
+    json borrowed(borrow, string_view("abc", 2));
+    EXPECT_EQ("ab", borrowed.get_string());
+    EXPECT_FALSE(borrowed.is_borrowed());
+    EXPECT_FALSE(json("abc").is_borrowed());
+}
+
+namespace binding_test
+{
+    struct address
+    {
+        std::string city;
+        int zip = 0;
+    };
+    TINYJSON_FIELDS(address, city, zip)
+
+    struct person
+    {
+        std::string name;
+        unsigned age = 0;
+        double score = 0;
+        bool active = false;
+        std::vector<std::string> tags;
+        std::vector<address> addresses;
+        std::map<std::string, int> counters;
+        json extra;
+    };
+    TINYJSON_FIELDS(person, name, age, score, active, tags, addresses, counters, extra)
+} // namespace binding_test
+
+TEST(TinyJsonStructBinding, Basic)
+{
+    using binding_test::address;
+    using binding_test::person;
+    static_assert(has_json_fields<person>::value && !has_json_fields<std::string>::value, "field detection");
+
+    // 未声明的成员被跳过，整数可以读入浮点字段
+    std::string input = R"({"name" : "Ann \u0041", "unknown" : {"deep" : [1, {"x" : null}]}, "age" : 42, "score" : 7,
+        "active" : true, "tags" : ["a", "b"], "addresses" : [{"city" : "Paris", "zip" : 75001}, {"zip" : 1}],
+        "counters" : {"x" : 1, "y" : -2}, "extra" : {"any" : [true, 1.5]}})";
+    person p = deserialize<person>(input);
+    EXPECT_EQ("Ann A", p.name);
+    EXPECT_EQ(42u, p.age);
+    EXPECT_DOUBLE_EQ(7.0, p.score);
+    EXPECT_TRUE(p.active);
+    ASSERT_EQ(2u, p.tags.size());
+    EXPECT_EQ("b", p.tags[1]);
+    ASSERT_EQ(2u, p.addresses.size());
+    EXPECT_EQ("Paris", p.addresses[0].city);
+    EXPECT_EQ(75001, p.addresses[0].zip);
+    EXPECT_EQ("", p.addresses[1].city); // 缺少的字段保持默认值
+    EXPECT_EQ(-2, p.counters["y"]);
+    EXPECT_DOUBLE_EQ(1.5, p.extra["any"][1].get_double());
+
+    // 输出格式与 dump 一致，结果可以被 DOM 解析器和绑定读回
+    std::string out = serialize(p);
+    ordered_json dom = basic_parser<ordered_json>::parse(out);
+    EXPECT_EQ(dom.to_string(), out);
+    EXPECT_EQ("Paris", dom["addresses"][0]["city"].get_string());
+    EXPECT_EQ(42, dom["age"].get_integer());
+    EXPECT_EQ(out, serialize(deserialize<person>(out)));
+    address lyon;
+    lyon.city = "Lyon";
+    lyon.zip = 69000;
+    EXPECT_EQ(R"({"city" : "Lyon","zip" : 69000})", serialize(lyon));
+
+    // 根可以是任意值
+    EXPECT_EQ(3, deserialize<int>(" 3 "));
+    EXPECT_EQ("[1,2]", serialize(std::vector<int>{1, 2}));
+
+    // 类型不符、越界和格式错误抛出异常
+    EXPECT_THROW(deserialize<person>(R"({"age" : "old"})"), std::runtime_error);
+    EXPECT_THROW(deserialize<person>(R"({"age" : -1})"), std::runtime_error);
+    EXPECT_THROW(deserialize<address>(R"({"zip" : 1.5})"), std::runtime_error);
+    EXPECT_THROW(deserialize<person>(R"({"name" : "x")"), std::runtime_error);
+    EXPECT_THROW(deserialize<person>(R"({"name" : "x"} 1)"), std::runtime_error);
+    EXPECT_THROW(deserialize<std::vector<int>>("[1 2]"), std::runtime_error);
+    EXPECT_THROW(deserialize<signed char>("200"), std::runtime_error);
+}
+
+TEST(TinyJsonPathQuery, Basic)
+{
+    const std::string text = R"({"store" : {"book" : [{"title" : "A", "price" : 8}, {"title" : "B", "price" : 12.5},
+        {"title" : "C", "tags" : ["x"]}], "a/b" : 1, "m~n" : 2, "0" : "zero"}, "list" : [10, 20, 30]})";
+    json doc = parser::parse(text);
+
+    // JSON Pointer：找不到时返回空指针而不抛出异常
+    json_pointer title("/store/book/1/title");
+    ASSERT_NE(nullptr, title.find(doc));
+    EXPECT_EQ("B", title.find(doc)->get_string());
+    EXPECT_EQ(&doc, json_pointer("").find(doc));
+    EXPECT_EQ(1, json_pointer("/store/a~1b").find(doc)->get_integer());
+    EXPECT_EQ(2, json_pointer("/store/m~0n").find(doc)->get_integer());
+    EXPECT_EQ("zero", json_pointer("/store/0").find(doc)->get_string()); // 对象中的 "0" 是键名
+    EXPECT_EQ(nullptr, json_pointer("/store/book/3").find(doc));
+    EXPECT_EQ(nullptr, json_pointer("/store/book/01").find(doc));
+    EXPECT_EQ(nullptr, json_pointer("/store/book/-").find(doc));
+    EXPECT_EQ(nullptr, json_pointer("/store/missing/x").find(doc));
+    EXPECT_EQ(nullptr, json_pointer("/list/0/x").find(doc));
+    *json_pointer("/list/2").find(doc) = json(31);
+    EXPECT_EQ(31, doc["list"][2].get_integer());
+    EXPECT_THROW(json_pointer("store"), std::runtime_error);
+    EXPECT_THROW(json_pointer("/a~2"), std::runtime_error);
+
+    // 同一个编译后的路径可以用于 tape 和按需解析的文档
+    tape_document tape(text);
+    tape_value tv = tape.root();
+    ASSERT_TRUE(title.find(tape.root(), tv));
+    EXPECT_EQ("B", tv.get_string());
+    EXPECT_FALSE(json_pointer("/store/book/5").find(tape.root(), tv));
+    lazy_document lazy(text);
+    lazy_value lv = lazy.root();
+    ASSERT_TRUE(title.find(lazy.root(), lv));
+    EXPECT_EQ("B", lv.get_string());
+    ASSERT_TRUE(json_pointer("/store/book/2/tags/0").find(lazy.root(), lv));
+    EXPECT_EQ("x", lv.get_string());
+    EXPECT_FALSE(json_pointer("/store/book/2/price").find(lazy.root(), lv));
+
+    // JSONPath 子集
+    json_path titles("$.store.book[*].title");
+    auto found = titles.select(doc);
+    ASSERT_EQ(3u, found.size());
+    EXPECT_EQ("A", found[0]->get_string());
+    EXPECT_EQ("C", found[2]->get_string());
+    EXPECT_EQ(2u, json_path("$.store.book[*].price").select(doc).size());
+    EXPECT_EQ(8, json_path("$['store'][\"book\"][0].price").select(doc)[0]->get_integer());
+    EXPECT_EQ(3u, json_path("$.list.*").select(doc).size());
+    EXPECT_EQ(0u, json_path("$.list.x").select(doc).size());
+    EXPECT_EQ(1u, json_path("$").select(doc).size());
+    std::string joined;
+    titles.for_each(tape.root(), [&](const tape_value &v) { joined += v.get_string(); });
+    titles.for_each(lazy.root(), [&](const lazy_value &v) { joined += v.get_string(); });
+    EXPECT_EQ("ABCABC", joined);
+    EXPECT_THROW(json_path("store"), std::runtime_error);
+    EXPECT_THROW(json_path("$.store["), std::runtime_error);
+    EXPECT_THROW(json_path("$.store[-1]"), std::runtime_error);
+    EXPECT_THROW(json_path("$..book"), std::runtime_error);
+
+    // 流式求值只构建匹配的值
+    json value;
+    ASSERT_TRUE(json_pointer("/store/book/2").extract(text, value));
+    EXPECT_EQ("x", value["tags"][0].get_string());
+    EXPECT_FALSE(json_pointer("/store/nothing").extract(text, value));
+    ASSERT_TRUE(json_pointer("").extract(text, value));
+    EXPECT_EQ(30, value["list"][2].get_integer());
+    std::vector<std::string> streamed;
+    EXPECT_EQ(3u, titles.extract(text, [&](json &v) { streamed.push_back(v.get_string()); }));
+    ASSERT_EQ(3u, streamed.size());
+    EXPECT_EQ("C", streamed[2]);
+    double total = 0;
+    json_path("$.store.book[*].price").extract(text, [&](json &v) {
+        total += v.type() == json_t::number_integer ? v.get_integer() : v.get_double();
+    });
+    EXPECT_DOUBLE_EQ(20.5, total);
+    EXPECT_EQ(3u, json_path("$.list[*]").extract(text, [](json &) {}));
+    EXPECT_THROW(titles.extract(std::string(R"({"store" : {"book" : [}})"), [](json &) {}), std::runtime_error);
+}
+
+TEST(TinyJsonErrorCodes, Basic)
+{
+    // 不抛出异常的解析报告错误的种类和位置
+    parse_error err;
+    json ok = parser::parse(R"({"a" : [1, 2]})", err);
+    EXPECT_FALSE(err);
+    EXPECT_EQ(2, ok["a"][1].get_integer());
+
+    json bad = parser::parse("{\"a\" : 1,\n  \"b\" 2}", err);
+    EXPECT_TRUE(err);
+    EXPECT_EQ(json_t::null, bad.type());
+    EXPECT_EQ(parse_errc::invalid_object, err.code);
+    EXPECT_EQ(16u, err.offset);
+    EXPECT_EQ(2u, err.line);
+    EXPECT_EQ(7u, err.column);
+    EXPECT_EQ("invalid object format at line 2, column 7", err.to_string());
+
+    struct error_case
+    {
+        const char *input;
+        parse_errc code;
+        size_t offset;
+    };
+    const error_case cases[] = {
+        {"", parse_errc::unexpected_end, 0},
+        {"  1", parse_errc::invalid_root, 2},
+        {"[1] x", parse_errc::trailing_characters, 4},
+        {"[1, 2", parse_errc::unexpected_end, 5},
+        {"[1 2]", parse_errc::invalid_array, 3},
+        {"[tru]", parse_errc::invalid_literal, 1},
+        {"[1, @]", parse_errc::unexpected_character, 4},
+        {"[-]", parse_errc::invalid_number, 1},
+        {"[1e999]", parse_errc::number_out_of_range, 1},
+        {R"(["a\q"])", parse_errc::invalid_escape, 4},
+        {R"(["\u12x4"])", parse_errc::invalid_unicode_escape, 6},
+        {R"(["\udc00"])", parse_errc::invalid_unicode_escape, 8},
+        {"[\"\xC3\"]", parse_errc::invalid_utf8, 2},
+        {R"({"a" : "b)", parse_errc::unexpected_end, 9},
+        {R"({1 : 2})", parse_errc::invalid_object, 1},
+    };
+    for (const error_case &c : cases)
+    {
+        parser::parse(c.input, err);
+        EXPECT_EQ(c.code, err.code) << c.input;
+        EXPECT_EQ(c.offset, err.offset) << c.input;
+    }
+
+    // SAX 接口：handler 中止时 error 保持为空
+    struct stop_at_first : json_sax
+    {
+        bool number_integer(long long) override { return false; }
+    } stop;
+    EXPECT_FALSE(parser::sax_parse(std::string("[1, 2]"), stop, err));
+    EXPECT_FALSE(err);
+    json_sax all;
+    EXPECT_FALSE(parser::sax_parse(std::string("[1, }"), all, err));
+    EXPECT_EQ(parse_errc::unexpected_character, err.code);
+
+    // 抛出的异常携带同样的信息
+    try
+    {
+        parser::parse("[1,\n2,\n3 4]");
+        FAIL() << "expected parse_exception";
+    }
+    catch (const parse_exception &e)
+    {
+        EXPECT_EQ(parse_errc::invalid_array, e.error().code);
+        EXPECT_EQ(3u, e.error().line);
+        EXPECT_EQ(3u, e.error().column);
+    }
+    EXPECT_THROW(parser::parse("[1 2]"), std::runtime_error);
+
+    // 不抛出异常的访问函数
+    json doc = parser::parse(R"({"s" : "text", "i" : 3, "d" : 1.5, "b" : true, "list" : [10]})");
+    ASSERT_NE(nullptr, doc.find("s"));
+    EXPECT_EQ(nullptr, doc.find("missing"));
+    EXPECT_EQ(nullptr, doc.find(0));
+    EXPECT_EQ(10, doc.find("list")->find(0)->get_integer());
+    EXPECT_EQ(nullptr, doc.find("list")->find(1));
+    EXPECT_EQ(nullptr, doc.find("i")->find("x"));
+    string_view sv;
+    long long i = 0;
+    double d = 0;
+    bool b = false;
+    EXPECT_TRUE(doc.find("s")->try_get_string(sv));
+    EXPECT_EQ("text", sv);
+    EXPECT_TRUE(doc.find("i")->try_get_integer(i));
+    EXPECT_EQ(3, i);
+    EXPECT_TRUE(doc.find("d")->try_get_double(d));
+    EXPECT_DOUBLE_EQ(1.5, d);
+    EXPECT_TRUE(doc.find("b")->try_get_bool(b));
+    EXPECT_TRUE(b);
+    EXPECT_FALSE(doc.find("s")->try_get_integer(i));
+    EXPECT_EQ(3, i);
+    EXPECT_FALSE(doc.find("i")->try_get_string(sv));
+    EXPECT_FALSE(doc.try_get_bool(b));
+}
+
+TEST(TinyJsonNestingDepth, Basic)
+{
+    // 超过 TINYJSON_MAX_DEPTH 的嵌套报告为错误，而不是耗尽栈空间
+    const std::string deep(200000, '[');
+    parse_error err;
+    parser::parse(deep, err);
+    EXPECT_EQ(parse_errc::depth_exceeded, err.code);
+    EXPECT_EQ(size_t(TINYJSON_MAX_DEPTH), err.offset); // 指向第一个超出限制的 '['
+    EXPECT_THROW(parser::parse(deep), parse_exception);
+    EXPECT_THROW(parser::parse(std::string(100000, '{')), parse_exception);
+    EXPECT_THROW(tape_document{deep}, parse_exception);
+    std::istringstream stream(deep);
+    EXPECT_THROW(parser::parse(stream), std::runtime_error);
+
+    // 恰好达到上限的文档仍然可以解析
+    const std::string limit = std::string(TINYJSON_MAX_DEPTH, '[') + std::string(TINYJSON_MAX_DEPTH, ']');
+    json at_limit = parser::parse(limit, err);
+    EXPECT_FALSE(err);
+    EXPECT_EQ(1u, at_limit.size());
+    std::istringstream limit_stream(limit);
+    EXPECT_TRUE(at_limit == parser::parse(limit_stream));
+    EXPECT_EQ(1u, tape_document(limit).root().size());
+    EXPECT_THROW(parser::parse("[" + limit + "]"), parse_exception);
+
+    // 增量解析同样限制深度，位置从第一块的开头算起
+    push_parser p;
+    try
+    {
+        for (size_t i = 0; i < deep.size(); i += 4096)
+            p.feed(deep.data() + i, std::min<size_t>(4096, deep.size() - i));
+        FAIL() << "expected parse_exception";
+    }
+    catch (const parse_exception &e)
+    {
+        EXPECT_EQ(parse_errc::depth_exceeded, e.error().code);
+        EXPECT_EQ(size_t(TINYJSON_MAX_DEPTH), e.error().offset);
+    }
+
+    // 二进制格式：嵌套的单元素数组和 CBOR 标签
+    const std::string mp(200000, '\x91'), cb_array(200000, '\x81'), cb_tags(200000, '\xc6');
+    msgpack::decode(mp.data(), mp.size(), err);
+    EXPECT_EQ(parse_errc::depth_exceeded, err.code);
+    cbor::decode(cb_array.data(), cb_array.size(), err);
+    EXPECT_EQ(parse_errc::depth_exceeded, err.code);
+    cbor::decode(cb_tags.data(), cb_tags.size(), err);
+    EXPECT_EQ(parse_errc::depth_exceeded, err.code);
+}
+
+TEST(TinyJsonBinaryFormats, Basic)
+{
+    json doc = parser::parse(R"({"name" : "tiny", "n" : [0, 127, 128, -1, -33, 65536, -2147483649, 1.5], "ok" : true, "none" : null})");
+
+    // 往返编码
+    std::string mp = msgpack::encode(doc);
+    std::string cb = cbor::encode(doc);
+    EXPECT_TRUE(doc == msgpack::decode(mp));
+    EXPECT_TRUE(doc == cbor::decode(cb));
+    std::string text;
+    doc.dump(text);
+    EXPECT_LT(mp.size(), text.size());
+
+    // 已知的字节序列
+    EXPECT_EQ(std::string("\x93\x01\xcc\x80\xd0\xdf", 6), msgpack::encode(parser::parse("[1, 128, -33]")));
+    EXPECT_EQ(std::string("\x83\x01\x18\x64\x38\x63", 6), cbor::encode(parser::parse("[1, 100, -100]")));
+    EXPECT_EQ(std::string("\xa1\x61\x61\xf5", 4), cbor::encode(parser::parse(R"({"a" : true})")));
+
+    // 借用模式下字符串值直接指向输入
+    std::string bytes = msgpack::encode(parser::parse(R"(["hello"])"));
+    json borrowed = msgpack::decode(bytes.data(), bytes.size(), borrow);
+    EXPECT_EQ(bytes.data() + 2, borrowed[0].get_string_view().data());
+
+    // CBOR 的不定长度字符串被拼接后复制，浮点数支持半精度
+    std::string chunked("\x82\x7f\x62he\x63llo\xff\xf9\x3e\x00", 13);
+    json parts = cbor::decode(chunked.data(), chunked.size(), borrow);
+    EXPECT_EQ("hello", parts[0].get_string());
+    EXPECT_DOUBLE_EQ(1.5, parts[1].get_double());
+
+    // 通过 SAX 把 JSON 文本直接转换为 CBOR（不定长度容器）
+    std::string streamed;
+    string_sink<std::string> sink(streamed);
+    basic_cbor_writer<string_sink<std::string>> writer(sink);
+    parser::sax_parse(std::string(R"({"a" : [1, "x"]})"), writer);
+    EXPECT_EQ(std::string("\xbf\x61\x61\x9f\x01\x61x\xff\xff", 9), streamed);
+    EXPECT_TRUE(parser::parse(R"({"a" : [1, "x"]})") == cbor::decode(streamed));
+
+    // 错误报告
+    parse_error err;
+    json bad = msgpack::decode("\x92\x01", 2, err);
+    EXPECT_EQ(parse_errc::unexpected_end, err.code);
+    EXPECT_EQ(json_t::null, bad.type());
+    msgpack::decode("\x81\x01\x02", 3, err);
+    EXPECT_EQ(parse_errc::invalid_object, err.code);
+    EXPECT_EQ(1u, err.offset);
+    cbor::decode("\x01\x02", 2, err);
+    EXPECT_EQ(parse_errc::trailing_characters, err.code);
+    cbor::decode("\x78\x05" "ab", 4, err);
+    EXPECT_EQ(parse_errc::unexpected_end, err.code);
+    EXPECT_THROW(msgpack::decode(std::string("\xd4\x01\x00", 3)), parse_exception);
+}
+
+#if defined(TINYJSON_INSTRUMENT)
+namespace instrument_test
+{
+    struct hook_counts
+    {
+        size_t allocated = 0;
+        size_t freed = 0;
+    };
+
+    void *count_allocate(size_t size, void *context)
+    {
+        static_cast<hook_counts *>(context)->allocated += size;
+        return ::operator new(size);
+    }
+
+    void count_deallocate(void *p, size_t size, void *context)
+    {
+        static_cast<hook_counts *>(context)->freed += size;
+        ::operator delete(p);
+    }
+}
+
+TEST(TinyJsonInstrument, Basic)
+{
+    // 解析统计
+    instrument::reset();
+    std::string text = R"({"a" : [1, 2, {"b" : "x"}], "c" : "yy"})";
+    json doc = parser::parse(text);
+    json_stats s = instrument::stats();
+    EXPECT_EQ(text.size(), s.bytes_parsed);
+    EXPECT_EQ(7u, s.nodes_created);
+    EXPECT_EQ(3u, s.max_depth);
+    EXPECT_EQ(2u, s.strings_allocated);
+    EXPECT_EQ(5u, s.allocations); // 两个字符串、一个数组和两个对象
+    EXPECT_EQ(0u, s.exceptions_thrown);
+
+    std::string out;
+    doc.dump(out);
+    EXPECT_GT(instrument::stats().serialize_ns, 0u);
+
+    parse_error err;
+    parser::parse("[1, ", err);
+    EXPECT_EQ(0u, instrument::stats().exceptions_thrown);
+    EXPECT_THROW(parser::parse("[1, "), parse_exception);
+    EXPECT_THROW(doc["c"].get_integer(), std::runtime_error);
+    EXPECT_EQ(2u, instrument::stats().exceptions_thrown);
+
+    // 分配钩子接管默认分配器的节点，分配和释放成对出现
+    instrument_test::hook_counts counts;
+    instrument::set_allocation_hooks(allocation_hooks{instrument_test::count_allocate, instrument_test::count_deallocate, &counts});
+    {
+        json copy(doc);
+        json str("hooked");
+        EXPECT_GT(counts.allocated, 0u);
+    }
+    instrument::set_allocation_hooks(allocation_hooks{nullptr, nullptr, nullptr});
+    EXPECT_EQ(counts.allocated, counts.freed);
+
+    // 其他分配器不经过钩子，只统计次数；arena 文档整体释放，不逐个释放节点
+    instrument::reset();
+    document arena;
+    parser::parse(text.data(), text.size(), arena);
+    EXPECT_EQ(5u, instrument::stats().allocations);
+
+#if !defined(TINYJSON_NO_THREADS)
+    // 并行解析的工作线程同样计入解析的字节数和时间（块之间的分隔符不计入）
+    std::string elems = "[";
+    for (int i = 0; i < 20000; i++)
+        elems += (i ? ",{\"v\" : " : "{\"v\" : ") + std::to_string(i) + "}";
+    elems += "]";
+    instrument::reset();
+    std::vector<json> parsed = parallel_parser::parse_array(elems, 4);
+    EXPECT_EQ(20000u, parsed.size());
+    s = instrument::stats();
+    EXPECT_EQ(40000u, s.nodes_created);
+    EXPECT_GT(s.bytes_parsed, elems.size() - 8);
+    EXPECT_LE(s.bytes_parsed, elems.size());
+    EXPECT_GT(s.parse_ns, 0u);
+#endif
+}
+#endif
+
+namespace pool_test
+{
+    // 绑定到具体内存池、不能默认构造的分配器
+    struct pool
+    {
+        size_t allocations;
+        size_t deallocations;
+    };
+
+    template <class T>
+    struct pool_allocator
+    {
+        using value_type = T;
+
+        explicit pool_allocator(pool *p) : owner(p) {}
+        template <class U>
+        pool_allocator(const pool_allocator<U> &other) : owner(other.owner) {}
+
+        T *allocate(size_t n)
+        {
+            owner->allocations++;
+            return static_cast<T *>(::operator new(n * sizeof(T)));
+        }
+
+        void deallocate(T *p, size_t)
+        {
+            owner->deallocations++;
+            ::operator delete(p);
+        }
+
+        template <class U>
+        bool operator==(const pool_allocator<U> &other) const { return owner == other.owner; }
+        template <class U>
+        bool operator!=(const pool_allocator<U> &other) const { return owner != other.owner; }
+
+        pool *owner;
+    };
+
+    using pool_json = basic_json<pool_allocator<char>>;
+
+    // 树中所有持有数据的节点是否都来自 p
+    bool all_in(const pool_json &j, pool *p)
+    {
+        if (j.type() == json_t::array)
+        {
+            for (const auto &elem : j.get_array())
+                if (!all_in(elem, p))
+                    return false;
+        }
+        else if (j.type() == json_t::object)
+        {
+            for (const auto &member : j.get_object())
+                if (member.first.get_allocator().owner != p || !all_in(member.second, p))
+                    return false;
+        }
+        else if (j.type() != json_t::string || j.is_borrowed())
+        {
+            return true;
+        }
+        return j.get_allocator().owner == p;
+    }
+}
+
+TEST(TinyJsonStatefulAllocator, Basic)
+{
+    using namespace pool_test;
+    static_assert(std::is_same<basic_json_object<pool_json>, pool_json::object_t>::value, "object alias");
+    static_assert(std::is_same<basic_json_array<pool_json>, pool_json::array_t>::value, "array alias");
+
+    pool a = {0, 0}, b = {0, 0};
+    {
+        std::string text = R"({"name" : "a string longer than the short string buffer", "list" : [1, 2.5, "x", {"k" : null}]})";
+        pool_json doc = basic_parser<pool_json>::parse(text, pool_allocator<char>(&a));
+        EXPECT_TRUE(all_in(doc, &a));
+        EXPECT_GT(a.allocations, 0u);
+
+        // 拷贝到另一个池，拷贝构造沿用原来的池
+        pool_json other(doc, pool_allocator<char>(&b));
+        EXPECT_TRUE(all_in(other, &b));
+        EXPECT_TRUE(doc == other);
+        pool_json same(doc);
+        EXPECT_TRUE(all_in(same, &a));
+
+        // 添加的成员转移到容器所在的池
+        other.add_member(pool_json::string_t("from_a", pool_allocator<char>(&a)), doc["list"]);
+        other["list"].add_element(pool_json("y", pool_allocator<char>(&a)));
+        EXPECT_TRUE(all_in(other, &b));
+
+        // 标量的拷贝不需要分配器，但标量没有可以返回的分配器
+        pool_json n(42);
+        pool_json m(n);
+        EXPECT_EQ(42, m.get_integer());
+        EXPECT_THROW(n.get_allocator(), std::logic_error);
+    }
+    EXPECT_EQ(a.allocations, a.deallocations);
+    EXPECT_EQ(b.allocations, b.deallocations);
+}
+
+TEST(TinyJsonSharedDocument, Basic)
+{
+    json source = parser::parse(R"({"user" : {"name" : "tiny", "tags" : ["a", "b"]}, "limits" : {"rps" : 100}, "on" : true})");
+    shared_json cached(source);
+    EXPECT_EQ(source.to_string(), cached.to_string());
+    EXPECT_TRUE(source == cached.to_json());
+
+    // 拷贝只共享节点
+    shared_json copy = cached;
+    EXPECT_TRUE(copy.same_node(cached));
+    EXPECT_EQ(100, copy["limits"]["rps"].get_integer());
+    EXPECT_EQ("b", copy.find(json_pointer("/user/tags/1"))->get_string_view());
+    EXPECT_EQ(nullptr, copy.find("missing"));
+
+    // 修改只复制路径上的节点，原文档不变，未修改的子树仍然共享
+    copy.set(json_pointer("/user/name"), shared_json(json("changed")));
+    EXPECT_EQ("changed", copy["user"]["name"].get_string_view());
+    EXPECT_EQ("tiny", cached["user"]["name"].get_string_view());
+    EXPECT_FALSE(copy.same_node(cached));
+    EXPECT_FALSE(copy["user"].same_node(cached["user"]));
+    EXPECT_TRUE(copy["user"]["tags"].same_node(cached["user"]["tags"]));
+    EXPECT_TRUE(copy["limits"].same_node(cached["limits"]));
+    EXPECT_FALSE(copy == cached);
+
+    // 新的键名、数组追加和删除
+    copy.set(json_pointer("/user/tags/-"), shared_json(json("c")));
+    copy.set("added", shared_json(json(1.5)));
+    EXPECT_TRUE(copy.erase("on"));
+    EXPECT_FALSE(copy.erase("on"));
+    EXPECT_EQ(3u, copy["user"]["tags"].size());
+    EXPECT_EQ(2u, cached["user"]["tags"].size());
+    EXPECT_DOUBLE_EQ(1.5, copy["added"].get_double());
+    EXPECT_EQ(nullptr, copy.find("on"));
+    EXPECT_EQ("limits", copy.get_object()[0].first);
+    EXPECT_THROW(copy.set(json_pointer("/nope/x"), shared_json()), std::runtime_error);
+
+    // 恢复成相同的内容后与原文档相等
+    shared_json restored = copy;
+    restored.set(json_pointer("/user/name"), shared_json(json("tiny")));
+    restored.set(json_pointer("/on"), shared_json(json(true)));
+    restored.erase("added");
+    shared_json tags = restored["user"]["tags"];
+    std::vector<shared_json> elems(tags.get_array().begin(), tags.get_array().begin() + 2);
+    shared_json two(parser::parse("[]"));
+    for (const shared_json &e : elems)
+        two.push_back(e);
+    restored.set(json_pointer("/user/tags"), two);
+    EXPECT_TRUE(restored == cached);
+
+    // 多个线程同时读取同一份文档并修改各自的拷贝
+    std::vector<std::thread> threads;
+    std::atomic<int> ok(0);
+    for (int t = 0; t < 4; t++)
+    {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < 200; i++)
+            {
+                shared_json mine = cached;
+                mine.set(json_pointer("/limits/rps"), shared_json(json(t * 1000 + i)));
+                if (mine["limits"]["rps"].get_integer() == t * 1000 + i && cached["limits"]["rps"].get_integer() == 100)
+                    ok++;
+            }
+        });
+    }
+    for (auto &th : threads)
+        th.join();
+    EXPECT_EQ(800, ok.load());
+}
+
+TEST(TinyJsonParseCache, Basic)
+{
+    parse_cache cache(1 << 20, 4);
+    std::string schema = R"({"type" : "object", "required" : ["id", "name"]})";
+
+    // 相同的输入第二次直接返回缓存的文档
+    shared_json first = cache.parse(schema);
+    shared_json second = cache.parse(std::string(schema)); // 不同的缓冲区，相同的字节
+    EXPECT_TRUE(first.same_node(second));
+    EXPECT_EQ("id", second["required"][0].get_string_view());
+    cache_stats s = cache.stats();
+    EXPECT_EQ(1u, s.hits);
+    EXPECT_EQ(1u, s.misses);
+    EXPECT_EQ(1u, s.entries);
+    EXPECT_EQ(schema.size(), s.bytes);
+
+    // 修改返回的文档不影响缓存
+    second.set("type", shared_json(json("array")));
+    EXPECT_EQ("object", cache.parse(schema)["type"].get_string_view());
+
+    // 格式错误的输入不缓存
+    parse_error err;
+    shared_json bad = cache.parse("{\"a\" : }", 8, err);
+    EXPECT_TRUE(err);
+    EXPECT_EQ(json_t::null, bad.type());
+    EXPECT_THROW(cache.parse(std::string("[1, ")), parse_exception);
+    EXPECT_EQ(1u, cache.stats().entries);
+
+    // 超过容量时淘汰最久未使用的文档
+    parse_cache small(64, 1);
+    std::string a = R"({"payload" : "aaaaaaaaaaaaaaaaaaaa"})";
+    std::string b = R"({"payload" : "bbbbbbbbbbbbbbbbbbbb"})";
+    small.parse(a);
+    small.parse(b);
+    EXPECT_EQ(1u, small.stats().entries);
+    EXPECT_EQ(1u, small.stats().evictions);
+    small.parse(b);
+    EXPECT_EQ(1u, small.stats().hits);
+
+    // 并发访问少量不同的输入
+    std::vector<std::string> inputs;
+    for (int i = 0; i < 8; i++)
+        inputs.push_back("{\"id\" : " + std::to_string(i) + "}");
+    std::vector<std::thread> threads;
+    std::atomic<int> ok(0);
+    for (int t = 0; t < 4; t++)
+    {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < 500; i++)
+            {
+                int k = (i + t) % 8;
+                if (cache.parse(inputs[k])["id"].get_integer() == k)
+                    ok++;
+            }
+        });
+    }
+    for (auto &th : threads)
+        th.join();
+    EXPECT_EQ(2000, ok.load());
+    s = cache.stats();
+    EXPECT_EQ(9u, s.entries);
+    EXPECT_EQ(2000u + 5u, s.hits + s.misses); // 加上之前的 2 次命中、3 次未命中
+}
+
+TEST(TinyJsonStringEscaping, Basic)
+{
+    // 双引号、反斜杠和控制字符按 JSON 规则转义，非 ASCII 字节原样输出
+    json j(std::string("q\"b\\s/\b\f\n\r\t\x01\x1F\x7F 中文 \xF0\x9F\x98\x80"));
+    std::string out;
+    j.dump(out);
+    EXPECT_EQ("\"q\\\"b\\\\s/\\b\\f\\n\\r\\t\\u0001\\u001f\x7F 中文 \xF0\x9F\x98\x80\"", out);
+    EXPECT_EQ(out.size(), j.dump_size());
+    EXPECT_TRUE(j == parser::parse("[" + out + "]")[0]);
+
+    // 键名同样转义，整个文档可以原样往返
+    json doc = parser::parse(R"({"say \"hi\"" : ["line1\nline2", "tab\there", "C:\\dir\\file", "\u00e9\ud83d\ude00"]})");
+    std::string text;
+    doc.dump(text);
+    EXPECT_EQ(text.size(), doc.dump_size());
+    json again = parser::parse(text);
+    EXPECT_TRUE(doc == again);
+    EXPECT_EQ("\xC3\xA9\xF0\x9F\x98\x80", again["say \"hi\""][3].get_string());
+
+    // 转义出现在 SIMD 块边界附近时结果一致
+    for (size_t pos = 0; pos < 70; pos++)
+    {
+        std::string s(70, 'a');
+        s[pos] = '"';
+        std::string dumped;
+        json(s).dump(dumped);
+        EXPECT_EQ("\"" + s.substr(0, pos) + "\\\"" + s.substr(pos + 1) + "\"", dumped);
+
+        const char *b = s.data(), *e = s.data() + s.size();
+        EXPECT_EQ(b + pos, find_escape_byte(b, e));
+        EXPECT_EQ(find_escape_byte_scalar(b, e), find_escape_byte(b, e));
+    }
+    std::string high(64, '\xE4');
+    EXPECT_EQ(high.data() + high.size(), find_escape_byte(high.data(), high.data() + high.size()));
+
+    // UTF-32 后备路径：代理对合并为一个码点，单独的代理被拒绝
+    u32_sstream pair(U"\"\\ud83d\\ude00\"");
+    EXPECT_EQ("\xF0\x9F\x98\x80", parser::parse_string(pair).get_string());
+    u32_sstream lone_high(U"\"\\ud83d x\"");
+    EXPECT_THROW(parser::parse_string(lone_high), std::runtime_error);
+    u32_sstream lone_low(U"\"\\ude00\"");
+    EXPECT_THROW(parser::parse_string(lone_low), std::runtime_error);
+
+    // UTF-8 与 UTF-32 之间直接转换，非法输入报告错误
+    EXPECT_EQ(U"a\u00e9\u4e2d\U0001F600", U8ToU32("a\xC3\xA9\xE4\xB8\xAD\xF0\x9F\x98\x80"));
+    EXPECT_EQ("a\xC3\xA9\xE4\xB8\xAD\xF0\x9F\x98\x80", U32ToU8(U"a\u00e9\u4e2d\U0001F600"));
+    EXPECT_THROW(U8ToU32("\xC0\xAF"), std::runtime_error);
+    EXPECT_THROW(U8ToU32("\xED\xA0\x80"), std::runtime_error);
+    EXPECT_THROW(U32ToU8(std::u32string(1, char32_t(0xD800))), std::runtime_error);
+    EXPECT_THROW(U32ToU8(std::u32string(1, char32_t(0x110000))), std::runtime_error);
+
+    // 从字节流解析时不再经过 codecvt
+    std::istringstream in("{\"k\" : [\"\\u4e2d\xE6\x96\x87\", 1]}");
+    json from_stream = parser::parse(in);
+    EXPECT_EQ("\xE4\xB8\xAD\xE6\x96\x87", from_stream["k"][0].get_string());
+}
+
+TEST(TinyJsonDumpOptions, Basic)
+{
+    using ordered_parser = basic_parser<ordered_json>;
+    ordered_json j = ordered_parser::parse(R"({"name" : "a\"b", "list" : [1, 2.5, true, null], "empty" : {}, "none" : [], "nested" : {"k" : [{}]}})");
+
+    // 紧凑格式不含任何空白
+    std::string compact = j.to_string(dump_options::compact());
+    EXPECT_EQ(R"({"name":"a\"b","list":[1,2.5,true,null],"empty":{},"none":[],"nested":{"k":[{}]}})", compact);
+    EXPECT_EQ(compact.size(), j.dump_size(dump_options::compact()));
+
+    // 带缩进的格式，空的容器不换行
+    std::string pretty = j.to_string(dump_options::pretty(2));
+    EXPECT_EQ("{\n"
+              "  \"name\": \"a\\\"b\",\n"
+              "  \"list\": [\n"
+              "    1,\n"
+              "    2.5,\n"
+              "    true,\n"
+              "    null\n"
+              "  ],\n"
+              "  \"empty\": {},\n"
+              "  \"none\": [],\n"
+              "  \"nested\": {\n"
+              "    \"k\": [\n"
+              "      {}\n"
+              "    ]\n"
+              "  }\n"
+              "}",
+              pretty);
+    EXPECT_EQ(pretty.size(), j.dump_size(dump_options::pretty(2)));
+    EXPECT_TRUE(j == ordered_parser::parse(pretty));
+    EXPECT_EQ("[\n\t1\n]", json(json_array{json(1)}).to_string(dump_options::pretty(1, '\t')));
+    EXPECT_EQ("42", json(42).to_string(dump_options::pretty()));
+
+    // 作为 SAX 处理器时不构建 JSON 树就完成重新格式化
+    std::string reformatted;
+    string_sink<std::string> sink(reformatted);
+    json_writer<string_sink<std::string>> writer(sink, dump_options::pretty(2));
+    EXPECT_TRUE(parser::sax_parse(compact, writer));
+    EXPECT_EQ(pretty, reformatted);
+
+    // minify 去除字符串之外的空白，字符串内容与转义保持原样
+    EXPECT_EQ(compact, minify(pretty));
+    EXPECT_EQ(R"({"a b":"x \" \\ y","n":[1e5,-0.5]})", minify(" {\n\t\"a b\" :  \"x \\\" \\\\ y\" ,\r\n \"n\" : [ 1e5 , -0.5 ] }\n"));
+    EXPECT_EQ("", minify(" \n\t "));
+    std::string longstr(100, 'x');
+    std::string out = "prefix:";
+    minify("[ \"" + longstr + "\\\"  \" ,  \"unterminated  ", out);
+    EXPECT_EQ("prefix:[\"" + longstr + "\\\"  \",\"unterminated  ", out);
+
+    // NDJSON 写入器可以使用紧凑格式，但不能换行
+    std::string buffer;
+    basic_ndjson_writer<string_sink<>> lines(buffer, dump_options::compact());
+    lines.write(j["list"]);
+    lines.write(j["nested"]);
+    EXPECT_EQ("[1,2.5,true,null]\n{\"k\":[{}]}\n", buffer);
+    EXPECT_THROW(basic_ndjson_writer<string_sink<>>(buffer, dump_options::pretty()), std::logic_error);
+}
+
+TEST(TinyJsonScanKernels, Basic)
+{
+    // 向量化扫描与逐字节扫描的结果一致，覆盖各种起始位置和长度
+    std::string ws(100, ' ');
+    const char fill[] = " \t\r\n\v\f";
+    for (size_t i = 0; i < ws.size(); i++)
+        ws[i] = fill[i % 6];
+
+    for (size_t len = 0; len <= ws.size(); len++)
+    {
+        std::string s = ws.substr(0, len) + "x" + ws;
+        for (size_t start = 0; start <= len; start++)
+        {
+            const char *b = s.data() + start, *e = s.data() + s.size();
+            EXPECT_EQ(skip_whitespace_scalar(b, e), skip_whitespace(b, e));
+            EXPECT_EQ(s.data() + len, skip_whitespace(b, e));
+        }
+        // 全部是空白时返回 end
+        EXPECT_EQ(ws.data() + len, skip_whitespace(ws.data(), ws.data() + len));
+    }
+
+    const char specials[] = {'"', '\\', '\x01', '\x1F', '\x80', '\xE4', '\xFF'};
+    std::string text(80, 'a');
+    for (char sp : specials)
+    {
+        for (size_t pos = 0; pos < text.size(); pos++)
+        {
+            std::string s = text;
+            s[pos] = sp;
+            const char *b = s.data(), *e = s.data() + s.size();
+            EXPECT_EQ(b + pos, find_string_special(b, e));
+            EXPECT_EQ(find_string_special_scalar(b, e), find_string_special(b, e));
+        }
+    }
+    // 0x20 和 0x7F 不需要特殊处理
+    std::string plain = std::string(40, ' ') + std::string(40, '\x7F');
+    EXPECT_EQ(plain.data() + plain.size(), find_string_special(plain.data(), plain.data() + plain.size()));
+
+    // 带缩进的文档与较长的字符串
+    std::string longstr(1000, 'q');
+    std::string doc = "{\n        \"k\" :          \"" + longstr + "\\n" + longstr +
+                      "\",\n\t\t\t\t\t\t\t\t\"v\" : [\n                1 ,\n                2\n        ]\n}\n      ";
+    json j = parser::parse(doc);
+    EXPECT_EQ(longstr + "\n" + longstr, j["k"].get_string());
+    EXPECT_EQ(2, j["v"][1].get_integer());
+
+    push_parser p;
+    for (size_t i = 0; i < doc.size(); i += 7)
+        p.feed(doc.data() + i, std::min<size_t>(7, doc.size() - i));
+    EXPECT_TRUE(j == p.finish());
+}
+
+TEST(TinyJsonNumberScanning, Basic)
+{
+    auto scan = [](const std::string &s, parsed_number &n)
+    { return scan_number(s.data(), s.data() + s.size(), n) == s.data() + s.size(); };
+    parsed_number n;
+
+    // 整数，包括边界值；超出 long long 范围时改为浮点数
+    ASSERT_TRUE(scan("9223372036854775807", n));
+    EXPECT_EQ(json_t::number_integer, n.type);
+    EXPECT_EQ(9223372036854775807LL, n.integer);
+    ASSERT_TRUE(scan("-9223372036854775808", n));
+    EXPECT_EQ(json_t::number_integer, n.type);
+    EXPECT_EQ(-9223372036854775807LL - 1, n.integer);
+    ASSERT_TRUE(scan("9223372036854775808", n));
+    EXPECT_EQ(json_t::number_double, n.type);
+    EXPECT_EQ(9223372036854775808.0, n.number);
+    ASSERT_TRUE(scan("123456789012345678901234567890", n));
+    EXPECT_EQ(json_t::number_double, n.type);
+    EXPECT_EQ(123456789012345678901234567890.0, n.number);
+    ASSERT_TRUE(scan("-0", n));
+    EXPECT_EQ(json_t::number_integer, n.type);
+    EXPECT_EQ(0, n.integer);
+
+    // 浮点数按 IEEE 754 正确舍入（与编译器对字面量的舍入结果完全相同）
+    const char *texts[] = {"0.1", "1e23", "2.2250738585072011e-308", "4.9406564584124654e-324",
+                           "1.7976931348623157e308", "9007199254740993.0", "0.30000000000000004",
+                           "1.00000000000000011102230246251565404236316680908203125", "-.5E-3"};
+    const double values[] = {0.1, 1e23, 2.2250738585072011e-308, 4.9406564584124654e-324,
+                             1.7976931348623157e308, 9007199254740993.0, 0.30000000000000004,
+                             1.00000000000000011102230246251565404236316680908203125, -.5E-3};
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++)
+    {
+        std::string s = texts[i];
+        ASSERT_TRUE(scan(s, n)) << s;
+        EXPECT_EQ(json_t::number_double, n.type);
+        EXPECT_EQ(values[i], n.number) << s;
+    }
+    ASSERT_TRUE(scan("1e-400", n));
+    EXPECT_EQ(0.0, n.number);
+
+    // 格式错误
+    const char *invalid[] = {"", "-", ".", "e5", "1e", "1e+", "-.e1"};
+    for (const char *s : invalid)
+        EXPECT_EQ(nullptr, scan_number(s, s + std::strlen(s), n)) << s;
+
+    // 数值之后的内容不属于数值
+    std::string s = "12.5e3,";
+    EXPECT_EQ(s.data() + 6, scan_number(s.data(), s.data() + s.size(), n));
+    EXPECT_EQ(12500.0, n.number);
+
+    // 解析器：超出范围报错，非法格式报错
+    json a = parser::parse("[1.5e300, -12, 3E2, 18446744073709551616]");
+    EXPECT_EQ(1.5e300, a[0].get_double());
+    EXPECT_EQ(-12, a[1].get_integer());
+    EXPECT_EQ(300.0, a[2].get_double());
+    EXPECT_EQ(18446744073709551616.0, a[3].get_double());
+    EXPECT_THROW(parser::parse("[1e999]"), std::runtime_error);
+    EXPECT_THROW(parser::parse("[1.2.3]"), std::runtime_error);
+    EXPECT_THROW(parser::parse("[1-2]"), std::runtime_error);
+    u32_sstream big(U"100000000000000000000");
+    EXPECT_EQ(1e20, parser::parse_number(big).get_double());
+
+    // 与区域设置无关
+    if (std::setlocale(LC_NUMERIC, "de_DE.UTF-8") != nullptr)
+    {
+        EXPECT_EQ(0.5, parser::parse("[0.5]")[0].get_double());
+        EXPECT_EQ(1234.5678e-300, parser::parse("[1234.5678000000000000000000001e-300]")[0].get_double());
+        std::setlocale(LC_NUMERIC, "C");
+    }
+}
+
+TEST(SimpleJsonNumberFormatting, Basic)
+{
+    // 最短的往返表示
+    EXPECT_EQ("0.1", json(0.1).to_string());
+    EXPECT_EQ("-1.5", json(-1.5).to_string());
+    EXPECT_EQ("0.30000000000000004", json(0.1 + 0.2).to_string());
+    EXPECT_EQ("13525.4235", json(13525.4235).to_string());
+    EXPECT_EQ("0.0001", json(0.0001).to_string());
+    EXPECT_EQ("1e-5", json(0.00001).to_string());
+    EXPECT_EQ("1e+22", json(1e22).to_string());
+    EXPECT_EQ("100000000000000.0", json(1e14).to_string()); // 定点格式的上限为指数 14
+    EXPECT_EQ("1e+15", json(1e15).to_string());
+    EXPECT_EQ(1e23, parser::parse("[" + json(1e23).to_string() + "]")[0].get_double());
+    EXPECT_EQ("5e-324", json(5e-324).to_string());
+    EXPECT_EQ("1.7976931348623157e+308", json(1.7976931348623157e308).to_string());
+
+    // 整数值的浮点数保留小数点，解析后仍为浮点数
+    EXPECT_EQ("0.0", json(0.0).to_string());
+    EXPECT_EQ("-0.0", json(-0.0).to_string());
+    EXPECT_EQ("100.0", json(100.0).to_string());
+    EXPECT_EQ(json_t::number_double, parser::parse("[100.0]")[0].type());
+
+    // JSON 无法表示的值
+    EXPECT_EQ("null", json(std::numeric_limits<double>::infinity()).to_string());
+    EXPECT_EQ("null", json(std::numeric_limits<double>::quiet_NaN()).to_string());
+
+    // 整数
+    EXPECT_EQ("9223372036854775807", json(9223372036854775807LL).to_string());
+    EXPECT_EQ("-100", json(-100).to_string());
+    EXPECT_EQ("7", json(7).to_string());
+
+    // 序列化后再解析，数值逐位相同
+    json a(json_array{});
+    double d = 1.0;
+    for (int i = 0; i < 200; i++)
+    {
+        a.add_element(d);
+        a.add_element(-1.0 / d);
+        d *= 3.3;
+    }
+    json b = parser::parse(a.to_string());
+    ASSERT_EQ(a.size(), b.size());
+    for (size_t i = 0; i < a.size(); i++)
+        EXPECT_EQ(a[static_cast<int>(i)].get_double(), b[static_cast<int>(i)].get_double());
+}